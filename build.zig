@@ -4,6 +4,11 @@ pub fn build(b: *std.Build) !void {
     const target = b.standardTargetOptions(.{});
     const optimize = b.standardOptimizeOption(.{});
     const multicore = b.option(bool, "multicore", "Enables multicore for libff") orelse false;
+    const fixed_schedule = b.option(
+        bool,
+        "fixed_schedule",
+        "Runs the syscalls on a schedule that does not depend on the input",
+    ) orelse false;
 
     const ff_dep = b.dependency("ff", .{});
     const gmp_dep = b.dependency("gmp", .{
@@ -32,13 +37,26 @@ pub fn build(b: *std.Build) !void {
         .root = ff_dep.path("libff"),
         .files = &.{
             "algebra/curves/alt_bn128/alt_bn128_fields.cpp",
+            "algebra/curves/alt_bn128/alt_bn128_flat_fq12.cpp",
             "algebra/curves/alt_bn128/alt_bn128_g1.cpp",
             "algebra/curves/alt_bn128/alt_bn128_g2.cpp",
+            "algebra/curves/alt_bn128/alt_bn128_hash_to_curve.cpp",
             "algebra/curves/alt_bn128/alt_bn128_init.cpp",
             "algebra/curves/alt_bn128/alt_bn128_pairing.cpp",
             "algebra/curves/alt_bn128/alt_bn128_pp.cpp",
+            "algebra/curves/bls12_381/bls12_381_batch_verify.cpp",
+            "algebra/curves/bls12_381/bls12_381_fields.cpp",
+            "algebra/curves/bls12_381/bls12_381_g1.cpp",
+            "algebra/curves/bls12_381/bls12_381_g2.cpp",
+            "algebra/curves/bls12_381/bls12_381_hash_to_curve.cpp",
+            "algebra/curves/bls12_381/bls12_381_init.cpp",
+            "algebra/curves/bls12_381/bls12_381_pairing.cpp",
+            "algebra/curves/bls12_381/bls12_381_pp.cpp",
+            "algebra/curves/hash_to_curve.cpp",
             "common/double.cpp",
+            "common/parallel.cpp",
             "common/profiling.cpp",
+            "common/sha512_multi_buffer.cpp",
             "common/utils.cpp",
         },
         .flags = &.{
@@ -56,7 +74,11 @@ pub fn build(b: *std.Build) !void {
     );
     ff.addCSourceFile(.{
         .file = b.path("src/binding.cxx"),
-        .flags = &.{ "-Wall", "-Werror" },
+        .flags = &.{
+            "-Wall",
+            "-Werror",
+            if (fixed_schedule) "-DBN254_FIXED_SCHEDULE" else "",
+        },
     });
     const translate = b.addTranslateC(.{
         .target = target,
@@ -71,6 +93,9 @@ pub fn build(b: *std.Build) !void {
     });
     header_mod.linkLibrary(ff);
 
+    const build_options = b.addOptions();
+    build_options.addOption(bool, "fixed_schedule", fixed_schedule);
+
     const test_exe = b.addTest(.{
         .target = target,
         .optimize = optimize,
@@ -79,4 +104,30 @@ pub fn build(b: *std.Build) !void {
     test_exe.root_module.addImport("ff", header_mod);
     const run_test_exe = b.step("test", "Runs the test_exe");
     run_test_exe.dependOn(&b.addRunArtifact(test_exe).step);
+
+    const bench_exe = b.addExecutable(.{
+        .name = "bench",
+        .target = target,
+        .optimize = optimize,
+        .root_source_file = b.path("src/bench.zig"),
+    });
+    bench_exe.root_module.addImport("ff", header_mod);
+    bench_exe.root_module.addOptions("build_options", build_options);
+    const run_bench_exe = b.addRunArtifact(bench_exe);
+    if (b.args) |args| run_bench_exe.addArgs(args);
+    const bench_step = b.step("bench", "Runs the BN254 syscall benchmarks");
+    bench_step.dependOn(&run_bench_exe.step);
+
+    const calibrate_exe = b.addExecutable(.{
+        .name = "calibrate",
+        .target = target,
+        .optimize = optimize,
+        .root_source_file = b.path("src/calibrate.zig"),
+    });
+    calibrate_exe.root_module.addImport("ff", header_mod);
+    calibrate_exe.root_module.addOptions("build_options", build_options);
+    const run_calibrate_exe = b.addRunArtifact(calibrate_exe);
+    if (b.args) |args| run_calibrate_exe.addArgs(args);
+    const calibrate_step = b.step("calibrate", "Fits BN254 syscall timings against their compute-unit charges");
+    calibrate_step.dependOn(&run_calibrate_exe.step);
 }
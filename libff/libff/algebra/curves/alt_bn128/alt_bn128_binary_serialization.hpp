@@ -0,0 +1,98 @@
+/** @file
+ *****************************************************************************
+ Binary serialization (see common/binary_serialization.hpp) of alt_bn128
+ points and of G2 precomputations for the ate pairing.
+
+ A G2 precomputation is stored as QX, QY and its line coefficients (ell_0,
+ ell_VW, ell_VV for each step of the Miller loop), all in Fq2. The number of
+ steps is fixed by the curve, so precomputations have a fixed stride; the
+ point form of the format does not apply to them.
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef ALT_BN128_BINARY_SERIALIZATION_HPP_
+#define ALT_BN128_BINARY_SERIALIZATION_HPP_
+#include <cassert>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_g1.hpp>
+#include <libff/algebra/curves/alt_bn128/alt_bn128_g2.hpp>
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pairing.hpp>
+#include <libff/common/binary_serialization.hpp>
+
+namespace libff {
+
+template<>
+struct binary_traits<alt_bn128_G1> : public binary_point_traits<alt_bn128_G1, alt_bn128_Fq, 0x201> {};
+
+template<>
+struct binary_traits<alt_bn128_G2> : public binary_point_traits<alt_bn128_G2, alt_bn128_Fq2, 0x202> {};
+
+template<>
+struct binary_traits<alt_bn128_ate_G2_precomp> {
+    typedef binary_traits<alt_bn128_Fq2> coeff;
+
+    static const uint16_t kind = 0x302;
+
+    /* the number of line coefficients of a precomputation; requires
+       init_alt_bn128_params */
+    static std::size_t num_coeffs()
+    {
+        static const std::size_t n = alt_bn128_ate_precompute_G2(alt_bn128_G2::one()).coeffs.size();
+        return n;
+    }
+
+    static uint64_t modulus_tag() { return coeff::modulus_tag(); }
+    static std::size_t stride(const binary_format &fmt)
+    {
+        return (2 + 3 * num_coeffs()) * coeff::stride(fmt);
+    }
+    static bool is_native(const binary_format &) { return false; }
+
+    static void write(unsigned char *dst, const alt_bn128_ate_G2_precomp &prec_Q, const binary_format &fmt)
+    {
+#ifdef DEBUG
+        assert(prec_Q.coeffs.size() == num_coeffs());
+#endif
+        const std::size_t s = coeff::stride(fmt);
+        coeff::write(dst, prec_Q.QX, fmt);
+        coeff::write(dst + s, prec_Q.QY, fmt);
+        dst += 2 * s;
+        for (const alt_bn128_ate_ell_coeffs &c : prec_Q.coeffs)
+        {
+            coeff::write(dst, c.ell_0, fmt);
+            coeff::write(dst + s, c.ell_VW, fmt);
+            coeff::write(dst + 2 * s, c.ell_VV, fmt);
+            dst += 3 * s;
+        }
+    }
+
+    static bool read(const unsigned char *src, alt_bn128_ate_G2_precomp &prec_Q, const binary_format &fmt)
+    {
+        const std::size_t s = coeff::stride(fmt);
+        if (!coeff::read(src, prec_Q.QX, fmt) || !coeff::read(src + s, prec_Q.QY, fmt))
+        {
+            return false;
+        }
+        src += 2 * s;
+
+        prec_Q.coeffs.resize(num_coeffs());
+        for (alt_bn128_ate_ell_coeffs &c : prec_Q.coeffs)
+        {
+            if (!coeff::read(src, c.ell_0, fmt) ||
+                !coeff::read(src + s, c.ell_VW, fmt) ||
+                !coeff::read(src + 2 * s, c.ell_VV, fmt))
+            {
+                return false;
+            }
+            src += 3 * s;
+        }
+        return true;
+    }
+};
+
+} // namespace libff
+
+#endif // ALT_BN128_BINARY_SERIALIZATION_HPP_
@@ -6,6 +6,7 @@
  *****************************************************************************/
 
 #include <libff/algebra/curves/alt_bn128/alt_bn128_fields.hpp>
+#include <libff/algebra/field_utils/algorithms.hpp>
 
 namespace libff {
 
@@ -78,6 +79,7 @@ void init_alt_bn128_fields()
     alt_bn128_Fq2::t = bigint<2*alt_bn128_q_limbs>("29943448501038927652624252826042421299953269783193801402277987640879380855398639840490065738714866998199264519675818766364765977133724184290399563929243");
     alt_bn128_Fq2::t_minus_1_over_2 = bigint<2*alt_bn128_q_limbs>("14971724250519463826312126413021210649976634891596900701138993820439690427699319920245032869357433499099632259837909383182382988566862092145199781964621");
     alt_bn128_Fq2::non_residue = alt_bn128_Fq("21888242871839275222246405745257275088696311157297823662689037894645226208582");
+    alt_bn128_Fq2::non_residue_is_minus_one = (alt_bn128_Fq2::non_residue == -alt_bn128_Fq::one());
     alt_bn128_Fq2::nqr = alt_bn128_Fq2(alt_bn128_Fq("2"),alt_bn128_Fq("1"));
     alt_bn128_Fq2::nqr_to_t = alt_bn128_Fq2(alt_bn128_Fq("5033503716262624267312492558379982687175200734934877598599011485707452665730"),alt_bn128_Fq("314498342015008975724433667930697407966947188435857772134235984660852259084"));
     alt_bn128_Fq2::Frobenius_coeffs_c1[0] = alt_bn128_Fq("1");
@@ -142,4 +144,18 @@ void init_alt_bn128_fields()
     alt_bn128_Fq12::Frobenius_coeffs_c1[11] = alt_bn128_Fq2(alt_bn128_Fq("18566938241244942414004596690298913868373833782006617400804628704885040364344"),alt_bn128_Fq("16165975933942742336466353786298926857552937457188450663314217659523851788715"));
 }
 
+std::optional<alt_bn128_Fq> alt_bn128_Fq_sqrt(const alt_bn128_Fq &a)
+{
+    /* a1 = a^((q - 3) / 4), so that a0 = a1^2 * a = a^((q - 1) / 2) is 1 for non-zero squares and -1 otherwise */
+    const alt_bn128_Fq a1 = power(a, alt_bn128_Fq_q_minus_3_over_4_chain);
+    const alt_bn128_Fq a0 = a1.squared() * a;
+
+    if (a0 == -alt_bn128_Fq::one())
+    {
+        return std::nullopt;
+    }
+
+    return a1 * a;
+}
+
 } // namespace libff
@@ -7,6 +7,7 @@
 
 #ifndef ALT_BN128_FIELDS_HPP_
 #define ALT_BN128_FIELDS_HPP_
+#include <libff/algebra/field_utils/addition_chain.hpp>
 #include <libff/algebra/fields/prime_base/fp.hpp>
 #include <libff/algebra/fields/prime_extension/fp12_2over3over2.hpp>
 #include <libff/algebra/fields/prime_extension/fp2.hpp>
@@ -30,6 +31,14 @@ typedef Fp6_3over2_model<alt_bn128_q_limbs, alt_bn128_modulus_q> alt_bn128_Fq6;
 typedef Fp12_2over3over2_model<alt_bn128_q_limbs, alt_bn128_modulus_q> alt_bn128_Fq12;
 typedef alt_bn128_Fq12 alt_bn128_GT;
 
+/* (q - 3) / 4, since q = 3 (mod 4) x^((q - 3) / 4) * x is a square root of a square x */
+constexpr addition_chain<5, 256> alt_bn128_Fq_q_minus_3_over_4_chain =
+    make_addition_chain<5>(std::array<unsigned long long, 4>{
+        0x4f082305b61f3f51ull, 0x65e05aa45a1c72a3ull, 0x6e14116da0605617ull, 0x0c19139cb84c680aull });
+
+/* a square root of a along alt_bn128_Fq_q_minus_3_over_4_chain, or nullopt if a is not a square */
+std::optional<alt_bn128_Fq> alt_bn128_Fq_sqrt(const alt_bn128_Fq &a);
+
 void init_alt_bn128_fields();
 
 } // namespace libff
@@ -0,0 +1,871 @@
+/** @file
+ *****************************************************************************
+ Implementation of the fused alt_bn128_flat_Fq12 kernels.
+
+ See alt_bn128_flat_fq12.hpp .
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <cstring>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_flat_fq12.hpp>
+
+namespace libff {
+
+using std::size_t;
+
+/*
+  An element of F_q is N limbs in Montgomery form, an element of F_q^2 is 2N
+  limbs (c0, then c1) and one of F_q^6 is 6N limbs. A double-width value is
+  2N limbs holding a product of Montgomery forms that has not been reduced,
+  kept in [0, q * R) as Fp_model::unreduced; double-width elements of F_q^2
+  and F_q^6 take 4N and 12N limbs.
+
+  q < 2^254 = R / 4, so the sum of two elements of F_q fits in N limbs
+  without reduction, and the product of two such sums is below q * R.
+*/
+static const mp_size_t N = alt_bn128_q_limbs;
+
+/*
+  The kernels below are templates on the primitives P they are built from:
+  mpn_primitives, built on every target, and intrinsic_primitives on x86-64.
+  flat_primitives are the ones behind the members of alt_bn128_flat_Fq12;
+  alt_bn128_flat_Fq12_portable runs the same kernels on mpn_primitives.
+  Both are local to this file.
+*/
+
+namespace {
+
+struct mpn_primitives {
+    static inline mp_limb_t add_n(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b, const mp_size_t len)
+    {
+        return mpn_add_n(r, a, b, len);
+    }
+
+    static inline mp_limb_t sub_n(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b, const mp_size_t len)
+    {
+        return mpn_sub_n(r, a, b, len);
+    }
+
+    /* r = a * b, where r (2N limbs) does not overlap a or b */
+    static inline void mul_n(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b)
+    {
+        mpn_mul_n(r, a, b, N);
+    }
+
+    /* r = T / R mod q for T in [0, q * R), as Fp_model::reduce */
+    static inline void redc(mp_limb_t *r, const mp_limb_t *T)
+    {
+        alt_bn128_Fq::unreduced t;
+        std::memcpy(t.data, T, 2 * N * sizeof(mp_limb_t));
+        std::memcpy(r, alt_bn128_Fq::reduce(t).mont_repr.data, N * sizeof(mp_limb_t));
+    }
+
+    /* r = a - q if a >= q, and r = a otherwise, for a < 2q */
+    static inline void reduce_once(mp_limb_t *r, const mp_limb_t *a)
+    {
+        mp_limb_t t[N];
+        const mp_limb_t keep_t = sub_n(t, a, alt_bn128_modulus_q.data, N) - 1;
+        for (mp_size_t i = 0; i < N; ++i)
+        {
+            r[i] = (t[i] & keep_t) | (a[i] & ~keep_t);
+        }
+    }
+
+    /* r = r + q if borrow is set */
+    static inline void add_q_if(mp_limb_t *r, const mp_limb_t borrow)
+    {
+        const mp_limb_t mask = -borrow;
+        mp_limb_t q_masked[N];
+        for (mp_size_t i = 0; i < N; ++i)
+        {
+            q_masked[i] = alt_bn128_modulus_q.data[i] & mask;
+        }
+        add_n(r, r, q_masked, N);
+    }
+};
+
+} // namespace
+
+/* NO_FLAT_FQ12_INTRINSICS keeps the members on mpn_primitives on x86-64 too. */
+#if defined(__x86_64__) && GMP_NUMB_BITS == 64 && !defined(NO_FLAT_FQ12_INTRINSICS)
+
+/* Straight-line code for N = 4 with adc / sbb chains, which compilers keep in registers;
+   loops over limbs are left rolled at -O2, and carries through __int128 are not fused by all of them. */
+static_assert(alt_bn128_q_limbs == 4, "the flat kernels are written for four limbs");
+
+typedef unsigned __int128 dlimb;
+
+/* r = a + b + carry, returning the carry out */
+static inline mp_limb_t addc(mp_limb_t &r, const mp_limb_t a, const mp_limb_t b, const mp_limb_t carry)
+{
+    unsigned long long t;
+    const mp_limb_t carry_out = _addcarry_u64((unsigned char) carry, a, b, &t);
+    r = t;
+    return carry_out;
+}
+
+/* r = a - b - borrow, returning the borrow out */
+static inline mp_limb_t subb(mp_limb_t &r, const mp_limb_t a, const mp_limb_t b, const mp_limb_t borrow)
+{
+    unsigned long long t;
+    const mp_limb_t borrow_out = _subborrow_u64((unsigned char) borrow, a, b, &t);
+    r = t;
+    return borrow_out;
+}
+
+/* r = a * b + c + carry, returning the high limb */
+static inline mp_limb_t mac(mp_limb_t &r, const mp_limb_t a, const mp_limb_t b, const mp_limb_t c, const mp_limb_t carry)
+{
+    const dlimb t = (dlimb) a * b;
+    mp_limb_t low = (mp_limb_t) t, high = (mp_limb_t) (t >> 64);
+    high += addc(low, low, c, 0);
+    high += addc(r, low, carry, 0);
+    return high;
+}
+
+static inline mp_limb_t add_4(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b, mp_limb_t carry)
+{
+    carry = addc(r[0], a[0], b[0], carry);
+    carry = addc(r[1], a[1], b[1], carry);
+    carry = addc(r[2], a[2], b[2], carry);
+    return addc(r[3], a[3], b[3], carry);
+}
+
+static inline mp_limb_t sub_4(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b, mp_limb_t borrow)
+{
+    borrow = subb(r[0], a[0], b[0], borrow);
+    borrow = subb(r[1], a[1], b[1], borrow);
+    borrow = subb(r[2], a[2], b[2], borrow);
+    return subb(r[3], a[3], b[3], borrow);
+}
+
+/* t[0 .. N) += m * k, returning the carry out */
+static inline mp_limb_t addmul_4(mp_limb_t *t, const mp_limb_t *m, const mp_limb_t k)
+{
+    mp_limb_t carry = mac(t[0], m[0], k, t[0], 0);
+    carry = mac(t[1], m[1], k, t[1], carry);
+    carry = mac(t[2], m[2], k, t[2], carry);
+    return mac(t[3], m[3], k, t[3], carry);
+}
+
+/* one word of Montgomery reduction on t[0 .. N], folding the carry into t[N] */
+static inline mp_limb_t redc_step(mp_limb_t *t, const mp_limb_t carry_high)
+{
+    const mp_limb_t carry = addmul_4(t, alt_bn128_modulus_q.data, t[0] * alt_bn128_Fq::inv);
+    return addc(t[N], t[N], carry, carry_high);
+}
+
+namespace {
+
+struct intrinsic_primitives {
+    /* len is N or 2 N */
+    static inline mp_limb_t add_n(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b, const mp_size_t len)
+    {
+        const mp_limb_t carry = add_4(r, a, b, 0);
+        return (len == N ? carry : add_4(r + N, a + N, b + N, carry));
+    }
+
+    static inline mp_limb_t sub_n(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b, const mp_size_t len)
+    {
+        const mp_limb_t borrow = sub_4(r, a, b, 0);
+        return (len == N ? borrow : sub_4(r + N, a + N, b + N, borrow));
+    }
+
+    static inline void mul_n(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b)
+    {
+        mp_limb_t t[2 * N] = { 0 };
+        t[4] = addmul_4(t, b, a[0]);
+        t[5] = addmul_4(t + 1, b, a[1]);
+        t[6] = addmul_4(t + 2, b, a[2]);
+        t[7] = addmul_4(t + 3, b, a[3]);
+        std::memcpy(r, t, sizeof(t));
+    }
+
+    static inline void redc(mp_limb_t *r, const mp_limb_t *T)
+    {
+        mp_limb_t t[2 * N];
+        std::memcpy(t, T, sizeof(t));
+        mp_limb_t carry_high = redc_step(t, 0);
+        carry_high = redc_step(t + 1, carry_high);
+        carry_high = redc_step(t + 2, carry_high);
+        redc_step(t + 3, carry_high);
+        /* (T + k * q) / R < 2q, so the last carry is zero */
+        reduce_once(r, t + N);
+    }
+
+    static inline void reduce_once(mp_limb_t *r, const mp_limb_t *a)
+    {
+        mp_limb_t t[N];
+        const mp_limb_t keep_t = sub_4(t, a, alt_bn128_modulus_q.data, 0) - 1;
+        r[0] = (t[0] & keep_t) | (a[0] & ~keep_t);
+        r[1] = (t[1] & keep_t) | (a[1] & ~keep_t);
+        r[2] = (t[2] & keep_t) | (a[2] & ~keep_t);
+        r[3] = (t[3] & keep_t) | (a[3] & ~keep_t);
+    }
+
+    static inline void add_q_if(mp_limb_t *r, const mp_limb_t borrow)
+    {
+        const mp_limb_t mask = -borrow;
+        const mp_limb_t *q = alt_bn128_modulus_q.data;
+        mp_limb_t carry = addc(r[0], r[0], q[0] & mask, 0);
+        carry = addc(r[1], r[1], q[1] & mask, carry);
+        carry = addc(r[2], r[2], q[2] & mask, carry);
+        addc(r[3], r[3], q[3] & mask, carry);
+    }
+};
+
+} // namespace
+
+typedef intrinsic_primitives flat_primitives;
+
+#else
+
+typedef mpn_primitives flat_primitives;
+
+#endif
+
+/* F_q */
+
+template<typename P>
+static inline void fq_add(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b)
+{
+    mp_limb_t t[N];
+    P::add_n(t, a, b, N);
+    P::reduce_once(r, t);
+}
+
+template<typename P>
+static inline void fq_sub(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b)
+{
+    P::add_q_if(r, P::sub_n(r, a, b, N));
+}
+
+template<typename P>
+static inline void fq_neg(mp_limb_t *r, const mp_limb_t *a)
+{
+    static const mp_limb_t zero[N] = { 0 };
+    fq_sub<P>(r, zero, a);
+}
+
+/* double width */
+
+/* w = w + x modulo q * R: the low halves are below R, so only the high half can reach q */
+template<typename P>
+static inline void wide_add(mp_limb_t *w, const mp_limb_t *x)
+{
+    P::add_n(w, w, x, 2 * N);
+    P::reduce_once(w + N, w + N);
+}
+
+/* w = w - x modulo q * R */
+template<typename P>
+static inline void wide_sub(mp_limb_t *w, const mp_limb_t *x)
+{
+    P::add_q_if(w + N, P::sub_n(w, w, x, 2 * N));
+}
+
+/* F_q^2 = F_q[u] / (u^2 + 1) */
+
+template<typename P>
+static inline void fq2_add(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b)
+{
+    fq_add<P>(r, a, b);
+    fq_add<P>(r + N, a + N, b + N);
+}
+
+template<typename P>
+static inline void fq2_sub(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b)
+{
+    fq_sub<P>(r, a, b);
+    fq_sub<P>(r + N, a + N, b + N);
+}
+
+/* r = xi * a = (9 a0 - a1) + (a0 + 9 a1) u */
+template<typename P>
+static inline void fq2_mul_by_xi(mp_limb_t *r, const mp_limb_t *a)
+{
+    mp_limb_t t0[N], t1[N];
+    fq_add<P>(t0, a, a);
+    fq_add<P>(t0, t0, t0);
+    fq_add<P>(t0, t0, t0);
+    fq_add<P>(t0, t0, a);
+    fq_sub<P>(t0, t0, a + N);
+    fq_add<P>(t1, a + N, a + N);
+    fq_add<P>(t1, t1, t1);
+    fq_add<P>(t1, t1, t1);
+    fq_add<P>(t1, t1, a + N);
+    fq_add<P>(t1, t1, a);
+    std::memcpy(r, t0, sizeof(t0));
+    std::memcpy(r + N, t1, sizeof(t1));
+}
+
+/* w = a * b, where w does not overlap a or b */
+template<typename P>
+static inline void fq2_mul_wide(mp_limb_t *w, const mp_limb_t *a, const mp_limb_t *b)
+{
+    mp_limb_t sa[N], sb[N], t[2 * N];
+    P::mul_n(w, a, b);
+    P::mul_n(w + 2 * N, a + N, b + N);
+    P::add_n(sa, a, a + N, N);
+    P::add_n(sb, b, b + N, N);
+    P::mul_n(t, sa, sb);
+    /* (a0 + a1)(b0 + b1) - a0 b0 - a1 b1 = a0 b1 + a1 b0 < 2 q^2, without wrapping around */
+    P::sub_n(t, t, w, 2 * N);
+    P::sub_n(t, t, w + 2 * N, 2 * N);
+    wide_sub<P>(w, w + 2 * N);
+    std::memcpy(w + 2 * N, t, sizeof(t));
+}
+
+/* w = a^2 = (a0 + a1)(a0 - a1) + 2 a0 a1 u, where w does not overlap a */
+template<typename P>
+static inline void fq2_sqr_wide(mp_limb_t *w, const mp_limb_t *a)
+{
+    mp_limb_t s[N], d[N], twice_a1[N];
+    P::add_n(s, a, a + N, N);
+    fq_sub<P>(d, a, a + N);
+    P::add_n(twice_a1, a + N, a + N, N);
+    P::mul_n(w, s, d);
+    P::mul_n(w + 2 * N, a, twice_a1);
+}
+
+template<typename P>
+static inline void wide2_add(mp_limb_t *w, const mp_limb_t *x)
+{
+    wide_add<P>(w, x);
+    wide_add<P>(w + 2 * N, x + 2 * N);
+}
+
+template<typename P>
+static inline void wide2_sub(mp_limb_t *w, const mp_limb_t *x)
+{
+    wide_sub<P>(w, x);
+    wide_sub<P>(w + 2 * N, x + 2 * N);
+}
+
+/* w = xi * w in double width, where the generic tower reduces and multiplies */
+template<typename P>
+static inline void wide2_mul_by_xi(mp_limb_t *w)
+{
+    mp_limb_t t0[2 * N], t1[2 * N];
+    std::memcpy(t0, w, sizeof(t0));
+    wide_add<P>(t0, t0);
+    wide_add<P>(t0, t0);
+    wide_add<P>(t0, t0);
+    wide_add<P>(t0, w);
+    wide_sub<P>(t0, w + 2 * N);
+    std::memcpy(t1, w + 2 * N, sizeof(t1));
+    wide_add<P>(t1, t1);
+    wide_add<P>(t1, t1);
+    wide_add<P>(t1, t1);
+    wide_add<P>(t1, w + 2 * N);
+    wide_add<P>(t1, w);
+    std::memcpy(w, t0, sizeof(t0));
+    std::memcpy(w + 2 * N, t1, sizeof(t1));
+}
+
+/* r = w / R mod q */
+template<typename P>
+static inline void fq2_reduce(mp_limb_t *r, const mp_limb_t *w)
+{
+    P::redc(r, w);
+    P::redc(r + N, w + 2 * N);
+}
+
+template<typename P>
+static inline void fq2_mul(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b)
+{
+    mp_limb_t w[4 * N];
+    fq2_mul_wide<P>(w, a, b);
+    fq2_reduce<P>(r, w);
+}
+
+static inline void load_fq2(mp_limb_t *r, const alt_bn128_Fq2 &a)
+{
+    std::memcpy(r, a.c0.mont_repr.data, N * sizeof(mp_limb_t));
+    std::memcpy(r + N, a.c1.mont_repr.data, N * sizeof(mp_limb_t));
+}
+
+static inline void store_fq2(alt_bn128_Fq2 &r, const mp_limb_t *a)
+{
+    std::memcpy(r.c0.mont_repr.data, a, N * sizeof(mp_limb_t));
+    std::memcpy(r.c1.mont_repr.data, a + N, N * sizeof(mp_limb_t));
+}
+
+/* F_q^6 = F_q^2[v] / (v^3 - xi) */
+
+template<typename P>
+static inline void fq6_add(mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b)
+{
+    for (size_t j = 0; j < 3; ++j)
+    {
+        fq2_add<P>(r + 2 * N * j, a + 2 * N * j, b + 2 * N * j);
+    }
+}
+
+template<typename P>
+static inline void wide6_add(mp_limb_t *w, const mp_limb_t *x)
+{
+    for (size_t j = 0; j < 3; ++j)
+    {
+        wide2_add<P>(w + 4 * N * j, x + 4 * N * j);
+    }
+}
+
+template<typename P>
+static inline void wide6_sub(mp_limb_t *w, const mp_limb_t *x)
+{
+    for (size_t j = 0; j < 3; ++j)
+    {
+        wide2_sub<P>(w + 4 * N * j, x + 4 * N * j);
+    }
+}
+
+template<typename P>
+static inline void fq6_reduce(mp_limb_t *r, const mp_limb_t *w)
+{
+    for (size_t j = 0; j < 3; ++j)
+    {
+        fq2_reduce<P>(r + 2 * N * j, w + 4 * N * j);
+    }
+}
+
+/* w = a * b, Karatsuba as in Fp6_3over2_model::mul_no_reduce, where w does not overlap a or b */
+template<typename P>
+static inline void fq6_mul_wide(mp_limb_t *w, const mp_limb_t *a, const mp_limb_t *b)
+{
+    const mp_limb_t *a0 = a, *a1 = a + 2 * N, *a2 = a + 4 * N;
+    const mp_limb_t *b0 = b, *b1 = b + 2 * N, *b2 = b + 4 * N;
+    mp_limb_t *w0 = w, *w1 = w + 4 * N, *w2 = w + 8 * N;
+    mp_limb_t aA[4 * N], bB[4 * N], cC[4 * N], s[2 * N], t[2 * N];
+
+    fq2_mul_wide<P>(aA, a0, b0);
+    fq2_mul_wide<P>(bB, a1, b1);
+    fq2_mul_wide<P>(cC, a2, b2);
+
+    /* c0 = aA + xi ((a1 + a2)(b1 + b2) - bB - cC) */
+    fq2_add<P>(s, a1, a2);
+    fq2_add<P>(t, b1, b2);
+    fq2_mul_wide<P>(w0, s, t);
+    wide2_sub<P>(w0, bB);
+    wide2_sub<P>(w0, cC);
+    wide2_mul_by_xi<P>(w0);
+    wide2_add<P>(w0, aA);
+
+    /* c2 = (a0 + a2)(b0 + b2) - aA + bB - cC */
+    fq2_add<P>(s, a0, a2);
+    fq2_add<P>(t, b0, b2);
+    fq2_mul_wide<P>(w2, s, t);
+    wide2_sub<P>(w2, aA);
+    wide2_add<P>(w2, bB);
+    wide2_sub<P>(w2, cC);
+
+    /* c1 = (a0 + a1)(b0 + b1) - aA - bB + xi cC */
+    fq2_add<P>(s, a0, a1);
+    fq2_add<P>(t, b0, b1);
+    fq2_mul_wide<P>(w1, s, t);
+    wide2_sub<P>(w1, aA);
+    wide2_sub<P>(w1, bB);
+    wide2_mul_by_xi<P>(cC);
+    wide2_add<P>(w1, cC);
+}
+
+/* (c0, c1) = (a + b y)^2 in F_q^4 = F_q^2[y] / (y^2 - xi), as Fp12_2over3over2_model::Fp4_square */
+template<typename P>
+static inline void fq4_square(mp_limb_t *c0, mp_limb_t *c1, const mp_limb_t *a, const mp_limb_t *b)
+{
+    mp_limb_t asq[4 * N], bsq[4 * N], t1[4 * N], s[2 * N];
+    fq2_sqr_wide<P>(asq, a);
+    fq2_sqr_wide<P>(bsq, b);
+    fq2_add<P>(s, a, b);
+    fq2_sqr_wide<P>(t1, s);
+    wide2_sub<P>(t1, asq);
+    wide2_sub<P>(t1, bsq);
+    wide2_mul_by_xi<P>(bsq);
+    wide2_add<P>(bsq, asq);
+    fq2_reduce<P>(c0, bsq);
+    fq2_reduce<P>(c1, t1);
+}
+
+/* F_q^12 = F_q^6[w] / (w^2 - v) */
+
+alt_bn128_flat_Fq12::alt_bn128_flat_Fq12(const alt_bn128_Fq12 &elt)
+{
+    const alt_bn128_Fq2 *coeffs[6] = { &elt.c0.c0, &elt.c0.c1, &elt.c0.c2, &elt.c1.c0, &elt.c1.c1, &elt.c1.c2 };
+    for (size_t m = 0; m < 6; ++m)
+    {
+        load_fq2(limbs + 2 * N * m, *coeffs[m]);
+    }
+}
+
+alt_bn128_Fq12 alt_bn128_flat_Fq12::to_Fq12() const
+{
+    alt_bn128_Fq12 result;
+    alt_bn128_Fq2 *coeffs[6] = { &result.c0.c0, &result.c0.c1, &result.c0.c2, &result.c1.c0, &result.c1.c1, &result.c1.c2 };
+    for (size_t m = 0; m < 6; ++m)
+    {
+        store_fq2(*coeffs[m], limbs + 2 * N * m);
+    }
+    return result;
+}
+
+alt_bn128_flat_Fq12 alt_bn128_flat_Fq12::one()
+{
+    alt_bn128_flat_Fq12 result;
+    std::memset(result.limbs, 0, sizeof(result.limbs));
+    std::memcpy(result.limbs, alt_bn128_Fq::one().mont_repr.data, N * sizeof(mp_limb_t));
+    return result;
+}
+
+bool alt_bn128_flat_Fq12::operator==(const alt_bn128_flat_Fq12 &other) const
+{
+    /* the coefficients are fully reduced, so equal elements have equal limbs */
+    return std::memcmp(limbs, other.limbs, sizeof(limbs)) == 0;
+}
+
+bool alt_bn128_flat_Fq12::operator!=(const alt_bn128_flat_Fq12 &other) const
+{
+    return !(operator==(other));
+}
+
+template<typename P>
+static void flat_mul_into(const alt_bn128_flat_Fq12 &x, const alt_bn128_flat_Fq12 &y, alt_bn128_flat_Fq12 &result)
+{
+    /* Karatsuba over F_q^6, as Fp12_2over3over2_model::mul_into: c0 = aA + v bB, c1 = (a + b)(A + B) - aA - bB */
+    const mp_limb_t *a = x.limbs, *b = x.limbs + 6 * N;
+    const mp_limb_t *A = y.limbs, *B = y.limbs + 6 * N;
+    mp_limb_t aA[12 * N], bB[12 * N], res1[12 * N], s[6 * N], t[6 * N];
+
+    fq6_mul_wide<P>(aA, a, A);
+    fq6_mul_wide<P>(bB, b, B);
+    fq6_add<P>(s, a, b);
+    fq6_add<P>(t, A, B);
+    fq6_mul_wide<P>(res1, s, t);
+    wide6_sub<P>(res1, aA);
+    wide6_sub<P>(res1, bB);
+
+    /* v (x0, x1, x2) = (xi x2, x0, x1) */
+    wide2_mul_by_xi<P>(bB + 8 * N);
+    wide2_add<P>(aA, bB + 8 * N);
+    wide2_add<P>(aA + 4 * N, bB);
+    wide2_add<P>(aA + 8 * N, bB + 4 * N);
+
+    fq6_reduce<P>(result.limbs, aA);
+    fq6_reduce<P>(result.limbs + 6 * N, res1);
+}
+
+template<typename P>
+static void flat_square_inplace(alt_bn128_flat_Fq12 &x)
+{
+    /* complex squaring, as Fp12_2over3over2_model::square_inplace:
+       c0 = (a + b)(a + v b) - ab - v ab and c1 = 2 ab */
+    const mp_limb_t *a = x.limbs, *b = x.limbs + 6 * N;
+    mp_limb_t ab[12 * N], res0[12 * N], s[6 * N], t[6 * N], xi_ab2[4 * N];
+
+    fq6_mul_wide<P>(ab, a, b);
+    fq6_add<P>(s, a, b);
+    fq2_mul_by_xi<P>(t, b + 4 * N);
+    fq2_add<P>(t, t, a);
+    fq2_add<P>(t + 2 * N, a + 2 * N, b);
+    fq2_add<P>(t + 4 * N, a + 4 * N, b + 2 * N);
+    fq6_mul_wide<P>(res0, s, t);
+
+    wide6_sub<P>(res0, ab);
+    std::memcpy(xi_ab2, ab + 8 * N, sizeof(xi_ab2));
+    wide2_mul_by_xi<P>(xi_ab2);
+    wide2_sub<P>(res0, xi_ab2);
+    wide2_sub<P>(res0 + 4 * N, ab);
+    wide2_sub<P>(res0 + 8 * N, ab + 4 * N);
+    wide6_add<P>(ab, ab);
+
+    fq6_reduce<P>(x.limbs, res0);
+    fq6_reduce<P>(x.limbs + 6 * N, ab);
+}
+
+/* z = 3 t - 2 z */
+template<typename P>
+static inline void cyclotomic_minus(mp_limb_t *z, const mp_limb_t *t)
+{
+    fq2_sub<P>(z, t, z);
+    fq2_add<P>(z, z, z);
+    fq2_add<P>(z, z, t);
+}
+
+/* z = 3 t + 2 z */
+template<typename P>
+static inline void cyclotomic_plus(mp_limb_t *z, const mp_limb_t *t)
+{
+    fq2_add<P>(z, t, z);
+    fq2_add<P>(z, z, z);
+    fq2_add<P>(z, z, t);
+}
+
+template<typename P>
+static void flat_cyclotomic_square_inplace(alt_bn128_flat_Fq12 &x)
+{
+    /* Granger--Scott, as Fp12_2over3over2_model::cyclotomic_square_inplace, which names
+       the coefficients c0 = (z0, z4, z3) and c1 = (z2, z1, z5) */
+    mp_limb_t *z0 = x.limbs, *z4 = x.limbs + 2 * N, *z3 = x.limbs + 4 * N;
+    mp_limb_t *z2 = x.limbs + 6 * N, *z1 = x.limbs + 8 * N, *z5 = x.limbs + 10 * N;
+    mp_limb_t t0[2 * N], t1[2 * N], t2[2 * N], t3[2 * N], t4[2 * N], t5[2 * N];
+
+    fq4_square<P>(t0, t1, z0, z1);
+    fq4_square<P>(t2, t3, z2, z3);
+    fq4_square<P>(t4, t5, z4, z5);
+
+    cyclotomic_minus<P>(z0, t0);
+    cyclotomic_plus<P>(z1, t1);
+    fq2_mul_by_xi<P>(t5, t5);
+    cyclotomic_plus<P>(z2, t5);
+    cyclotomic_minus<P>(z3, t4);
+    cyclotomic_minus<P>(z4, t2);
+    cyclotomic_plus<P>(z5, t3);
+}
+
+template<typename P>
+static void flat_mul_by_024_inplace(alt_bn128_flat_Fq12 &x,
+                                    const alt_bn128_Fq2 &ell_0,
+                                    const alt_bn128_Fq2 &ell_VW,
+                                    const alt_bn128_Fq2 &ell_VV)
+{
+    /* the schedule of Fp12_2over3over2_model::mul_by_024_inplace, with xi applied in double width */
+    const mp_limb_t *z0 = x.limbs, *z1 = x.limbs + 2 * N, *z2 = x.limbs + 4 * N;
+    const mp_limb_t *z3 = x.limbs + 6 * N, *z4 = x.limbs + 8 * N, *z5 = x.limbs + 10 * N;
+    mp_limb_t x0[2 * N], x2[2 * N], x4[2 * N], s[2 * N], t[2 * N];
+    mp_limb_t D0[4 * N], D2[4 * N], D4[4 * N], S1[4 * N], T3[4 * N];
+    mp_limb_t r0[4 * N], r1[4 * N], r2[4 * N], r3[4 * N], r4[4 * N], r5[4 * N];
+
+    load_fq2(x0, ell_0);
+    load_fq2(x2, ell_VV);
+    load_fq2(x4, ell_VW);
+
+    fq2_mul_wide<P>(D0, z0, x0);
+    fq2_mul_wide<P>(D2, z2, x2);
+    fq2_mul_wide<P>(D4, z4, x4);
+
+    // For z.a_.a_ = z0.
+    fq2_mul_wide<P>(S1, z1, x2);
+    std::memcpy(r0, S1, sizeof(S1));
+    wide2_add<P>(r0, D4);
+    wide2_mul_by_xi<P>(r0);
+    wide2_add<P>(r0, D0);
+
+    // For z.a_.b_ = z1
+    fq2_mul_wide<P>(r1, z5, x4);
+    wide2_add<P>(S1, r1);
+    wide2_add<P>(r1, D2);
+    wide2_mul_by_xi<P>(r1);
+    fq2_mul_wide<P>(T3, z1, x0);
+    wide2_add<P>(S1, T3);
+    wide2_add<P>(r1, T3);
+
+    // For z.a_.c_ = z2
+    fq2_add<P>(s, z0, z2);
+    fq2_add<P>(t, x0, x2);
+    fq2_mul_wide<P>(r2, s, t);
+    wide2_sub<P>(r2, D0);
+    wide2_sub<P>(r2, D2);
+    fq2_mul_wide<P>(T3, z3, x4);
+    wide2_add<P>(S1, T3);
+    wide2_add<P>(r2, T3);
+
+    // For z.b_.a_ = z3
+    fq2_add<P>(s, z2, z4);
+    fq2_add<P>(t, x2, x4);
+    fq2_mul_wide<P>(r3, s, t);
+    wide2_sub<P>(r3, D2);
+    wide2_sub<P>(r3, D4);
+    wide2_mul_by_xi<P>(r3);
+    fq2_mul_wide<P>(T3, z3, x0);
+    wide2_add<P>(S1, T3);
+    wide2_add<P>(r3, T3);
+
+    // For z.b_.b_ = z4
+    fq2_mul_wide<P>(r4, z5, x2);
+    wide2_add<P>(S1, r4);
+    wide2_mul_by_xi<P>(r4);
+    fq2_add<P>(s, z0, z4);
+    fq2_add<P>(t, x0, x4);
+    fq2_mul_wide<P>(T3, s, t);
+    wide2_sub<P>(T3, D0);
+    wide2_sub<P>(T3, D4);
+    wide2_add<P>(r4, T3);
+
+    // For z.b_.c_ = z5.
+    fq2_add<P>(s, z1, z3);
+    fq2_add<P>(s, s, z5);
+    fq2_add<P>(t, x0, x2);
+    fq2_add<P>(t, t, x4);
+    fq2_mul_wide<P>(r5, s, t);
+    wide2_sub<P>(r5, S1);
+
+    /* all reads of z0..z5 are done, so the result can be written in place */
+    fq2_reduce<P>(x.limbs, r0);
+    fq2_reduce<P>(x.limbs + 2 * N, r1);
+    fq2_reduce<P>(x.limbs + 4 * N, r2);
+    fq2_reduce<P>(x.limbs + 6 * N, r3);
+    fq2_reduce<P>(x.limbs + 8 * N, r4);
+    fq2_reduce<P>(x.limbs + 10 * N, r5);
+}
+
+template<typename P>
+static void flat_unitary_inverse_inplace(alt_bn128_flat_Fq12 &x)
+{
+    for (size_t k = 6; k < alt_bn128_flat_Fq12::num_coeffs; ++k)
+    {
+        fq_neg<P>(x.limbs + N * k, x.limbs + N * k);
+    }
+}
+
+template<typename P>
+static void flat_frobenius_inplace(alt_bn128_flat_Fq12 &x, const unsigned long power)
+{
+    /* as Fp12_2over3over2_model::frobenius_inplace, coefficient by coefficient */
+    mp_limb_t coeff[2 * N];
+    for (size_t m = 0; m < 6; ++m)
+    {
+        mp_limb_t *z = x.limbs + 2 * N * m;
+        if (power % 2)
+        {
+            fq_neg<P>(z + N, z + N);
+        }
+        if (power % 6 && m % 3 == 1)
+        {
+            load_fq2(coeff, alt_bn128_Fq6::Frobenius_coeffs_c1[power % 6]);
+            fq2_mul<P>(z, z, coeff);
+        }
+        if (power % 6 && m % 3 == 2)
+        {
+            load_fq2(coeff, alt_bn128_Fq6::Frobenius_coeffs_c2[power % 6]);
+            fq2_mul<P>(z, z, coeff);
+        }
+        if (power % 12 && m >= 3)
+        {
+            load_fq2(coeff, alt_bn128_Fq12::Frobenius_coeffs_c1[power % 12]);
+            fq2_mul<P>(z, z, coeff);
+        }
+    }
+}
+
+template<typename P>
+static alt_bn128_flat_Fq12 flat_cyclotomic_exp(const alt_bn128_flat_Fq12 &x, const bigint<alt_bn128_q_limbs> &exponent)
+{
+    alt_bn128_flat_Fq12 res = alt_bn128_flat_Fq12::one();
+
+    bool found_one = false;
+    for (long i = alt_bn128_q_limbs - 1; i >= 0; --i)
+    {
+        for (long j = GMP_NUMB_BITS - 1; j >= 0; --j)
+        {
+            if (found_one)
+            {
+                flat_cyclotomic_square_inplace<P>(res);
+            }
+
+            static const mp_limb_t one = 1;
+            if (exponent.data[i] & (one << j))
+            {
+                /* the first set bit needs no multiplication */
+                if (found_one)
+                {
+                    flat_mul_into<P>(res, x, res);
+                }
+                else
+                {
+                    res = x;
+                    found_one = true;
+                }
+            }
+        }
+    }
+
+    return res;
+}
+
+void alt_bn128_flat_Fq12::mul_into(const alt_bn128_flat_Fq12 &other, alt_bn128_flat_Fq12 &result) const
+{
+    flat_mul_into<flat_primitives>(*this, other, result);
+}
+
+alt_bn128_flat_Fq12& alt_bn128_flat_Fq12::square_inplace()
+{
+    flat_square_inplace<flat_primitives>(*this);
+    return (*this);
+}
+
+alt_bn128_flat_Fq12& alt_bn128_flat_Fq12::cyclotomic_square_inplace()
+{
+    flat_cyclotomic_square_inplace<flat_primitives>(*this);
+    return (*this);
+}
+
+alt_bn128_flat_Fq12& alt_bn128_flat_Fq12::mul_by_024_inplace(const alt_bn128_Fq2 &ell_0,
+                                                             const alt_bn128_Fq2 &ell_VW,
+                                                             const alt_bn128_Fq2 &ell_VV)
+{
+    flat_mul_by_024_inplace<flat_primitives>(*this, ell_0, ell_VW, ell_VV);
+    return (*this);
+}
+
+alt_bn128_flat_Fq12& alt_bn128_flat_Fq12::unitary_inverse_inplace()
+{
+    flat_unitary_inverse_inplace<flat_primitives>(*this);
+    return (*this);
+}
+
+alt_bn128_flat_Fq12& alt_bn128_flat_Fq12::frobenius_inplace(unsigned long power)
+{
+    flat_frobenius_inplace<flat_primitives>(*this, power);
+    return (*this);
+}
+
+alt_bn128_flat_Fq12 alt_bn128_flat_Fq12::cyclotomic_exp(const bigint<alt_bn128_q_limbs> &exponent) const
+{
+    return flat_cyclotomic_exp<flat_primitives>(*this, exponent);
+}
+
+void alt_bn128_flat_Fq12_portable::mul_into(const alt_bn128_flat_Fq12 &x, const alt_bn128_flat_Fq12 &y, alt_bn128_flat_Fq12 &result)
+{
+    flat_mul_into<mpn_primitives>(x, y, result);
+}
+
+void alt_bn128_flat_Fq12_portable::square_inplace(alt_bn128_flat_Fq12 &x)
+{
+    flat_square_inplace<mpn_primitives>(x);
+}
+
+void alt_bn128_flat_Fq12_portable::cyclotomic_square_inplace(alt_bn128_flat_Fq12 &x)
+{
+    flat_cyclotomic_square_inplace<mpn_primitives>(x);
+}
+
+void alt_bn128_flat_Fq12_portable::mul_by_024_inplace(alt_bn128_flat_Fq12 &x,
+                                                      const alt_bn128_Fq2 &ell_0,
+                                                      const alt_bn128_Fq2 &ell_VW,
+                                                      const alt_bn128_Fq2 &ell_VV)
+{
+    flat_mul_by_024_inplace<mpn_primitives>(x, ell_0, ell_VW, ell_VV);
+}
+
+void alt_bn128_flat_Fq12_portable::unitary_inverse_inplace(alt_bn128_flat_Fq12 &x)
+{
+    flat_unitary_inverse_inplace<mpn_primitives>(x);
+}
+
+void alt_bn128_flat_Fq12_portable::frobenius_inplace(alt_bn128_flat_Fq12 &x, const unsigned long power)
+{
+    flat_frobenius_inplace<mpn_primitives>(x, power);
+}
+
+alt_bn128_flat_Fq12 alt_bn128_flat_Fq12_portable::cyclotomic_exp(const alt_bn128_flat_Fq12 &x,
+                                                                 const bigint<alt_bn128_q_limbs> &exponent)
+{
+    return flat_cyclotomic_exp<mpn_primitives>(x, exponent);
+}
+
+} // namespace libff
@@ -0,0 +1,79 @@
+/** @file
+ *****************************************************************************
+ Declaration of a flat representation of alt_bn128_Fq12 for the pairing.
+
+ alt_bn128_Fq12 is built from nested Fp6, Fp2 and Fp models, whose
+ operations are generic templates that call into GMP for every product and
+ reduce after most of them. alt_bn128_flat_Fq12 holds the same twelve
+ coefficients in Montgomery form as one 64-byte aligned array of limbs, and
+ its operations are fused kernels specialized to the alt_bn128 tower
+ (u^2 = -1 and v^3 = xi = 9 + u): products stay in double width across
+ the Fp2 and Fp6 levels, the multiplications by xi are additions on
+ double-width values, and only the twelve output coefficients are reduced.
+
+ The Miller loops and the final exponentiation in alt_bn128_pairing.cpp
+ convert to this representation on entry and back on exit.
+
+ The kernels are written once over a set of primitives on limbs. On x86-64
+ the members run them on straight-line code with carry intrinsics; elsewhere,
+ or when NO_FLAT_FQ12_INTRINSICS is defined, on mpn. The mpn instantiation is
+ always built and exposed as alt_bn128_flat_Fq12_portable, so that it is
+ tested on every machine.
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef ALT_BN128_FLAT_FQ12_HPP_
+#define ALT_BN128_FLAT_FQ12_HPP_
+#include <cstddef>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_fields.hpp>
+
+namespace libff {
+
+struct alignas(64) alt_bn128_flat_Fq12 {
+    /* the coefficient c_i.c_j.c_k of alt_bn128_Fq12 is at limbs + (6*i + 2*j + k) * alt_bn128_q_limbs */
+    static const std::size_t num_coeffs = 12;
+    mp_limb_t limbs[num_coeffs * alt_bn128_q_limbs];
+
+    alt_bn128_flat_Fq12() {};
+    explicit alt_bn128_flat_Fq12(const alt_bn128_Fq12 &elt);
+    alt_bn128_Fq12 to_Fq12() const;
+
+    static alt_bn128_flat_Fq12 one();
+
+    bool operator==(const alt_bn128_flat_Fq12 &other) const;
+    bool operator!=(const alt_bn128_flat_Fq12 &other) const;
+
+    /* As the alt_bn128_Fq12 operations of the same names; result may alias this or other. */
+    void mul_into(const alt_bn128_flat_Fq12 &other, alt_bn128_flat_Fq12 &result) const;
+    alt_bn128_flat_Fq12& square_inplace();
+    alt_bn128_flat_Fq12& cyclotomic_square_inplace();
+    alt_bn128_flat_Fq12& mul_by_024_inplace(const alt_bn128_Fq2 &ell_0,
+                                            const alt_bn128_Fq2 &ell_VW,
+                                            const alt_bn128_Fq2 &ell_VV);
+    alt_bn128_flat_Fq12& unitary_inverse_inplace();
+    alt_bn128_flat_Fq12& frobenius_inplace(unsigned long power);
+    /* this^exponent, for this in the cyclotomic subgroup */
+    alt_bn128_flat_Fq12 cyclotomic_exp(const bigint<alt_bn128_q_limbs> &exponent) const;
+};
+
+/* The operations of alt_bn128_flat_Fq12 on the mpn kernels, whichever ones its members use. */
+struct alt_bn128_flat_Fq12_portable {
+    static void mul_into(const alt_bn128_flat_Fq12 &x, const alt_bn128_flat_Fq12 &y, alt_bn128_flat_Fq12 &result);
+    static void square_inplace(alt_bn128_flat_Fq12 &x);
+    static void cyclotomic_square_inplace(alt_bn128_flat_Fq12 &x);
+    static void mul_by_024_inplace(alt_bn128_flat_Fq12 &x,
+                                   const alt_bn128_Fq2 &ell_0,
+                                   const alt_bn128_Fq2 &ell_VW,
+                                   const alt_bn128_Fq2 &ell_VV);
+    static void unitary_inverse_inplace(alt_bn128_flat_Fq12 &x);
+    static void frobenius_inplace(alt_bn128_flat_Fq12 &x, const unsigned long power);
+    static alt_bn128_flat_Fq12 cyclotomic_exp(const alt_bn128_flat_Fq12 &x, const bigint<alt_bn128_q_limbs> &exponent);
+};
+
+} // namespace libff
+
+#endif // ALT_BN128_FLAT_FQ12_HPP_
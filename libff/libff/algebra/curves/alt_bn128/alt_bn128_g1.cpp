@@ -461,18 +461,21 @@ std::istream& operator>>(std::istream& in, std::vector<alt_bn128_G1> &v)
 
 void alt_bn128_G1::batch_to_special_all_non_zeros(std::vector<alt_bn128_G1> &vec)
 {
-    std::vector<alt_bn128_Fq> Z_vec;
-    Z_vec.reserve(vec.size());
+    batch_to_special_all_non_zeros(vec.data(), vec.size());
+}
 
-    for (auto &el: vec)
+void alt_bn128_G1::batch_to_special_all_non_zeros(alt_bn128_G1 *vec, const size_t count)
+{
+    std::vector<alt_bn128_Fq> Z_vec(count), prod(count);
+    for (size_t i = 0; i < count; ++i)
     {
-        Z_vec.emplace_back(el.Z);
+        Z_vec[i] = vec[i].Z;
     }
-    batch_invert<alt_bn128_Fq>(Z_vec);
+    batch_invert<alt_bn128_Fq>(Z_vec.data(), prod.data(), count);
 
     const alt_bn128_Fq one = alt_bn128_Fq::one();
 
-    for (size_t i = 0; i < vec.size(); ++i)
+    for (size_t i = 0; i < count; ++i)
     {
         alt_bn128_Fq Z2 = Z_vec[i].squared();
         alt_bn128_Fq Z3 = Z_vec[i] * Z2;
@@ -483,4 +486,30 @@ void alt_bn128_G1::batch_to_special_all_non_zeros(std::vector<alt_bn128_G1> &vec
     }
 }
 
+template<>
+void batch_to_special_table<alt_bn128_G1>(alt_bn128_G1 *table, const size_t count)
+{
+    const size_t max_count = size_t(1) << (wnaf_max_window - 1);
+    assert(count <= max_count);
+
+    alt_bn128_Fq Z_inv[max_count], prod[max_count];
+    for (size_t i = 0; i < count; ++i)
+    {
+        Z_inv[i] = table[i].Z;
+    }
+    batch_invert<alt_bn128_Fq>(Z_inv, prod, count);
+
+    const alt_bn128_Fq one = alt_bn128_Fq::one();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        alt_bn128_Fq Z2 = Z_inv[i].squared();
+        alt_bn128_Fq Z3 = Z_inv[i] * Z2;
+
+        table[i].X = table[i].X * Z2;
+        table[i].Y = table[i].Y * Z3;
+        table[i].Z = one;
+    }
+}
+
 } // namespace libff
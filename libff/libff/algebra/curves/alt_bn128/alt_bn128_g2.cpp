@@ -336,7 +336,20 @@ alt_bn128_G2 alt_bn128_G2::mul_by_q() const
 
 alt_bn128_G2 alt_bn128_G2::mul_by_cofactor() const
 {
-    return alt_bn128_G2::h * (*this);
+    /* h = 2 q - r = q - 1 + t for the trace t = 6 x^2 + 1 of the Frobenius on
+       E, and psi satisfies psi^2 - [t] psi + [q] = 0 on all of E'(F_q^2)
+       (Galbraith--Scott; Fuentes-Castaneda, Knapp and Rodriguez-Henriquez,
+       Faster hashing to G2). Hence
+
+         [h] P = [t] (P + psi(P)) - P - psi^2(P) = [6 x^2] (P + psi(P)) + psi(P) - psi^2(P),
+
+       which takes two multiplications by the 63-bit x instead of one by the
+       254-bit h. */
+    const alt_bn128_G2 psiP = this->mul_by_q();
+    const alt_bn128_G2 Q = (*this) + psiP;
+    const alt_bn128_G2 x2Q = alt_bn128_final_exponent_z * (alt_bn128_final_exponent_z * Q);
+    const alt_bn128_G2 x2Q_times_3 = x2Q.dbl() + x2Q;
+    return x2Q_times_3.dbl() + psiP - psiP.mul_by_q();
 }
 
 bool alt_bn128_G2::is_well_formed() const
@@ -444,18 +457,21 @@ std::istream& operator>>(std::istream &in, alt_bn128_G2 &g)
 
 void alt_bn128_G2::batch_to_special_all_non_zeros(std::vector<alt_bn128_G2> &vec)
 {
-    std::vector<alt_bn128_Fq2> Z_vec;
-    Z_vec.reserve(vec.size());
+    batch_to_special_all_non_zeros(vec.data(), vec.size());
+}
 
-    for (auto &el: vec)
+void alt_bn128_G2::batch_to_special_all_non_zeros(alt_bn128_G2 *vec, const size_t count)
+{
+    std::vector<alt_bn128_Fq2> Z_vec(count), prod(count);
+    for (size_t i = 0; i < count; ++i)
     {
-        Z_vec.emplace_back(el.Z);
+        Z_vec[i] = vec[i].Z;
     }
-    batch_invert<alt_bn128_Fq2>(Z_vec);
+    batch_invert<alt_bn128_Fq2>(Z_vec.data(), prod.data(), count);
 
     const alt_bn128_Fq2 one = alt_bn128_Fq2::one();
 
-    for (size_t i = 0; i < vec.size(); ++i)
+    for (size_t i = 0; i < count; ++i)
     {
         alt_bn128_Fq2 Z2 = Z_vec[i].squared();
         alt_bn128_Fq2 Z3 = Z_vec[i] * Z2;
@@ -466,4 +482,30 @@ void alt_bn128_G2::batch_to_special_all_non_zeros(std::vector<alt_bn128_G2> &vec
     }
 }
 
+template<>
+void batch_to_special_table<alt_bn128_G2>(alt_bn128_G2 *table, const size_t count)
+{
+    const size_t max_count = size_t(1) << (wnaf_max_window - 1);
+    assert(count <= max_count);
+
+    alt_bn128_Fq2 Z_inv[max_count], prod[max_count];
+    for (size_t i = 0; i < count; ++i)
+    {
+        Z_inv[i] = table[i].Z;
+    }
+    batch_invert<alt_bn128_Fq2>(Z_inv, prod, count);
+
+    const alt_bn128_Fq2 one = alt_bn128_Fq2::one();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        alt_bn128_Fq2 Z2 = Z_inv[i].squared();
+        alt_bn128_Fq2 Z3 = Z_inv[i] * Z2;
+
+        table[i].X = table[i].X * Z2;
+        table[i].Y = table[i].Y * Z3;
+        table[i].Z = one;
+    }
+}
+
 } // namespace libff
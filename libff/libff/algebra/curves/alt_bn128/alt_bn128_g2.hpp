@@ -83,8 +83,13 @@ public:
     friend std::istream& operator>>(std::istream &in, alt_bn128_G2 &g);
 
     static void batch_to_special_all_non_zeros(std::vector<alt_bn128_G2> &vec);
+    static void batch_to_special_all_non_zeros(alt_bn128_G2 *vec, const std::size_t count);
 };
 
+/* without heap allocations, for the wNAF tables of scalar multiplication */
+template<>
+void batch_to_special_table<alt_bn128_G2>(alt_bn128_G2 *table, const std::size_t count);
+
 template<mp_size_t m>
 alt_bn128_G2 operator*(const bigint<m> &lhs, const alt_bn128_G2 &rhs)
 {
@@ -0,0 +1,90 @@
+/** @file
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_hash_to_curve.hpp>
+#include <libff/algebra/curves/hash_to_curve.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include <libff/common/parallel.hpp>
+
+namespace libff {
+
+using std::size_t;
+
+/* bytes per base field element in hash_to_field: ceil((254 + 128) / 8) */
+static const size_t alt_bn128_hash_to_field_L = 48;
+
+/* The constants are built on first use, once the curve is initialized. */
+
+static const svdw_map_params<alt_bn128_Fq>& alt_bn128_G1_svdw()
+{
+    static const svdw_map_params<alt_bn128_Fq> params(
+        alt_bn128_Fq::zero(), alt_bn128_coeff_b, alt_bn128_Fq::one());
+    return params;
+}
+
+static const svdw_map_params<alt_bn128_Fq2>& alt_bn128_G2_svdw()
+{
+    static const svdw_map_params<alt_bn128_Fq2> params(
+        alt_bn128_Fq2::zero(), alt_bn128_twist_coeff_b, alt_bn128_Fq2::one());
+    return params;
+}
+
+/* hash_to_curve before the normalization of the result */
+static alt_bn128_G1 alt_bn128_hash_to_G1_unnormalized(const std::string &msg, const std::string &dst)
+{
+    const std::vector<alt_bn128_Fq> u = hash_to_field<alt_bn128_Fq>(msg, dst, 2, alt_bn128_hash_to_field_L);
+    return map_to_curve_svdw<alt_bn128_G1>(u[0], alt_bn128_G1_svdw()) +
+        map_to_curve_svdw<alt_bn128_G1>(u[1], alt_bn128_G1_svdw());
+}
+
+static alt_bn128_G2 alt_bn128_hash_to_G2_unnormalized(const std::string &msg, const std::string &dst)
+{
+    const std::vector<alt_bn128_Fq2> u = hash_to_field<alt_bn128_Fq2>(msg, dst, 2, alt_bn128_hash_to_field_L);
+    const alt_bn128_G2 R = map_to_curve_svdw<alt_bn128_G2>(u[0], alt_bn128_G2_svdw()) +
+        map_to_curve_svdw<alt_bn128_G2>(u[1], alt_bn128_G2_svdw());
+    return R.mul_by_cofactor();
+}
+
+alt_bn128_G1 alt_bn128_hash_to_G1(const std::string &msg, const std::string &dst)
+{
+    alt_bn128_G1 P = alt_bn128_hash_to_G1_unnormalized(msg, dst);
+    P.to_special();
+    return P;
+}
+
+alt_bn128_G2 alt_bn128_hash_to_G2(const std::string &msg, const std::string &dst)
+{
+    alt_bn128_G2 P = alt_bn128_hash_to_G2_unnormalized(msg, dst);
+    P.to_special();
+    return P;
+}
+
+std::vector<alt_bn128_G1> alt_bn128_batch_hash_to_G1(const std::vector<std::string> &msgs,
+                                                     const std::string &dst)
+{
+    std::vector<alt_bn128_G1> result(msgs.size());
+    parallel_for(msgs.size(), [&](const size_t i)
+    {
+        result[i] = alt_bn128_hash_to_G1_unnormalized(msgs[i], dst);
+    });
+    batch_to_special(result);
+    return result;
+}
+
+std::vector<alt_bn128_G2> alt_bn128_batch_hash_to_G2(const std::vector<std::string> &msgs,
+                                                     const std::string &dst)
+{
+    std::vector<alt_bn128_G2> result(msgs.size());
+    parallel_for(msgs.size(), [&](const size_t i)
+    {
+        result[i] = alt_bn128_hash_to_G2_unnormalized(msgs[i], dst);
+    });
+    batch_to_special(result);
+    return result;
+}
+
+} // namespace libff
@@ -0,0 +1,41 @@
+/** @file
+ *****************************************************************************
+ Hashing to the groups of alt_bn128 (BN254) with the Shallue--van de Woestijne
+ map of RFC 9380, 6.6.1, since neither curve has a usable simplified SWU map
+ (A = 0) and no low-degree isogeny is known for them.
+
+ hash_to_G1 is the suite BN254G1_XMD:SHA-256_SVDW_RO_: two field elements
+ from hash_to_field with L = 48, mapped with Z = 1 and added; the cofactor
+ of G1 is 1. hash_to_G2 follows the same steps on the twist, where Z = 1
+ is also the first value that satisfies the criteria of RFC 9380, H.1, and
+ clears the cofactor with mul_by_cofactor.
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef ALT_BN128_HASH_TO_CURVE_HPP_
+#define ALT_BN128_HASH_TO_CURVE_HPP_
+#include <string>
+#include <vector>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_g1.hpp>
+#include <libff/algebra/curves/alt_bn128/alt_bn128_g2.hpp>
+
+namespace libff {
+
+/* The results are in their prime-order subgroups, with Z = 1 unless zero. */
+alt_bn128_G1 alt_bn128_hash_to_G1(const std::string &msg, const std::string &dst);
+alt_bn128_G2 alt_bn128_hash_to_G2(const std::string &msg, const std::string &dst);
+
+/* The hashes of all the messages, spread over parallel_for, with one
+   batched inversion to normalize all of them. */
+std::vector<alt_bn128_G1> alt_bn128_batch_hash_to_G1(const std::vector<std::string> &msgs,
+                                                     const std::string &dst);
+std::vector<alt_bn128_G2> alt_bn128_batch_hash_to_G2(const std::vector<std::string> &msgs,
+                                                     const std::string &dst);
+
+} // namespace libff
+
+#endif // ALT_BN128_HASH_TO_CURVE_HPP_
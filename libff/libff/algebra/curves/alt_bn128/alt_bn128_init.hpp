@@ -7,6 +7,9 @@
 
 #ifndef ALT_BN128_INIT_HPP_
 #define ALT_BN128_INIT_HPP_
+#include <array>
+#include <cstddef>
+
 #include <libff/algebra/curves/public_params.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_fields.hpp>
 
@@ -25,6 +28,52 @@ extern alt_bn128_Fq2 alt_bn128_twist_mul_by_q_Y;
 // parameters for pairing
 extern bigint<alt_bn128_q_limbs> alt_bn128_ate_loop_count;
 extern bool alt_bn128_ate_is_loop_count_neg;
+/* alt_bn128_ate_loop_count = 6x+2 as little-endian 64-bit limbs */
+constexpr std::array<unsigned long long, 2> alt_bn128_ate_loop_count_limbs = {{ 0x9d797039be763ba8ull, 0x1ull }};
+
+constexpr std::size_t alt_bn128_ate_loop_count_naf_size = 66;
+
+struct alt_bn128_ate_naf {
+    signed char digits[alt_bn128_ate_loop_count_naf_size];
+    /* whether the digits hold all of the value */
+    bool complete;
+};
+
+/* The non-adjacent form of a value of two 64-bit limbs, least significant digit first. */
+constexpr alt_bn128_ate_naf alt_bn128_make_ate_naf(const std::array<unsigned long long, 2> &value)
+{
+    alt_bn128_ate_naf naf = {};
+    unsigned long long lo = value[0], hi = value[1];
+    for (std::size_t i = 0; i < alt_bn128_ate_loop_count_naf_size; ++i)
+    {
+        if (lo & 1)
+        {
+            /* the digit d = 2 - (value mod 4) leaves value - d divisible by 4 */
+            naf.digits[i] = ((lo & 3) == 1 ? 1 : -1);
+            if (naf.digits[i] == 1)
+            {
+                --lo;
+            }
+            else if (++lo == 0)
+            {
+                ++hi;
+            }
+        }
+        lo = (lo >> 1) | (hi << 63);
+        hi >>= 1;
+    }
+    naf.complete = (lo == 0 && hi == 0);
+    return naf;
+}
+
+/* alt_bn128_ate_loop_count in non-adjacent form: 22 non-zero digits against
+   37 set bits, so the Miller loop does 21 addition steps instead of 36 */
+constexpr alt_bn128_ate_naf alt_bn128_ate_loop_count_naf_digits = alt_bn128_make_ate_naf(alt_bn128_ate_loop_count_limbs);
+static_assert(alt_bn128_ate_loop_count_naf_digits.complete &&
+              alt_bn128_ate_loop_count_naf_digits.digits[alt_bn128_ate_loop_count_naf_size - 1] == 1,
+              "alt_bn128_ate_loop_count_naf_size must be the length of the NAF of the loop count");
+static constexpr const signed char (&alt_bn128_ate_loop_count_naf)[alt_bn128_ate_loop_count_naf_size] =
+    alt_bn128_ate_loop_count_naf_digits.digits;
 extern bigint<alt_bn128_q_limbs> alt_bn128_final_exponent_z;
 extern bool alt_bn128_final_exponent_is_z_neg;
 
@@ -5,12 +5,18 @@
  * @copyright  MIT license (see LICENSE file)
  *****************************************************************************/
 
+#include <algorithm>
 #include <cassert>
 
+#include <libff/algebra/curves/alt_bn128/alt_bn128_flat_fq12.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_g1.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_g2.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_init.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_pairing.hpp>
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pairing_detail.hpp>
+#include <libff/algebra/field_utils/field_utils.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include <libff/common/parallel.hpp>
 #include <libff/common/profiling.hpp>
 
 namespace libff {
@@ -125,33 +131,39 @@ alt_bn128_Fq12 alt_bn128_final_exponentiation_first_chunk(const alt_bn128_Fq12 &
       result = D * C
     */
 
-    const alt_bn128_Fq12 A = alt_bn128_Fq12(elt.c0,-elt.c1);
-    const alt_bn128_Fq12 B = elt.inverse();
-    const alt_bn128_Fq12 C = A * B;
-    const alt_bn128_Fq12 D = C.Frobenius_map(2);
-    const alt_bn128_Fq12 result = D * C;
+    alt_bn128_Fq12 C = elt.inverse();                      // B
+    elt.unitary_inverse().mul_into(C, C);                  // C = A * B
+    alt_bn128_Fq12 result = C;
+    result.frobenius_inplace(2);                           // D
+    result.mul_into(C, result);                            // result = D * C
 
     leave_block("Call to alt_bn128_final_exponentiation_first_chunk");
 
     return result;
 }
 
-alt_bn128_Fq12 alt_bn128_exp_by_neg_z(const alt_bn128_Fq12 &elt)
+static alt_bn128_flat_Fq12 alt_bn128_flat_exp_by_neg_z(const alt_bn128_flat_Fq12 &elt)
 {
-    enter_block("Call to alt_bn128_exp_by_neg_z");
-
-    alt_bn128_Fq12 result = elt.cyclotomic_exp(alt_bn128_final_exponent_z);
+    alt_bn128_flat_Fq12 result = elt.cyclotomic_exp(alt_bn128_final_exponent_z);
     if (!alt_bn128_final_exponent_is_z_neg)
     {
-        result = result.unitary_inverse();
+        result.unitary_inverse_inplace();
     }
+    return result;
+}
+
+alt_bn128_Fq12 alt_bn128_exp_by_neg_z(const alt_bn128_Fq12 &elt)
+{
+    enter_block("Call to alt_bn128_exp_by_neg_z");
+
+    const alt_bn128_Fq12 result = alt_bn128_flat_exp_by_neg_z(alt_bn128_flat_Fq12(elt)).to_Fq12();
 
     leave_block("Call to alt_bn128_exp_by_neg_z");
 
     return result;
 }
 
-alt_bn128_Fq12 alt_bn128_final_exponentiation_last_chunk(const alt_bn128_Fq12 &elt)
+alt_bn128_Fq12 alt_bn128_final_exponentiation_last_chunk(const alt_bn128_Fq12 &elt_in)
 {
     enter_block("Call to alt_bn128_final_exponentiation_last_chunk");
 
@@ -193,32 +205,38 @@ alt_bn128_Fq12 alt_bn128_final_exponentiation_last_chunk(const alt_bn128_Fq12 &e
       V = U * R              // = elt^(q^3(12*z^3 + 6*z^2 + 4*z - 1) + q^2 * (12*z^3 + 6*z^2 + 6*z) + q*(12*z^3 + 6*z^2 + 4*z) * (12*z^3 + 12*z^2 + 6*z + 1))
       result = V
 
+      The chain is evaluated in place on flat Fq12 values, keeping only four
+      of them live (named after the first step each one holds).
     */
 
-    const alt_bn128_Fq12 A = alt_bn128_exp_by_neg_z(elt);
-    const alt_bn128_Fq12 B = A.cyclotomic_squared();
-    const alt_bn128_Fq12 C = B.cyclotomic_squared();
-    const alt_bn128_Fq12 D = C * B;
-    const alt_bn128_Fq12 E = alt_bn128_exp_by_neg_z(D);
-    const alt_bn128_Fq12 F = E.cyclotomic_squared();
-    const alt_bn128_Fq12 G = alt_bn128_exp_by_neg_z(F);
-    const alt_bn128_Fq12 H = D.unitary_inverse();
-    const alt_bn128_Fq12 I = G.unitary_inverse();
-    const alt_bn128_Fq12 J = I * E;
-    const alt_bn128_Fq12 K = J * H;
-    const alt_bn128_Fq12 L = K * B;
-    const alt_bn128_Fq12 M = K * E;
-    const alt_bn128_Fq12 N = M * elt;
-    const alt_bn128_Fq12 O = L.Frobenius_map(1);
-    const alt_bn128_Fq12 P = O * N;
-    const alt_bn128_Fq12 Q = K.Frobenius_map(2);
-    const alt_bn128_Fq12 R = Q * P;
-    const alt_bn128_Fq12 S = elt.unitary_inverse();
-    const alt_bn128_Fq12 T = S * L;
-    const alt_bn128_Fq12 U = T.Frobenius_map(3);
-    const alt_bn128_Fq12 V = U * R;
-
-    const alt_bn128_Fq12 result = V;
+    const alt_bn128_flat_Fq12 elt(elt_in);
+    alt_bn128_flat_Fq12 B = alt_bn128_flat_exp_by_neg_z(elt); // A
+    B.cyclotomic_square_inplace();                         // B
+    alt_bn128_flat_Fq12 D = B;
+    D.cyclotomic_square_inplace();                         // C
+    D.mul_into(B, D);                                      // D = C * B
+    alt_bn128_flat_Fq12 E = alt_bn128_flat_exp_by_neg_z(D); // E
+    alt_bn128_flat_Fq12 K = E;
+    K.cyclotomic_square_inplace();                         // F
+    K = alt_bn128_flat_exp_by_neg_z(K);                    // G
+    K.unitary_inverse_inplace();                           // I = conj(G)
+    K.mul_into(E, K);                                      // J = I * E
+    D.unitary_inverse_inplace();                           // H = conj(D)
+    K.mul_into(D, K);                                      // K = J * H
+    B.mul_into(K, B);                                      // L = K * B
+    E.mul_into(K, E);                                      // M = K * E
+    E.mul_into(elt, E);                                    // N = M * elt
+    D = B;
+    D.frobenius_inplace(1);                                // O = L.Frobenius_map(1)
+    D.mul_into(E, D);                                      // P = O * N
+    K.frobenius_inplace(2);                                // Q = K.Frobenius_map(2)
+    K.mul_into(D, K);                                      // R = Q * P
+    alt_bn128_flat_Fq12 U = elt;
+    U.unitary_inverse_inplace();                           // S = conj(elt)
+    U.mul_into(B, U);                                      // T = S * L
+    U.frobenius_inplace(3);                                // U = T.Frobenius_map(3)
+    U.mul_into(K, U);                                      // V = U * R
+    const alt_bn128_Fq12 result = U.to_Fq12();
 
     leave_block("Call to alt_bn128_final_exponentiation_last_chunk");
 
@@ -301,10 +319,11 @@ alt_bn128_ate_G1_precomp alt_bn128_ate_precompute_G1(const alt_bn128_G1& P)
     return result;
 }
 
-alt_bn128_ate_G2_precomp alt_bn128_ate_precompute_G2(const alt_bn128_G2& Q)
-{
-    enter_block("Call to alt_bn128_ate_precompute_G2");
+/* The precomputations below do not profile, so that the slices of
+   alt_bn128_pairs_miller_loop can run them concurrently. */
 
+static alt_bn128_ate_G2_precomp alt_bn128_ate_precompute_G2_inner(const alt_bn128_G2& Q)
+{
     alt_bn128_G2 Qcopy(Q);
     Qcopy.to_affine_coordinates();
 
@@ -319,26 +338,22 @@ alt_bn128_ate_G2_precomp alt_bn128_ate_precompute_G2(const alt_bn128_G2& Q)
     R.Y = Qcopy.Y;
     R.Z = alt_bn128_Fq2::one();
 
-    const bigint<alt_bn128_Fr::num_limbs> &loop_count = alt_bn128_ate_loop_count;
-    bool found_one = false;
+    /* the addition steps of the -1 digits use the line through R and -Q */
+    alt_bn128_G2 Qneg = Qcopy;
+    Qneg.Y = -Qneg.Y;
     alt_bn128_ate_ell_coeffs c;
 
-    for (long i = loop_count.max_bits(); i >= 0; --i)
+    /* the leading digit is a 1 and only sets R = Q */
+    for (long i = alt_bn128_ate_loop_count_naf_size - 2; i >= 0; --i)
     {
-        const bool bit = loop_count.test_bit(i);
-        if (!found_one)
-        {
-            /* this skips the MSB itself */
-            found_one |= bit;
-            continue;
-        }
+        const signed char digit = alt_bn128_ate_loop_count_naf[i];
 
         doubling_step_for_flipped_miller_loop(two_inv, R, c);
         result.coeffs.push_back(c);
 
-        if (bit)
+        if (digit != 0)
         {
-            mixed_addition_step_for_flipped_miller_loop(Qcopy, R, c);
+            mixed_addition_step_for_flipped_miller_loop(digit > 0 ? Qcopy : Qneg, R, c);
             result.coeffs.push_back(c);
         }
     }
@@ -360,62 +375,258 @@ alt_bn128_ate_G2_precomp alt_bn128_ate_precompute_G2(const alt_bn128_G2& Q)
     mixed_addition_step_for_flipped_miller_loop(Q2, R, c);
     result.coeffs.push_back(c);
 
+    return result;
+}
+
+alt_bn128_ate_G2_precomp alt_bn128_ate_precompute_G2(const alt_bn128_G2& Q)
+{
+    enter_block("Call to alt_bn128_ate_precompute_G2");
+    alt_bn128_ate_G2_precomp result = alt_bn128_ate_precompute_G2_inner(Q);
     leave_block("Call to alt_bn128_ate_precompute_G2");
     return result;
 }
 
+/* The line through the affine point (x, y) of slope lambda, as in
+   mixed_addition_step_for_flipped_miller_loop with Z1 = 1 and divided by D. */
+static alt_bn128_ate_ell_coeffs affine_line_coeffs(const alt_bn128_Fq2 &lambda,
+                                                   const alt_bn128_Fq2 &x,
+                                                   const alt_bn128_Fq2 &y)
+{
+    alt_bn128_ate_ell_coeffs c;
+    c.ell_0 = alt_bn128_twist * (lambda * x - y); // ell_0 = xi * (lambda * x - y)
+    c.ell_VW = alt_bn128_Fq2::one();              // ell_VW = 1 (later: * yP)
+    c.ell_VV = -lambda;                           // ell_VV = - lambda (later: * xP)
+    return c;
+}
+
+/* The affine steps of alt_bn128_affine_ate_batch_precompute_G2: R[j] is
+   replaced by 2 R[j], or by R[j] + base[j], and the line through them is
+   appended to result[j]. A point whose denominator is zero (R[j] of order
+   2, or R[j] = +-base[j]) gets a denominator of one so that the batch
+   inversion goes through, and is marked in degenerate[j]. */
+class alt_bn128_affine_ate_batch_steps {
+public:
+    std::vector<alt_bn128_Fq2> RX, RY;
+    std::vector<bool> degenerate;
+
+    alt_bn128_affine_ate_batch_steps(const std::vector<alt_bn128_G2> &Q) :
+        RX(Q.size()), RY(Q.size()), degenerate(Q.size(), false), inv(Q.size()), scratch(Q.size())
+    {
+        for (size_t j = 0; j < Q.size(); ++j)
+        {
+            RX[j] = Q[j].X;
+            RY[j] = Q[j].Y;
+        }
+    }
+
+    void doubling_step(std::vector<alt_bn128_ate_G2_precomp> &result)
+    {
+        for (size_t j = 0; j < RX.size(); ++j)
+        {
+            inv[j] = RY[j] + RY[j];
+            flag_if_zero(j);
+        }
+        batch_invert(inv.data(), scratch.data(), inv.size());
+
+        for (size_t j = 0; j < RX.size(); ++j)
+        {
+            const alt_bn128_Fq2 X_squared = RX[j].squared();
+            const alt_bn128_Fq2 lambda = (X_squared + X_squared + X_squared) * inv[j];
+            result[j].coeffs.emplace_back(affine_line_coeffs(lambda, RX[j], RY[j]));
+            const alt_bn128_Fq2 X3 = lambda.squared() - (RX[j] + RX[j]);
+            RY[j] = lambda * (RX[j] - X3) - RY[j];
+            RX[j] = X3;
+        }
+    }
+
+    void addition_step(const std::vector<alt_bn128_Fq2> &baseX,
+                       const std::vector<alt_bn128_Fq2> &baseY,
+                       std::vector<alt_bn128_ate_G2_precomp> &result)
+    {
+        for (size_t j = 0; j < RX.size(); ++j)
+        {
+            inv[j] = RX[j] - baseX[j];
+            flag_if_zero(j);
+        }
+        batch_invert(inv.data(), scratch.data(), inv.size());
+
+        for (size_t j = 0; j < RX.size(); ++j)
+        {
+            const alt_bn128_Fq2 lambda = (RY[j] - baseY[j]) * inv[j];
+            result[j].coeffs.emplace_back(affine_line_coeffs(lambda, RX[j], RY[j]));
+            const alt_bn128_Fq2 X3 = lambda.squared() - (RX[j] + baseX[j]);
+            RY[j] = lambda * (RX[j] - X3) - RY[j];
+            RX[j] = X3;
+        }
+    }
+
+private:
+    std::vector<alt_bn128_Fq2> inv, scratch;
+
+    void flag_if_zero(const size_t j)
+    {
+        if (inv[j].is_zero())
+        {
+            inv[j] = alt_bn128_Fq2::one();
+            degenerate[j] = true;
+        }
+    }
+};
+
+static std::vector<alt_bn128_ate_G2_precomp> alt_bn128_affine_ate_batch_precompute_G2_inner(const std::vector<alt_bn128_G2> &Q)
+{
+    /* zero points are normalized as one and left to the projective precomputation */
+    std::vector<alt_bn128_G2> Qaffine(Q);
+    std::vector<bool> is_zero(Q.size());
+    for (size_t j = 0; j < Q.size(); ++j)
+    {
+        is_zero[j] = Q[j].is_zero();
+        if (is_zero[j])
+        {
+            Qaffine[j] = alt_bn128_G2::one();
+        }
+    }
+    alt_bn128_G2::batch_to_special_all_non_zeros(Qaffine);
+
+    size_t num_coeffs = alt_bn128_ate_loop_count_naf_size - 1 + 2;
+    for (size_t i = 0; i + 1 < alt_bn128_ate_loop_count_naf_size; ++i)
+    {
+        num_coeffs += (alt_bn128_ate_loop_count_naf[i] != 0);
+    }
+
+    const size_t n = Q.size();
+    std::vector<alt_bn128_ate_G2_precomp> result(n);
+    std::vector<alt_bn128_Fq2> QX(n), QY(n), minus_QY(n);
+    for (size_t j = 0; j < n; ++j)
+    {
+        QX[j] = Qaffine[j].X;
+        QY[j] = Qaffine[j].Y;
+        minus_QY[j] = -QY[j];
+        result[j].QX = QX[j];
+        result[j].QY = QY[j];
+        result[j].coeffs.reserve(num_coeffs);
+    }
+
+    alt_bn128_affine_ate_batch_steps R(Qaffine);
+    R.degenerate = is_zero;
+    for (long i = alt_bn128_ate_loop_count_naf_size - 2; i >= 0; --i)
+    {
+        const signed char digit = alt_bn128_ate_loop_count_naf[i];
+        R.doubling_step(result);
+        if (digit != 0)
+        {
+            R.addition_step(QX, digit > 0 ? QY : minus_QY, result);
+        }
+    }
+
+    /* Q1 = psi(Q) and Q2 = -psi^2(Q), as in alt_bn128_ate_precompute_G2 */
+    std::vector<alt_bn128_Fq2> Q1X(n), Q1Y(n), Q2X(n), Q2Y(n);
+    for (size_t j = 0; j < n; ++j)
+    {
+        const alt_bn128_G2 Q1 = Qaffine[j].mul_by_q();
+        const alt_bn128_G2 Q2 = Q1.mul_by_q();
+        Q1X[j] = Q1.X;
+        Q1Y[j] = Q1.Y;
+        Q2X[j] = Q2.X;
+        Q2Y[j] = -Q2.Y;
+    }
+    if (alt_bn128_ate_is_loop_count_neg)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            R.RY[j] = -R.RY[j];
+        }
+    }
+    R.addition_step(Q1X, Q1Y, result);
+    R.addition_step(Q2X, Q2Y, result);
+
+    /* points outside G2 can run into a vertical line */
+    for (size_t j = 0; j < n; ++j)
+    {
+        if (R.degenerate[j])
+        {
+            result[j] = alt_bn128_ate_precompute_G2_inner(Q[j]);
+        }
+    }
+
+    return result;
+}
+
+static std::vector<alt_bn128_ate_G2_precomp> alt_bn128_ate_batch_precompute_G2_inner(const std::vector<alt_bn128_G2> &Q)
+{
+    if (Q.size() >= alt_bn128_affine_ate_min_points)
+    {
+        return alt_bn128_affine_ate_batch_precompute_G2_inner(Q);
+    }
+
+    std::vector<alt_bn128_ate_G2_precomp> result;
+    result.reserve(Q.size());
+    for (const alt_bn128_G2 &point : Q)
+    {
+        result.emplace_back(alt_bn128_ate_precompute_G2_inner(point));
+    }
+    return result;
+}
+
+std::vector<alt_bn128_ate_G2_precomp> alt_bn128_affine_ate_batch_precompute_G2(const std::vector<alt_bn128_G2> &Q)
+{
+    enter_block("Call to alt_bn128_affine_ate_batch_precompute_G2");
+    std::vector<alt_bn128_ate_G2_precomp> result = alt_bn128_affine_ate_batch_precompute_G2_inner(Q);
+    leave_block("Call to alt_bn128_affine_ate_batch_precompute_G2");
+    return result;
+}
+
+std::vector<alt_bn128_ate_G2_precomp> alt_bn128_ate_batch_precompute_G2(const std::vector<alt_bn128_G2> &Q)
+{
+    enter_block("Call to alt_bn128_ate_batch_precompute_G2");
+    std::vector<alt_bn128_ate_G2_precomp> result = alt_bn128_ate_batch_precompute_G2_inner(Q);
+    leave_block("Call to alt_bn128_ate_batch_precompute_G2");
+    return result;
+}
+
 alt_bn128_Fq12 alt_bn128_ate_miller_loop(const alt_bn128_ate_G1_precomp &prec_P,
                                      const alt_bn128_ate_G2_precomp &prec_Q)
 {
     enter_block("Call to alt_bn128_ate_miller_loop");
 
-    alt_bn128_Fq12 f = alt_bn128_Fq12::one();
+    alt_bn128_flat_Fq12 f = alt_bn128_flat_Fq12::one();
 
-    bool found_one = false;
     size_t idx = 0;
 
-    const bigint<alt_bn128_Fr::num_limbs> &loop_count = alt_bn128_ate_loop_count;
     alt_bn128_ate_ell_coeffs c;
 
-    for (long i = loop_count.max_bits(); i >= 0; --i)
+    for (long i = alt_bn128_ate_loop_count_naf_size - 2; i >= 0; --i)
     {
-        const bool bit = loop_count.test_bit(i);
-        if (!found_one)
-        {
-            /* this skips the MSB itself */
-            found_one |= bit;
-            continue;
-        }
+        const signed char digit = alt_bn128_ate_loop_count_naf[i];
 
-        /* code below gets executed for all bits (EXCEPT the MSB itself) of
-           alt_bn128_param_p (skipping leading zeros) in MSB to LSB
-           order */
+        /* code below gets executed for all digits (EXCEPT the leading one)
+           of alt_bn128_ate_loop_count_naf in MSB to LSB order */
 
         c = prec_Q.coeffs[idx++];
-        f = f.squared();
-        f = f.mul_by_024(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
+        f.square_inplace();
+        f.mul_by_024_inplace(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
 
-        if (bit)
+        if (digit != 0)
         {
             c = prec_Q.coeffs[idx++];
-            f = f.mul_by_024(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
+            f.mul_by_024_inplace(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
         }
 
     }
 
     if (alt_bn128_ate_is_loop_count_neg)
     {
-    	f = f.inverse();
+    	f = alt_bn128_flat_Fq12(f.to_Fq12().inverse());
     }
 
     c = prec_Q.coeffs[idx++];
-    f = f.mul_by_024(c.ell_0,prec_P.PY * c.ell_VW,prec_P.PX * c.ell_VV);
+    f.mul_by_024_inplace(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
 
     c = prec_Q.coeffs[idx++];
-    f = f.mul_by_024(c.ell_0,prec_P.PY * c.ell_VW,prec_P.PX * c.ell_VV);
+    f.mul_by_024_inplace(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
 
     leave_block("Call to alt_bn128_ate_miller_loop");
-    return f;
+    return f.to_Fq12();
 }
 
 alt_bn128_Fq12 alt_bn128_ate_double_miller_loop(const alt_bn128_ate_G1_precomp &prec_P1,
@@ -425,68 +636,201 @@ alt_bn128_Fq12 alt_bn128_ate_double_miller_loop(const alt_bn128_ate_G1_precomp &
 {
     enter_block("Call to alt_bn128_ate_double_miller_loop");
 
-    alt_bn128_Fq12 f = alt_bn128_Fq12::one();
+    alt_bn128_flat_Fq12 f = alt_bn128_flat_Fq12::one();
 
-    bool found_one = false;
     size_t idx = 0;
 
-    const bigint<alt_bn128_Fr::num_limbs> &loop_count = alt_bn128_ate_loop_count;
-    for (long i = loop_count.max_bits(); i >= 0; --i)
+    for (long i = alt_bn128_ate_loop_count_naf_size - 2; i >= 0; --i)
     {
-        const bool bit = loop_count.test_bit(i);
-        if (!found_one)
-        {
-            /* this skips the MSB itself */
-            found_one |= bit;
-            continue;
-        }
+        const signed char digit = alt_bn128_ate_loop_count_naf[i];
 
-        /* code below gets executed for all bits (EXCEPT the MSB itself) of
-           alt_bn128_param_p (skipping leading zeros) in MSB to LSB
-           order */
+        /* code below gets executed for all digits (EXCEPT the leading one)
+           of alt_bn128_ate_loop_count_naf in MSB to LSB order */
 
         alt_bn128_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
         alt_bn128_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
         ++idx;
 
-        f = f.squared();
+        f.square_inplace();
 
-        f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-        f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+        f.mul_by_024_inplace(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
+        f.mul_by_024_inplace(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
 
-        if (bit)
+        if (digit != 0)
         {
             alt_bn128_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
             alt_bn128_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
             ++idx;
 
-            f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-            f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+            f.mul_by_024_inplace(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
+            f.mul_by_024_inplace(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
         }
     }
 
     if (alt_bn128_ate_is_loop_count_neg)
     {
-    	f = f.inverse();
+    	f = alt_bn128_flat_Fq12(f.to_Fq12().inverse());
     }
 
     alt_bn128_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
     alt_bn128_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
     ++idx;
-    f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-    f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+    f.mul_by_024_inplace(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
+    f.mul_by_024_inplace(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
 
     c1 = prec_Q1.coeffs[idx];
     c2 = prec_Q2.coeffs[idx];
     ++idx;
-    f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-    f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+    f.mul_by_024_inplace(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
+    f.mul_by_024_inplace(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
 
     leave_block("Call to alt_bn128_ate_double_miller_loop");
 
+    return f.to_Fq12();
+}
+
+static alt_bn128_Fq12 alt_bn128_ate_multi_miller_loop_inner(const alt_bn128_ate_G1_precomp *prec_P,
+                                                          const alt_bn128_ate_G2_precomp *prec_Q,
+                                                          const size_t n)
+{
+    alt_bn128_flat_Fq12 f = alt_bn128_flat_Fq12::one();
+
+    size_t idx = 0;
+
+    for (long i = alt_bn128_ate_loop_count_naf_size - 2; i >= 0; --i)
+    {
+        const signed char digit = alt_bn128_ate_loop_count_naf[i];
+
+        /* as in alt_bn128_ate_double_miller_loop, one squaring per digit for all the pairs */
+        f.square_inplace();
+        for (size_t j = 0; j < n; ++j)
+        {
+            const alt_bn128_ate_ell_coeffs &c = prec_Q[j].coeffs[idx];
+            f.mul_by_024_inplace(c.ell_0, prec_P[j].PY * c.ell_VW, prec_P[j].PX * c.ell_VV);
+        }
+        ++idx;
+
+        if (digit != 0)
+        {
+            for (size_t j = 0; j < n; ++j)
+            {
+                const alt_bn128_ate_ell_coeffs &c = prec_Q[j].coeffs[idx];
+                f.mul_by_024_inplace(c.ell_0, prec_P[j].PY * c.ell_VW, prec_P[j].PX * c.ell_VV);
+            }
+            ++idx;
+        }
+    }
+
+    if (alt_bn128_ate_is_loop_count_neg)
+    {
+        f = alt_bn128_flat_Fq12(f.to_Fq12().inverse());
+    }
+
+    for (size_t k = 0; k < 2; ++k)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            const alt_bn128_ate_ell_coeffs &c = prec_Q[j].coeffs[idx];
+            f.mul_by_024_inplace(c.ell_0, prec_P[j].PY * c.ell_VW, prec_P[j].PX * c.ell_VV);
+        }
+        ++idx;
+    }
+
+    return f.to_Fq12();
+}
+
+alt_bn128_Fq12 alt_bn128_ate_multi_miller_loop(const std::vector<alt_bn128_ate_G1_precomp> &prec_P,
+                                               const std::vector<alt_bn128_ate_G2_precomp> &prec_Q)
+{
+    enter_block("Call to alt_bn128_ate_multi_miller_loop");
+    assert(prec_P.size() == prec_Q.size());
+    alt_bn128_Fq12 f = alt_bn128_ate_multi_miller_loop_inner(prec_P.data(), prec_Q.data(), prec_P.size());
+    leave_block("Call to alt_bn128_ate_multi_miller_loop");
     return f;
 }
 
+/* The Miller loop of pairs[begin, end), none of them with a zero point. */
+static alt_bn128_Fq12 alt_bn128_pairs_miller_loop_slice(const std::vector<std::pair<alt_bn128_G1, alt_bn128_G2> > &pairs,
+                                                        const size_t begin,
+                                                        const size_t end)
+{
+    std::vector<alt_bn128_ate_G1_precomp> prec_P(end - begin);
+    std::vector<alt_bn128_G2> Q;
+    Q.reserve(end - begin);
+    for (size_t j = begin; j < end; ++j)
+    {
+        alt_bn128_G1 Pcopy(pairs[j].first);
+        Pcopy.to_affine_coordinates();
+        prec_P[j - begin].PX = Pcopy.X;
+        prec_P[j - begin].PY = Pcopy.Y;
+        Q.emplace_back(pairs[j].second);
+    }
+    const std::vector<alt_bn128_ate_G2_precomp> prec_Q = alt_bn128_ate_batch_precompute_G2_inner(Q);
+
+    return alt_bn128_ate_multi_miller_loop_inner(prec_P.data(), prec_Q.data(), prec_P.size());
+}
+
+/* The product of the Miller loops of the pairs without a zero point, which
+   from min_parallel_pairs pairs on is split into one slice per task of the
+   parallel executor. The slices share nothing but the input, and their
+   partial products are multiplied at the end. */
+static alt_bn128_Fq12 alt_bn128_pairs_miller_loop(const std::vector<std::pair<alt_bn128_G1, alt_bn128_G2> > &pairs,
+                                                  const size_t min_parallel_pairs)
+{
+    /* e(P, Q) = 1 if P or Q is zero */
+    std::vector<std::pair<alt_bn128_G1, alt_bn128_G2> > non_zero_pairs;
+    non_zero_pairs.reserve(pairs.size());
+    for (const auto &pair : pairs)
+    {
+        if (!pair.first.is_zero() && !pair.second.is_zero())
+        {
+            non_zero_pairs.emplace_back(pair);
+        }
+    }
+
+    const size_t n = non_zero_pairs.size();
+    const size_t num_slices =
+        (n >= min_parallel_pairs && n > 1) ? std::min(parallel_concurrency(), n) : 1;
+    if (num_slices <= 1)
+    {
+        return alt_bn128_pairs_miller_loop_slice(non_zero_pairs, 0, n);
+    }
+
+    std::vector<alt_bn128_Fq12> partial(num_slices);
+    parallel_for(num_slices, [&](const size_t slice) {
+        const size_t begin = n * slice / num_slices;
+        const size_t end = n * (slice + 1) / num_slices;
+        partial[slice] = alt_bn128_pairs_miller_loop_slice(non_zero_pairs, begin, end);
+    });
+
+    alt_bn128_Fq12 f = partial[0];
+    for (size_t slice = 1; slice < num_slices; ++slice)
+    {
+        f = f * partial[slice];
+    }
+    return f;
+}
+
+alt_bn128_GT alt_bn128_multi_pairing(const std::vector<std::pair<alt_bn128_G1, alt_bn128_G2> > &pairs,
+                                     const size_t min_parallel_pairs)
+{
+    enter_block("Call to alt_bn128_multi_pairing");
+    const alt_bn128_GT result =
+        alt_bn128_final_exponentiation(alt_bn128_pairs_miller_loop(pairs, min_parallel_pairs));
+    leave_block("Call to alt_bn128_multi_pairing");
+    return result;
+}
+
+bool alt_bn128_pairing_product_is_one(const std::vector<std::pair<alt_bn128_G1, alt_bn128_G2> > &pairs,
+                                      const size_t min_parallel_pairs)
+{
+    enter_block("Call to alt_bn128_pairing_product_is_one");
+    const bool result =
+        alt_bn128_final_exponentiation(alt_bn128_pairs_miller_loop(pairs, min_parallel_pairs)) == alt_bn128_GT::one();
+    leave_block("Call to alt_bn128_pairing_product_is_one");
+    return result;
+}
+
 alt_bn128_Fq12 alt_bn128_ate_pairing(const alt_bn128_G1& P, const alt_bn128_G2 &Q)
 {
     enter_block("Call to alt_bn128_ate_pairing");
@@ -518,6 +862,11 @@ alt_bn128_G2_precomp alt_bn128_precompute_G2(const alt_bn128_G2& Q)
     return alt_bn128_ate_precompute_G2(Q);
 }
 
+std::vector<alt_bn128_G2_precomp> alt_bn128_batch_precompute_G2(const std::vector<alt_bn128_G2> &Q)
+{
+    return alt_bn128_ate_batch_precompute_G2(Q);
+}
+
 alt_bn128_Fq12 alt_bn128_miller_loop(const alt_bn128_G1_precomp &prec_P,
                           const alt_bn128_G2_precomp &prec_Q)
 {
@@ -532,6 +881,12 @@ alt_bn128_Fq12 alt_bn128_double_miller_loop(const alt_bn128_G1_precomp &prec_P1,
     return alt_bn128_ate_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
 }
 
+alt_bn128_Fq12 alt_bn128_multi_miller_loop(const std::vector<alt_bn128_G1_precomp> &prec_P,
+                                           const std::vector<alt_bn128_G2_precomp> &prec_Q)
+{
+    return alt_bn128_ate_multi_miller_loop(prec_P, prec_Q);
+}
+
 alt_bn128_Fq12 alt_bn128_pairing(const alt_bn128_G1& P,
                       const alt_bn128_G2 &Q)
 {
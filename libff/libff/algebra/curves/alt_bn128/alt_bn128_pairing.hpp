@@ -7,6 +7,7 @@
 
 #ifndef ALT_BN128_PAIRING_HPP_
 #define ALT_BN128_PAIRING_HPP_
+#include <utility>
 #include <vector>
 
 #include <libff/algebra/curves/alt_bn128/alt_bn128_init.hpp>
@@ -15,6 +16,8 @@ namespace libff {
 
 /* final exponentiation */
 
+alt_bn128_Fq12 alt_bn128_final_exponentiation_first_chunk(const alt_bn128_Fq12 &elt);
+alt_bn128_Fq12 alt_bn128_final_exponentiation_last_chunk(const alt_bn128_Fq12 &elt);
 alt_bn128_GT alt_bn128_final_exponentiation(const alt_bn128_Fq12 &elt);
 
 /* ate pairing */
@@ -51,12 +54,31 @@ struct alt_bn128_ate_G2_precomp {
 alt_bn128_ate_G1_precomp alt_bn128_ate_precompute_G1(const alt_bn128_G1& P);
 alt_bn128_ate_G2_precomp alt_bn128_ate_precompute_G2(const alt_bn128_G2& Q);
 
+/**
+ * alt_bn128_ate_precompute_G2 for all of Q at once, with the doubling and
+ * addition steps in affine coordinates: each step shares one batched
+ * inversion between the points. The line coefficients differ from those of
+ * alt_bn128_ate_precompute_G2 by factors in F_q^2, which the final
+ * exponentiation removes. Zero points, and those that would divide by zero,
+ * are left to alt_bn128_ate_precompute_G2.
+ */
+std::vector<alt_bn128_ate_G2_precomp> alt_bn128_affine_ate_batch_precompute_G2(const std::vector<alt_bn128_G2> &Q);
+/* the batch size from which alt_bn128_ate_batch_precompute_G2 goes affine: about where the two
+   break even in the projective vs affine table of alt_bn128_pairing_profile, and a heuristic
+   rather than a tuned value, since the crossover moves with the machine */
+const std::size_t alt_bn128_affine_ate_min_points = 4;
+/* alt_bn128_ate_precompute_G2 of every point of Q, or its affine batch version for large batches */
+std::vector<alt_bn128_ate_G2_precomp> alt_bn128_ate_batch_precompute_G2(const std::vector<alt_bn128_G2> &Q);
+
 alt_bn128_Fq12 alt_bn128_ate_miller_loop(const alt_bn128_ate_G1_precomp &prec_P,
                               const alt_bn128_ate_G2_precomp &prec_Q);
 alt_bn128_Fq12 alt_bn128_ate_double_miller_loop(const alt_bn128_ate_G1_precomp &prec_P1,
                                      const alt_bn128_ate_G2_precomp &prec_Q1,
                                      const alt_bn128_ate_G1_precomp &prec_P2,
                                      const alt_bn128_ate_G2_precomp &prec_Q2);
+/* product of the Miller loops of (prec_P[i], prec_Q[i]), sharing the squarings */
+alt_bn128_Fq12 alt_bn128_ate_multi_miller_loop(const std::vector<alt_bn128_ate_G1_precomp> &prec_P,
+                                               const std::vector<alt_bn128_ate_G2_precomp> &prec_Q);
 
 alt_bn128_Fq12 alt_bn128_ate_pairing(const alt_bn128_G1& P,
                           const alt_bn128_G2 &Q);
@@ -71,6 +93,7 @@ typedef alt_bn128_ate_G2_precomp alt_bn128_G2_precomp;
 alt_bn128_G1_precomp alt_bn128_precompute_G1(const alt_bn128_G1& P);
 
 alt_bn128_G2_precomp alt_bn128_precompute_G2(const alt_bn128_G2& Q);
+std::vector<alt_bn128_G2_precomp> alt_bn128_batch_precompute_G2(const std::vector<alt_bn128_G2> &Q);
 
 alt_bn128_Fq12 alt_bn128_miller_loop(const alt_bn128_G1_precomp &prec_P,
                           const alt_bn128_G2_precomp &prec_Q);
@@ -80,6 +103,9 @@ alt_bn128_Fq12 alt_bn128_double_miller_loop(const alt_bn128_G1_precomp &prec_P1,
                                  const alt_bn128_G1_precomp &prec_P2,
                                  const alt_bn128_G2_precomp &prec_Q2);
 
+alt_bn128_Fq12 alt_bn128_multi_miller_loop(const std::vector<alt_bn128_G1_precomp> &prec_P,
+                                           const std::vector<alt_bn128_G2_precomp> &prec_Q);
+
 alt_bn128_Fq12 alt_bn128_pairing(const alt_bn128_G1& P,
                       const alt_bn128_G2 &Q);
 
@@ -89,5 +115,27 @@ alt_bn128_GT alt_bn128_reduced_pairing(const alt_bn128_G1 &P,
 alt_bn128_GT alt_bn128_affine_reduced_pairing(const alt_bn128_G1 &P,
                                     const alt_bn128_G2 &Q);
 
+/* the number of pairs from which the Miller loops below are split across the parallel executor */
+const std::size_t alt_bn128_parallel_pairing_min_pairs = 4;
+
+/**
+ * \prod_i e(pairs[i].first, pairs[i].second), with one final exponentiation
+ * for all the pairs. From min_parallel_pairs pairs on, the pairs are split
+ * into parallel_concurrency() slices whose Miller loops run as tasks of the
+ * parallel executor, and whose partial products are multiplied before the
+ * final exponentiation. Pairs with a zero point are skipped.
+ */
+alt_bn128_GT alt_bn128_multi_pairing(const std::vector<std::pair<alt_bn128_G1, alt_bn128_G2> > &pairs,
+                                     const std::size_t min_parallel_pairs = alt_bn128_parallel_pairing_min_pairs);
+
+/**
+ * Whether \prod_i e(pairs[i].first, pairs[i].second) is one, with the Miller
+ * loops sharing their squarings, split across the parallel executor as in
+ * alt_bn128_multi_pairing, and a single final exponentiation. Pairs with a
+ * zero point are skipped. Points must be in their subgroups.
+ */
+bool alt_bn128_pairing_product_is_one(const std::vector<std::pair<alt_bn128_G1, alt_bn128_G2> > &pairs,
+                                      const std::size_t min_parallel_pairs = alt_bn128_parallel_pairing_min_pairs);
+
 } // namespace libff
 #endif // ALT_BN128_PAIRING_HPP_
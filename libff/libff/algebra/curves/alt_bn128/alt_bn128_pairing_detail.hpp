@@ -0,0 +1,26 @@
+/** @file
+ *****************************************************************************
+ Internals of alt_bn128_pairing.cpp shared with its profiling, not part of
+ the pairing interface.
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef ALT_BN128_PAIRING_DETAIL_HPP_
+#define ALT_BN128_PAIRING_DETAIL_HPP_
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pairing.hpp>
+
+namespace libff {
+
+/* the projective steps of alt_bn128_ate_precompute_G2: each moves current and writes the line through it to c */
+void doubling_step_for_flipped_miller_loop(const alt_bn128_Fq two_inv,
+                                           alt_bn128_G2 &current,
+                                           alt_bn128_ate_ell_coeffs &c);
+void mixed_addition_step_for_flipped_miller_loop(const alt_bn128_G2 base,
+                                                 alt_bn128_G2 &current,
+                                                 alt_bn128_ate_ell_coeffs &c);
+
+} // namespace libff
+#endif // ALT_BN128_PAIRING_DETAIL_HPP_
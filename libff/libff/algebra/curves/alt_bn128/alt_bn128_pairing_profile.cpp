@@ -0,0 +1,401 @@
+/**
+ *****************************************************************************
+ Profiling of the alt_bn128 pairing. Each table changes one thing at a time:
+ - by value vs in place: the Miller loop and the final exponentiation last
+   chunk on alt_bn128_Fq12, written with value-returning operations against
+   the in-place ones;
+ - generic vs flat: the same in-place code on alt_bn128_Fq12 against the
+   library, which runs it on alt_bn128_flat_Fq12 (see alt_bn128_flat_fq12.hpp);
+ - binary vs NAF: the per-pair cost of driving the flat Miller loop by the
+   binary expansion of the loop count against its NAF;
+ - projective vs affine: the per-point cost of precomputing G2 one point at
+   a time against alt_bn128_affine_ate_batch_precompute_G2, by batch size.
+ The first two report running time and peak stack usage.
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <pthread.h>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_flat_fq12.hpp>
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pairing_detail.hpp>
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/common/profiling.hpp>
+
+using namespace libff;
+
+using std::size_t;
+
+/* Value-returning reference versions, as the pairing was written before the in-place API. */
+
+alt_bn128_Fq12 by_value_exp_by_neg_z(const alt_bn128_Fq12 &elt)
+{
+    alt_bn128_Fq12 result = elt.cyclotomic_exp(alt_bn128_final_exponent_z);
+    if (!alt_bn128_final_exponent_is_z_neg)
+    {
+        result = result.unitary_inverse();
+    }
+    return result;
+}
+
+alt_bn128_Fq12 by_value_final_exponentiation_last_chunk(const alt_bn128_Fq12 &elt)
+{
+    const alt_bn128_Fq12 A = by_value_exp_by_neg_z(elt);
+    const alt_bn128_Fq12 B = A.cyclotomic_squared();
+    const alt_bn128_Fq12 C = B.cyclotomic_squared();
+    const alt_bn128_Fq12 D = C * B;
+    const alt_bn128_Fq12 E = by_value_exp_by_neg_z(D);
+    const alt_bn128_Fq12 F = E.cyclotomic_squared();
+    const alt_bn128_Fq12 G = by_value_exp_by_neg_z(F);
+    const alt_bn128_Fq12 H = D.unitary_inverse();
+    const alt_bn128_Fq12 I = G.unitary_inverse();
+    const alt_bn128_Fq12 J = I * E;
+    const alt_bn128_Fq12 K = J * H;
+    const alt_bn128_Fq12 L = K * B;
+    const alt_bn128_Fq12 M = K * E;
+    const alt_bn128_Fq12 N = M * elt;
+    const alt_bn128_Fq12 O = L.Frobenius_map(1);
+    const alt_bn128_Fq12 P = O * N;
+    const alt_bn128_Fq12 Q = K.Frobenius_map(2);
+    const alt_bn128_Fq12 R = Q * P;
+    const alt_bn128_Fq12 S = elt.unitary_inverse();
+    const alt_bn128_Fq12 T = S * L;
+    const alt_bn128_Fq12 U = T.Frobenius_map(3);
+    const alt_bn128_Fq12 V = U * R;
+
+    return V;
+}
+
+alt_bn128_Fq12 by_value_miller_loop(const alt_bn128_ate_G1_precomp &prec_P,
+                                    const alt_bn128_ate_G2_precomp &prec_Q)
+{
+    alt_bn128_Fq12 f = alt_bn128_Fq12::one();
+
+    size_t idx = 0;
+
+    for (long i = alt_bn128_ate_loop_count_naf_size - 2; i >= 0; --i)
+    {
+        const signed char digit = alt_bn128_ate_loop_count_naf[i];
+
+        alt_bn128_ate_ell_coeffs c = prec_Q.coeffs[idx++];
+        f = f.squared();
+        f = f.mul_by_024(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
+
+        if (digit != 0)
+        {
+            c = prec_Q.coeffs[idx++];
+            f = f.mul_by_024(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
+        }
+    }
+
+    for (size_t j = 0; j < 2; ++j)
+    {
+        const alt_bn128_ate_ell_coeffs &c = prec_Q.coeffs[idx++];
+        f = f.mul_by_024(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
+    }
+
+    return f;
+}
+
+/* In-place reference versions, as the pairing was written before alt_bn128_flat_Fq12. */
+
+alt_bn128_Fq12 in_place_exp_by_neg_z(const alt_bn128_Fq12 &elt)
+{
+    alt_bn128_Fq12 result = elt.cyclotomic_exp(alt_bn128_final_exponent_z);
+    if (!alt_bn128_final_exponent_is_z_neg)
+    {
+        result.unitary_inverse_inplace();
+    }
+    return result;
+}
+
+alt_bn128_Fq12 in_place_final_exponentiation_last_chunk(const alt_bn128_Fq12 &elt)
+{
+    /* the chain of by_value_final_exponentiation_last_chunk, keeping four live values */
+    alt_bn128_Fq12 B = in_place_exp_by_neg_z(elt);     // A
+    B.cyclotomic_square_inplace();                     // B
+    alt_bn128_Fq12 D = B;
+    D.cyclotomic_square_inplace();                     // C
+    D.mul_into(B, D);                                  // D = C * B
+    alt_bn128_Fq12 E = in_place_exp_by_neg_z(D);       // E
+    alt_bn128_Fq12 K = E;
+    K.cyclotomic_square_inplace();                     // F
+    K = in_place_exp_by_neg_z(K);                      // G
+    K.unitary_inverse_inplace();                       // I = conj(G)
+    K.mul_into(E, K);                                  // J = I * E
+    D.unitary_inverse_inplace();                       // H = conj(D)
+    K.mul_into(D, K);                                  // K = J * H
+    B.mul_into(K, B);                                  // L = K * B
+    E.mul_into(K, E);                                  // M = K * E
+    E.mul_into(elt, E);                                // N = M * elt
+    D = B;
+    D.frobenius_inplace(1);                            // O = L.Frobenius_map(1)
+    D.mul_into(E, D);                                  // P = O * N
+    K.frobenius_inplace(2);                            // Q = K.Frobenius_map(2)
+    K.mul_into(D, K);                                  // R = Q * P
+    alt_bn128_Fq12 U = elt;
+    U.unitary_inverse_inplace();                       // S = conj(elt)
+    U.mul_into(B, U);                                  // T = S * L
+    U.frobenius_inplace(3);                            // U = T.Frobenius_map(3)
+    U.mul_into(K, U);                                  // V = U * R
+    return U;
+}
+
+alt_bn128_Fq12 in_place_miller_loop(const alt_bn128_ate_G1_precomp &prec_P,
+                                    const alt_bn128_ate_G2_precomp &prec_Q)
+{
+    alt_bn128_Fq12 f = alt_bn128_Fq12::one();
+
+    size_t idx = 0;
+
+    for (long i = alt_bn128_ate_loop_count_naf_size - 2; i >= 0; --i)
+    {
+        const signed char digit = alt_bn128_ate_loop_count_naf[i];
+
+        const alt_bn128_ate_ell_coeffs &c = prec_Q.coeffs[idx++];
+        f.square_inplace();
+        f.mul_by_024_inplace(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
+
+        if (digit != 0)
+        {
+            const alt_bn128_ate_ell_coeffs &c = prec_Q.coeffs[idx++];
+            f.mul_by_024_inplace(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
+        }
+    }
+
+    for (size_t j = 0; j < 2; ++j)
+    {
+        const alt_bn128_ate_ell_coeffs &c = prec_Q.coeffs[idx++];
+        f.mul_by_024_inplace(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
+    }
+
+    return f;
+}
+
+/* The Miller loop over the bits of alt_bn128_ate_loop_count, as it was before the NAF, on flat Fq12 as the library. */
+
+alt_bn128_ate_G2_precomp binary_precompute_G2(const alt_bn128_G2 &Q)
+{
+    alt_bn128_G2 Qcopy(Q);
+    Qcopy.to_affine_coordinates();
+    const alt_bn128_Fq two_inv = alt_bn128_Fq("2").inverse();
+
+    alt_bn128_ate_G2_precomp result;
+    result.QX = Qcopy.X;
+    result.QY = Qcopy.Y;
+
+    alt_bn128_G2 R = Qcopy;
+    alt_bn128_ate_ell_coeffs c;
+    const bigint<alt_bn128_q_limbs> &loop_count = alt_bn128_ate_loop_count;
+    for (long i = loop_count.num_bits() - 2; i >= 0; --i)
+    {
+        doubling_step_for_flipped_miller_loop(two_inv, R, c);
+        result.coeffs.push_back(c);
+        if (loop_count.test_bit(i))
+        {
+            mixed_addition_step_for_flipped_miller_loop(Qcopy, R, c);
+            result.coeffs.push_back(c);
+        }
+    }
+
+    const alt_bn128_G2 Q1 = Qcopy.mul_by_q();
+    alt_bn128_G2 Q2 = Q1.mul_by_q();
+    Q2.Y = -Q2.Y;
+    mixed_addition_step_for_flipped_miller_loop(Q1, R, c);
+    result.coeffs.push_back(c);
+    mixed_addition_step_for_flipped_miller_loop(Q2, R, c);
+    result.coeffs.push_back(c);
+
+    return result;
+}
+
+alt_bn128_Fq12 binary_miller_loop(const alt_bn128_ate_G1_precomp &prec_P,
+                                  const alt_bn128_ate_G2_precomp &prec_Q)
+{
+    alt_bn128_flat_Fq12 f = alt_bn128_flat_Fq12::one();
+    size_t idx = 0;
+
+    const bigint<alt_bn128_q_limbs> &loop_count = alt_bn128_ate_loop_count;
+    for (long i = loop_count.num_bits() - 2; i >= 0; --i)
+    {
+        const alt_bn128_ate_ell_coeffs &c = prec_Q.coeffs[idx++];
+        f.square_inplace();
+        f.mul_by_024_inplace(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
+        if (loop_count.test_bit(i))
+        {
+            const alt_bn128_ate_ell_coeffs &c = prec_Q.coeffs[idx++];
+            f.mul_by_024_inplace(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
+        }
+    }
+
+    for (size_t j = 0; j < 2; ++j)
+    {
+        const alt_bn128_ate_ell_coeffs &c = prec_Q.coeffs[idx++];
+        f.mul_by_024_inplace(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
+    }
+
+    return f.to_Fq12();
+}
+
+/* Peak stack usage, measured by running the function on a painted stack of a fresh thread. */
+
+static const size_t probe_stack_size = 1 << 20;
+static const unsigned char probe_stack_paint = 0xA5;
+
+void *run_function(void *arg)
+{
+    (*static_cast<std::function<void()>*>(arg))();
+    return nullptr;
+}
+
+size_t peak_stack_usage(std::function<void()> f)
+{
+    std::vector<unsigned char> stack(probe_stack_size, probe_stack_paint);
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack.data(), stack.size());
+
+    pthread_t thread;
+    if (pthread_create(&thread, &attr, run_function, &f) != 0)
+    {
+        pthread_attr_destroy(&attr);
+        return 0;
+    }
+    pthread_join(thread, nullptr);
+    pthread_attr_destroy(&attr);
+
+    /* the stack grows downwards, so untouched bytes are at the start of the buffer */
+    size_t untouched = 0;
+    while (untouched < stack.size() && stack[untouched] == probe_stack_paint)
+    {
+        ++untouched;
+    }
+    return stack.size() - untouched;
+}
+
+long long time_per_call(std::function<void()> f, const size_t reps)
+{
+    const long long start_time = get_nsec_time();
+    for (size_t i = 0; i < reps; ++i)
+    {
+        f();
+    }
+    return (get_nsec_time() - start_time) / reps;
+}
+
+void print_header(const char *before, const char *after)
+{
+    const std::string before_s(before), after_s(after);
+    printf("%-28s %12s %12s %12s %12s\n", "",
+           (before_s + " ns").c_str(), (after_s + " ns").c_str(),
+           (before_s + " B").c_str(), (after_s + " B").c_str());
+}
+
+void print_row(const char *name, std::function<void()> before, std::function<void()> after, const size_t reps)
+{
+    printf("%-28s %12lld %12lld %12zu %12zu\n", name,
+           time_per_call(before, reps), time_per_call(after, reps),
+           peak_stack_usage(before), peak_stack_usage(after));
+}
+
+int main()
+{
+    inhibit_profiling_info = true;
+
+    alt_bn128_pp::init_public_params();
+
+    const alt_bn128_G1 P = alt_bn128_G1::random_element();
+    const alt_bn128_G2 Q = alt_bn128_G2::random_element();
+    const alt_bn128_ate_G1_precomp prec_P = alt_bn128_ate_precompute_G1(P);
+    const alt_bn128_ate_G2_precomp prec_Q = alt_bn128_ate_precompute_G2(Q);
+    const alt_bn128_Fq12 f = alt_bn128_ate_miller_loop(prec_P, prec_Q);
+    const alt_bn128_Fq12 g = alt_bn128_final_exponentiation_first_chunk(f);
+
+    const alt_bn128_Fq12 h = alt_bn128_final_exponentiation_last_chunk(g);
+
+    if (by_value_miller_loop(prec_P, prec_Q) != f ||
+        in_place_miller_loop(prec_P, prec_Q) != f ||
+        by_value_final_exponentiation_last_chunk(g) != h ||
+        in_place_final_exponentiation_last_chunk(g) != h)
+    {
+        fprintf(stderr, "Answers NOT MATCHING (reference != library)\n");
+        return 1;
+    }
+
+    alt_bn128_Fq12 sink;
+    print_header("by value", "in place");
+    print_row("miller loop",
+              [&]() { sink = by_value_miller_loop(prec_P, prec_Q); },
+              [&]() { sink = in_place_miller_loop(prec_P, prec_Q); },
+              50);
+    print_row("final exp last chunk",
+              [&]() { sink = by_value_final_exponentiation_last_chunk(g); },
+              [&]() { sink = in_place_final_exponentiation_last_chunk(g); },
+              50);
+
+    printf("\n");
+    print_header("generic", "flat");
+    print_row("miller loop",
+              [&]() { sink = in_place_miller_loop(prec_P, prec_Q); },
+              [&]() { sink = alt_bn128_ate_miller_loop(prec_P, prec_Q); },
+              50);
+    print_row("final exp last chunk",
+              [&]() { sink = in_place_final_exponentiation_last_chunk(g); },
+              [&]() { sink = alt_bn128_final_exponentiation_last_chunk(g); },
+              50);
+
+    const alt_bn128_ate_G2_precomp binary_prec_Q = binary_precompute_G2(Q);
+    if (alt_bn128_final_exponentiation(binary_miller_loop(prec_P, binary_prec_Q)) !=
+        alt_bn128_final_exponentiation(f))
+    {
+        fprintf(stderr, "Answers NOT MATCHING (binary != NAF loop count)\n");
+        return 1;
+    }
+
+    alt_bn128_ate_G2_precomp sink_Q;
+    printf("\n%-28s %12s %12s\n", "per pair", "binary ns", "NAF ns");
+    printf("%-28s %12zu %12zu\n", "line coefficients",
+           binary_prec_Q.coeffs.size(), prec_Q.coeffs.size());
+    printf("%-28s %12lld %12lld\n", "precompute G2",
+           time_per_call([&]() { sink_Q = binary_precompute_G2(Q); }, 50),
+           time_per_call([&]() { sink_Q = alt_bn128_ate_precompute_G2(Q); }, 50));
+    printf("%-28s %12lld %12lld\n", "miller loop",
+           time_per_call([&]() { sink = binary_miller_loop(prec_P, binary_prec_Q); }, 50),
+           time_per_call([&]() { sink = alt_bn128_ate_miller_loop(prec_P, prec_Q); }, 50));
+
+    /* the crossover behind alt_bn128_affine_ate_min_points */
+    std::vector<alt_bn128_ate_G2_precomp> sink_Qs;
+    printf("\n%-28s %12s %12s\n", "precompute G2 per point", "proj ns", "affine ns");
+    for (const size_t n : { 1, 2, 3, 4, 5, 6, 8, 16, 64 })
+    {
+        std::vector<alt_bn128_G2> Qs;
+        for (size_t i = 0; i < n; ++i)
+        {
+            Qs.emplace_back(alt_bn128_G2::random_element());
+        }
+
+        const size_t reps = 256 / n + 1;
+        const long long projective_time = time_per_call([&]() {
+            sink_Qs.clear();
+            for (const alt_bn128_G2 &Q_i : Qs)
+            {
+                sink_Qs.emplace_back(alt_bn128_ate_precompute_G2(Q_i));
+            }
+        }, reps);
+        const long long affine_time = time_per_call([&]() {
+            sink_Qs = alt_bn128_affine_ate_batch_precompute_G2(Qs);
+        }, reps);
+        printf("%-28s %12lld %12lld\n", ("batch of " + std::to_string(n)).c_str(),
+               projective_time / (long long) n, affine_time / (long long) n);
+    }
+
+    return 0;
+}
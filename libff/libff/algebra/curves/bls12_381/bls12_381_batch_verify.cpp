@@ -0,0 +1,296 @@
+/** @file
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <cstdint>
+#include <cstring>
+
+#include <sodium/crypto_hash_sha512.h>
+#include <sodium/randombytes.h>
+
+#include <libff/algebra/curves/bls12_381/bls12_381_batch_verify.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_pairing.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include <libff/common/profiling.hpp>
+
+namespace libff {
+
+using std::size_t;
+
+/* The limbs of a 128-bit scalar */
+static const mp_size_t batch_scalar_limbs = 128 / GMP_NUMB_BITS;
+
+/* The bytes of the random seed mixed into the transcript */
+static const size_t batch_seed_bytes = 32;
+
+static const char batch_verify_domain_tag[] = "libff-bls12_381-batch-verify-v1";
+
+/* The transcript the scalars are derived from, see bls12_381_batch_verify.hpp */
+struct batch_transcript {
+    unsigned char hash[crypto_hash_sha512_BYTES];
+};
+
+/* x as 8 little-endian bytes */
+static void hash_update_u64(crypto_hash_sha512_state &sha512, const uint64_t x)
+{
+    unsigned char bytes[8];
+    for (size_t i = 0; i < sizeof(bytes); ++i)
+    {
+        bytes[i] = (unsigned char)(x >> (8 * i));
+    }
+    crypto_hash_sha512_update(&sha512, bytes, sizeof(bytes));
+}
+
+/* the canonical value of x, as little-endian bytes */
+static void hash_update_Fq(crypto_hash_sha512_state &sha512, const bls12_381_Fq &x)
+{
+    const bigint<bls12_381_q_limbs> x_int = x.as_bigint();
+    unsigned char bytes[sizeof(x_int.data)];
+    for (size_t i = 0; i < sizeof(bytes); ++i)
+    {
+        bytes[i] = (unsigned char)(x_int.data[i / sizeof(mp_limb_t)] >> (8 * (i % sizeof(mp_limb_t))));
+    }
+    crypto_hash_sha512_update(&sha512, bytes, sizeof(bytes));
+}
+
+/* one byte for whether P is zero, then its affine coordinates */
+static void hash_update_G1(crypto_hash_sha512_state &sha512, const bls12_381_G1 &P)
+{
+    const unsigned char is_zero = P.is_zero();
+    crypto_hash_sha512_update(&sha512, &is_zero, 1);
+    if (!is_zero)
+    {
+        bls12_381_G1 affine_P(P);
+        affine_P.to_affine_coordinates();
+        hash_update_Fq(sha512, affine_P.X);
+        hash_update_Fq(sha512, affine_P.Y);
+    }
+}
+
+static void hash_update_G2(crypto_hash_sha512_state &sha512, const bls12_381_G2 &Q)
+{
+    const unsigned char is_zero = Q.is_zero();
+    crypto_hash_sha512_update(&sha512, &is_zero, 1);
+    if (!is_zero)
+    {
+        bls12_381_G2 affine_Q(Q);
+        affine_Q.to_affine_coordinates();
+        hash_update_Fq(sha512, affine_Q.X.c0);
+        hash_update_Fq(sha512, affine_Q.X.c1);
+        hash_update_Fq(sha512, affine_Q.Y.c0);
+        hash_update_Fq(sha512, affine_Q.Y.c1);
+    }
+}
+
+/* SHA512(domain tag || seed || n || (pk_i || H(m_i) || sig_i) for all i), with a fresh random seed */
+static batch_transcript make_batch_transcript(const std::vector<bls12_381_signed_message> &batch)
+{
+    unsigned char seed[batch_seed_bytes];
+    randombytes_buf(seed, sizeof(seed));
+
+    crypto_hash_sha512_state sha512;
+    crypto_hash_sha512_init(&sha512);
+    crypto_hash_sha512_update(&sha512, (const unsigned char*)batch_verify_domain_tag, sizeof(batch_verify_domain_tag) - 1);
+    crypto_hash_sha512_update(&sha512, seed, sizeof(seed));
+    hash_update_u64(sha512, batch.size());
+    for (const bls12_381_signed_message &msg : batch)
+    {
+        hash_update_G1(sha512, msg.public_key);
+        hash_update_G2(sha512, msg.message_hash);
+        hash_update_G2(sha512, msg.signature);
+    }
+
+    batch_transcript transcript;
+    crypto_hash_sha512_final(&sha512, transcript.hash);
+    return transcript;
+}
+
+/* The idx-th combination scalar: SHA512(transcript || idx) truncated to 128 bits. */
+static bigint<batch_scalar_limbs> batch_scalar(const batch_transcript &transcript, const uint64_t idx)
+{
+    unsigned char hash[crypto_hash_sha512_BYTES];
+    crypto_hash_sha512_state sha512;
+    crypto_hash_sha512_init(&sha512);
+    crypto_hash_sha512_update(&sha512, transcript.hash, sizeof(transcript.hash));
+    hash_update_u64(sha512, idx);
+    crypto_hash_sha512_final(&sha512, hash);
+
+    bigint<batch_scalar_limbs> r;
+    std::memcpy(r.data, hash, sizeof(r.data));
+
+    /* a zero scalar would drop the signature from the check */
+    if (r.is_zero())
+    {
+        r.data[0] = 1;
+    }
+    return r;
+}
+
+bool bls12_381_verify_signature(const bls12_381_signed_message &msg)
+{
+    if (msg.public_key.is_zero())
+    {
+        return false;
+    }
+
+    /* e(pk, H(m)) * e(-g1, sig) == 1 */
+    const bls12_381_Fq12 f = bls12_381_double_miller_loop(
+        bls12_381_precompute_G1(msg.public_key), bls12_381_precompute_G2(msg.message_hash),
+        bls12_381_precompute_G1(-bls12_381_G1::one()), bls12_381_precompute_G2(msg.signature));
+    return bls12_381_final_exponentiation(f) == bls12_381_GT::one();
+}
+
+/* The combined check over batch[begin, end), using scalars idx, idx+1, ... */
+static bool batch_verify_range(const std::vector<bls12_381_signed_message> &batch,
+                               const size_t begin, const size_t end,
+                               const batch_transcript &transcript, uint64_t &idx)
+{
+    if (end - begin == 1)
+    {
+        return bls12_381_verify_signature(batch[begin]);
+    }
+
+    enter_block("Call to bls12_381_batch_verify_range");
+
+    std::vector<bls12_381_G2> signatures;
+    std::vector<bls12_381_Fr> scalars;
+    std::vector<bls12_381_G1_precomp> prec_P;
+    std::vector<bls12_381_G2> Q;
+    signatures.reserve(end - begin);
+    scalars.reserve(end - begin);
+    prec_P.reserve(end - begin + 1);
+    Q.reserve(end - begin + 1);
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        const bigint<batch_scalar_limbs> r = batch_scalar(transcript, idx++);
+        bigint<bls12_381_r_limbs> r_wide;
+        std::memcpy(r_wide.data, r.data, sizeof(r.data));
+
+        signatures.emplace_back(batch[i].signature);
+        scalars.emplace_back(bls12_381_Fr(r_wide));
+        prec_P.emplace_back(bls12_381_precompute_G1(r * batch[i].public_key));
+        Q.emplace_back(batch[i].message_hash);
+    }
+
+    const bls12_381_G2 signature = multi_exp<bls12_381_G2, bls12_381_Fr, multi_exp_method_BDLO12>(
+        signatures.begin(), signatures.end(), scalars.begin(), scalars.end(), 1);
+    prec_P.emplace_back(bls12_381_precompute_G1(-bls12_381_G1::one()));
+    Q.emplace_back(signature);
+    const std::vector<bls12_381_G2_precomp> prec_Q = bls12_381_batch_precompute_G2(Q);
+
+    const bls12_381_Fq12 f = bls12_381_multi_miller_loop(prec_P, prec_Q);
+    const bool valid = (bls12_381_final_exponentiation(f) == bls12_381_GT::one());
+
+    leave_block("Call to bls12_381_batch_verify_range");
+
+    return valid;
+}
+
+static bool has_zero_public_key(const std::vector<bls12_381_signed_message> &batch)
+{
+    for (const bls12_381_signed_message &msg : batch)
+    {
+        if (msg.public_key.is_zero())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool bls12_381_batch_verify_signatures(const std::vector<bls12_381_signed_message> &batch)
+{
+    if (batch.empty())
+    {
+        return true;
+    }
+    if (has_zero_public_key(batch))
+    {
+        return false;
+    }
+
+    const batch_transcript transcript = make_batch_transcript(batch);
+    uint64_t idx = 0;
+    return batch_verify_range(batch, 0, batch.size(), transcript, idx);
+}
+
+/* Appends the invalid indices in batch[begin, end) to invalid. If known_invalid
+   is set the range is already known to fail, so its own check is skipped. */
+static void find_invalid_range(const std::vector<bls12_381_signed_message> &batch,
+                               const size_t begin, const size_t end, const bool known_invalid,
+                               const batch_transcript &transcript, uint64_t &idx,
+                               std::vector<size_t> &invalid)
+{
+    if (!known_invalid && batch_verify_range(batch, begin, end, transcript, idx))
+    {
+        return;
+    }
+    if (end - begin == 1)
+    {
+        invalid.emplace_back(begin);
+        return;
+    }
+
+    /* if the left half passes, the failure is in the right half */
+    const size_t mid = begin + (end - begin) / 2;
+    const size_t num_invalid = invalid.size();
+    find_invalid_range(batch, begin, mid, false, transcript, idx, invalid);
+    find_invalid_range(batch, mid, end, invalid.size() == num_invalid, transcript, idx, invalid);
+}
+
+std::vector<size_t> bls12_381_find_invalid_signatures(const std::vector<bls12_381_signed_message> &batch)
+{
+    std::vector<size_t> invalid;
+    if (batch.empty())
+    {
+        return invalid;
+    }
+
+    /* public keys at infinity are set aside, and the rest of the batch bisected */
+    std::vector<bls12_381_signed_message> rest;
+    std::vector<size_t> rest_idx;
+    rest.reserve(batch.size());
+    rest_idx.reserve(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        if (batch[i].public_key.is_zero())
+        {
+            invalid.emplace_back(i);
+        }
+        else
+        {
+            rest.emplace_back(batch[i]);
+            rest_idx.emplace_back(i);
+        }
+    }
+    if (rest.empty())
+    {
+        return invalid;
+    }
+
+    std::vector<size_t> rest_invalid;
+    const batch_transcript transcript = make_batch_transcript(rest);
+    uint64_t idx = 0;
+    find_invalid_range(rest, 0, rest.size(), false, transcript, idx, rest_invalid);
+
+    /* merge the two sorted lists of indices */
+    std::vector<size_t> result;
+    result.reserve(invalid.size() + rest_invalid.size());
+    size_t a = 0;
+    for (const size_t i : rest_invalid)
+    {
+        while (a < invalid.size() && invalid[a] < rest_idx[i])
+        {
+            result.emplace_back(invalid[a++]);
+        }
+        result.emplace_back(rest_idx[i]);
+    }
+    result.insert(result.end(), invalid.begin() + a, invalid.end());
+    return result;
+}
+
+} // namespace libff
@@ -0,0 +1,54 @@
+/** @file
+ *****************************************************************************
+ Batch verification of BLS signatures over BLS12-381, with public keys in G1
+ and signatures and message hashes in G2.
+
+ A batch of n checks e(pk_i, H(m_i)) == e(g1, sig_i) is combined, with random
+ 128-bit scalars r_i, into the single check
+
+     e(-g1, \sum_i r_i sig_i) * \prod_i e(r_i pk_i, H(m_i)) == 1,
+
+ which costs one multi-scalar multiplication over the signatures, one
+ multi-Miller loop over n+1 pairs and one final exponentiation.
+
+ The scalars are SHA512(transcript || idx) truncated to 128 bits, where the
+ transcript hashes a domain tag, a fresh 256-bit seed from the system random
+ generator and the whole batch, and idx is a 64-bit little-endian counter.
+ With SHA512 modeled as a random function, a batch with an invalid signature
+ passes the combined check with probability about 2^-128, however the batch
+ was chosen; the seed is never exposed to the caller.
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef BLS12_381_BATCH_VERIFY_HPP_
+#define BLS12_381_BATCH_VERIFY_HPP_
+#include <vector>
+
+#include <libff/algebra/curves/bls12_381/bls12_381_g1.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_g2.hpp>
+
+namespace libff {
+
+/* Points are assumed to be in their prime-order subgroups (see
+   is_in_safe_subgroup); a public key at infinity never verifies. */
+struct bls12_381_signed_message {
+    bls12_381_G1 public_key;
+    bls12_381_G2 message_hash;
+    bls12_381_G2 signature;
+};
+
+bool bls12_381_verify_signature(const bls12_381_signed_message &msg);
+
+/* true iff every signature in the batch is valid */
+bool bls12_381_batch_verify_signatures(const std::vector<bls12_381_signed_message> &batch);
+
+/* Indices, in increasing order, of the invalid signatures in the batch: the
+   combined check is bisected until every failing half is a single signature. */
+std::vector<std::size_t> bls12_381_find_invalid_signatures(const std::vector<bls12_381_signed_message> &batch);
+
+} // namespace libff
+
+#endif // BLS12_381_BATCH_VERIFY_HPP_
@@ -311,6 +311,12 @@ bls12_381_G1 bls12_381_G1::mul_by_cofactor() const
     return bls12_381_G1::h * (*this);
 }
 
+bls12_381_G1 bls12_381_G1::endomorphism() const
+{
+    // (x, y) -> (beta x, y); in Jacobian coordinates only X is scaled
+    return bls12_381_G1(bls12_381_g1_endomorphism_beta * this->X, this->Y, this->Z);
+}
+
 bool bls12_381_G1::is_well_formed() const
 {
     if (this->is_zero())
@@ -333,6 +339,15 @@ bool bls12_381_G1::is_well_formed() const
     return (Y2 == X3 + bls12_381_coeff_b * Z6);
 }
 
+bool bls12_381_G1::is_in_safe_subgroup() const
+{
+    /* Scott --- A note on group membership tests for G1, G2 and GT on BLS
+       pairing-friendly curves (ePrint 2021/1130): P is in G1 iff phi(P) = [-z^2] P.
+       Two multiplications by the 64-bit z instead of one by the 255-bit r. */
+    const bls12_381_G1 zP = bls12_381_final_exponent_z * (*this);
+    return this->endomorphism() == -(bls12_381_final_exponent_z * zP);
+}
+
 bls12_381_G1 bls12_381_G1::zero()
 {
     return G1_zero;
@@ -445,18 +460,21 @@ std::istream& operator>>(std::istream& in, std::vector<bls12_381_G1> &v)
 
 void bls12_381_G1::batch_to_special_all_non_zeros(std::vector<bls12_381_G1> &vec)
 {
-    std::vector<bls12_381_Fq> Z_vec;
-    Z_vec.reserve(vec.size());
+    batch_to_special_all_non_zeros(vec.data(), vec.size());
+}
 
-    for (auto &el: vec)
+void bls12_381_G1::batch_to_special_all_non_zeros(bls12_381_G1 *vec, const size_t count)
+{
+    std::vector<bls12_381_Fq> Z_vec(count), prod(count);
+    for (size_t i = 0; i < count; ++i)
     {
-        Z_vec.emplace_back(el.Z);
+        Z_vec[i] = vec[i].Z;
     }
-    batch_invert<bls12_381_Fq>(Z_vec);
+    batch_invert<bls12_381_Fq>(Z_vec.data(), prod.data(), count);
 
     const bls12_381_Fq one = bls12_381_Fq::one();
 
-    for (size_t i = 0; i < vec.size(); ++i)
+    for (size_t i = 0; i < count; ++i)
     {
         bls12_381_Fq Z2 = Z_vec[i].squared();
         bls12_381_Fq Z3 = Z_vec[i] * Z2;
@@ -467,4 +485,30 @@ void bls12_381_G1::batch_to_special_all_non_zeros(std::vector<bls12_381_G1> &vec
     }
 }
 
+template<>
+void batch_to_special_table<bls12_381_G1>(bls12_381_G1 *table, const size_t count)
+{
+    const size_t max_count = size_t(1) << (wnaf_max_window - 1);
+    assert(count <= max_count);
+
+    bls12_381_Fq Z_inv[max_count], prod[max_count];
+    for (size_t i = 0; i < count; ++i)
+    {
+        Z_inv[i] = table[i].Z;
+    }
+    batch_invert<bls12_381_Fq>(Z_inv, prod, count);
+
+    const bls12_381_Fq one = bls12_381_Fq::one();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        bls12_381_Fq Z2 = Z_inv[i].squared();
+        bls12_381_Fq Z3 = Z_inv[i] * Z2;
+
+        table[i].X = table[i].X * Z2;
+        table[i].Y = table[i].Y * Z3;
+        table[i].Z = one;
+    }
+}
+
 } // namespace libff
@@ -62,8 +62,10 @@ public:
     bls12_381_G1 mixed_add(const bls12_381_G1 &other) const;
     bls12_381_G1 dbl() const;
     bls12_381_G1 mul_by_cofactor() const;
+    bls12_381_G1 endomorphism() const;
 
     bool is_well_formed() const;
+    bool is_in_safe_subgroup() const;
 
     static bls12_381_G1 zero();
     static bls12_381_G1 one();
@@ -77,8 +79,13 @@ public:
     friend std::istream& operator>>(std::istream &in, bls12_381_G1 &g);
 
     static void batch_to_special_all_non_zeros(std::vector<bls12_381_G1> &vec);
+    static void batch_to_special_all_non_zeros(bls12_381_G1 *vec, const std::size_t count);
 };
 
+/* without heap allocations, for the wNAF tables of scalar multiplication */
+template<>
+void batch_to_special_table<bls12_381_G1>(bls12_381_G1 *table, const std::size_t count);
+
 template<mp_size_t m>
 bls12_381_G1 operator*(const bigint<m> &lhs, const bls12_381_G1 &rhs)
 {
@@ -325,6 +325,24 @@ bls12_381_G2 bls12_381_G2::mul_by_cofactor() const
     return bls12_381_G2::h * (*this);
 }
 
+bls12_381_G2 bls12_381_G2::clear_cofactor() const
+{
+    /* Budroni--Pintore, Efficient hash maps to G2 on BLS curves (ePrint
+       2017/419): [h_eff] P = [z^2 - z - 1] P + [z - 1] psi(P) + psi^2(2 P),
+       evaluated as in RFC 9380, G.3 with two multiplications by z. */
+    const auto mul_by_z = [](const bls12_381_G2 &P) {
+        const bls12_381_G2 zP = bls12_381_final_exponent_z * P;
+        return bls12_381_final_exponent_is_z_neg ? -zP : zP;
+    };
+
+    const bls12_381_G2 t1 = mul_by_z(*this);
+    bls12_381_G2 t2 = this->mul_by_q();
+    bls12_381_G2 t3 = this->dbl().mul_by_q().mul_by_q();
+    t3 = t3 - t2;
+    t2 = mul_by_z(t1 + t2);
+    return t3 + t2 - t1 - (*this);
+}
+
 bool bls12_381_G2::is_well_formed() const
 {
     if (this->is_zero())
@@ -351,6 +369,15 @@ bool bls12_381_G2::is_well_formed() const
     return (Y2 == X3 + bls12_381_twist_coeff_b * Z6);
 }
 
+bool bls12_381_G2::is_in_safe_subgroup() const
+{
+    /* Scott --- A note on group membership tests for G1, G2 and GT on BLS
+       pairing-friendly curves (ePrint 2021/1130): P is in G2 iff psi(P) = [z] P,
+       where psi is the untwist-Frobenius-twist endomorphism (mul_by_q). */
+    const bls12_381_G2 zP = bls12_381_final_exponent_z * (*this);
+    return this->mul_by_q() == (bls12_381_final_exponent_is_z_neg ? -zP : zP);
+}
+
 bls12_381_G2 bls12_381_G2::zero()
 {
     return G2_zero;
@@ -430,18 +457,21 @@ std::istream& operator>>(std::istream &in, bls12_381_G2 &g)
 
 void bls12_381_G2::batch_to_special_all_non_zeros(std::vector<bls12_381_G2> &vec)
 {
-    std::vector<bls12_381_Fq2> Z_vec;
-    Z_vec.reserve(vec.size());
+    batch_to_special_all_non_zeros(vec.data(), vec.size());
+}
 
-    for (auto &el: vec)
+void bls12_381_G2::batch_to_special_all_non_zeros(bls12_381_G2 *vec, const size_t count)
+{
+    std::vector<bls12_381_Fq2> Z_vec(count), prod(count);
+    for (size_t i = 0; i < count; ++i)
     {
-        Z_vec.emplace_back(el.Z);
+        Z_vec[i] = vec[i].Z;
     }
-    batch_invert<bls12_381_Fq2>(Z_vec);
+    batch_invert<bls12_381_Fq2>(Z_vec.data(), prod.data(), count);
 
     const bls12_381_Fq2 one = bls12_381_Fq2::one();
 
-    for (size_t i = 0; i < vec.size(); ++i)
+    for (size_t i = 0; i < count; ++i)
     {
         bls12_381_Fq2 Z2 = Z_vec[i].squared();
         bls12_381_Fq2 Z3 = Z_vec[i] * Z2;
@@ -452,4 +482,30 @@ void bls12_381_G2::batch_to_special_all_non_zeros(std::vector<bls12_381_G2> &vec
     }
 }
 
+template<>
+void batch_to_special_table<bls12_381_G2>(bls12_381_G2 *table, const size_t count)
+{
+    const size_t max_count = size_t(1) << (wnaf_max_window - 1);
+    assert(count <= max_count);
+
+    bls12_381_Fq2 Z_inv[max_count], prod[max_count];
+    for (size_t i = 0; i < count; ++i)
+    {
+        Z_inv[i] = table[i].Z;
+    }
+    batch_invert<bls12_381_Fq2>(Z_inv, prod, count);
+
+    const bls12_381_Fq2 one = bls12_381_Fq2::one();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        bls12_381_Fq2 Z2 = Z_inv[i].squared();
+        bls12_381_Fq2 Z3 = Z_inv[i] * Z2;
+
+        table[i].X = table[i].X * Z2;
+        table[i].Y = table[i].Y * Z3;
+        table[i].Z = one;
+    }
+}
+
 } // namespace libff
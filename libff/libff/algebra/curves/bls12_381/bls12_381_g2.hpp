@@ -66,8 +66,11 @@ public:
     bls12_381_G2 dbl() const;
     bls12_381_G2 mul_by_q() const;
     bls12_381_G2 mul_by_cofactor() const;
+    /* [h_eff] P for the h_eff of RFC 9380, 8.8.2: a multiple of mul_by_cofactor() that also lands in G2, but cheaper */
+    bls12_381_G2 clear_cofactor() const;
 
     bool is_well_formed() const;
+    bool is_in_safe_subgroup() const;
 
     static bls12_381_G2 zero();
     static bls12_381_G2 one();
@@ -81,8 +84,13 @@ public:
     friend std::istream& operator>>(std::istream &in, bls12_381_G2 &g);
 
     static void batch_to_special_all_non_zeros(std::vector<bls12_381_G2> &vec);
+    static void batch_to_special_all_non_zeros(bls12_381_G2 *vec, const std::size_t count);
 };
 
+/* without heap allocations, for the wNAF tables of scalar multiplication */
+template<>
+void batch_to_special_table<bls12_381_G2>(bls12_381_G2 *table, const std::size_t count);
+
 template<mp_size_t m>
 bls12_381_G2 operator*(const bigint<m> &lhs, const bls12_381_G2 &rhs)
 {
@@ -0,0 +1,42 @@
+/** @file
+ *****************************************************************************
+ Hashing to the groups of BLS12-381 with the suites of RFC 9380, 8.8:
+ BLS12381G1_XMD:SHA-256_SSWU_RO_ and BLS12381G2_XMD:SHA-256_SSWU_RO_.
+
+ A message is hashed to two field elements (hash_to_field with L = 64),
+ each of them is mapped by the simplified SWU map to a curve isogenous to
+ E (resp. to the twist E') and brought back by the 11-isogeny (resp. the
+ 3-isogeny), and the sum of the two points is multiplied by h_eff.
+
+ dst is the domain separation tag of the application, e.g.
+ "BLS_SIG_BLS12381G2_XMD:SHA-256_SSWU_RO_NUL_" for BLS signatures.
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef BLS12_381_HASH_TO_CURVE_HPP_
+#define BLS12_381_HASH_TO_CURVE_HPP_
+#include <string>
+#include <vector>
+
+#include <libff/algebra/curves/bls12_381/bls12_381_g1.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_g2.hpp>
+
+namespace libff {
+
+/* The results are in their prime-order subgroups, with Z = 1 unless zero. */
+bls12_381_G1 bls12_381_hash_to_G1(const std::string &msg, const std::string &dst);
+bls12_381_G2 bls12_381_hash_to_G2(const std::string &msg, const std::string &dst);
+
+/* The hashes of all the messages, spread over parallel_for, with one
+   batched inversion to normalize all of them. */
+std::vector<bls12_381_G1> bls12_381_batch_hash_to_G1(const std::vector<std::string> &msgs,
+                                                     const std::string &dst);
+std::vector<bls12_381_G2> bls12_381_batch_hash_to_G2(const std::vector<std::string> &msgs,
+                                                     const std::string &dst);
+
+} // namespace libff
+
+#endif // BLS12_381_HASH_TO_CURVE_HPP_
@@ -11,6 +11,7 @@ bls12_381_Fq bls12_381_twist_mul_by_b_c0;
 bls12_381_Fq bls12_381_twist_mul_by_b_c1;
 bls12_381_Fq2 bls12_381_twist_mul_by_q_X;
 bls12_381_Fq2 bls12_381_twist_mul_by_q_Y;
+bls12_381_Fq bls12_381_g1_endomorphism_beta;
 
 bigint<bls12_381_q_limbs> bls12_381_ate_loop_count;
 bool bls12_381_ate_is_loop_count_neg;
@@ -33,6 +34,7 @@ void init_bls12_381_params()
                                                bls12_381_Fq("4002409555221667392624310435006688643935503118305586438271171395842971157480381377015405980053539358417135540939437"));
     bls12_381_twist_mul_by_q_Y = bls12_381_Fq2(bls12_381_Fq("2973677408986561043442465346520108879172042883009249989176415018091420807192182638567116318576472649347015917690530"),
                                                bls12_381_Fq("1028732146235106349975324479215795277384839936929757896155643118032610843298655225875571310552543014690878354869257"));
+    bls12_381_g1_endomorphism_beta = bls12_381_Fq("793479390729215512621379701633421447060886740281060493010456487427281649075476305620758731620350");
 
 
     /* choice of group G1 */
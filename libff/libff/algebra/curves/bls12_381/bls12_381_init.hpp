@@ -21,6 +21,8 @@ extern bls12_381_Fq bls12_381_twist_mul_by_b_c0;
 extern bls12_381_Fq bls12_381_twist_mul_by_b_c1;
 extern bls12_381_Fq2 bls12_381_twist_mul_by_q_X;
 extern bls12_381_Fq2 bls12_381_twist_mul_by_q_Y;
+// cube root of unity beta, for which (x, y) -> (beta x, y) acts as [-z^2] on G1
+extern bls12_381_Fq bls12_381_g1_endomorphism_beta;
 
 // parameters for pairing
 extern bigint<bls12_381_q_limbs> bls12_381_ate_loop_count;
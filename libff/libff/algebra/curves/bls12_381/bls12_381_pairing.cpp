@@ -11,6 +11,8 @@
 #include <libff/algebra/curves/bls12_381/bls12_381_g2.hpp>
 #include <libff/algebra/curves/bls12_381/bls12_381_init.hpp>
 #include <libff/algebra/curves/bls12_381/bls12_381_pairing.hpp>
+#include <libff/algebra/field_utils/field_utils.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
 #include <libff/common/profiling.hpp>
 
 namespace libff {
@@ -310,6 +312,150 @@ bls12_381_ate_G2_precomp bls12_381_ate_precompute_G2(const bls12_381_G2& Q)
     return result;
 }
 
+/* The line through the affine point (x, y) of slope lambda, as in
+   mixed_addition_step_for_miller_loop with Z1 = 1 and divided by D. */
+static bls12_381_ate_ell_coeffs affine_line_coeffs(const bls12_381_Fq2 &lambda,
+                                                   const bls12_381_Fq2 &x,
+                                                   const bls12_381_Fq2 &y)
+{
+    bls12_381_ate_ell_coeffs c;
+    c.ell_0 = lambda * x - y;                     // ell_0 = lambda * x - y
+    c.ell_VW = bls12_381_twist;                   // ell_VW = xi (later: * yP)
+    c.ell_VV = -lambda;                           // ell_VV = - lambda (later: * xP)
+    return c;
+}
+
+/* The affine steps of bls12_381_affine_ate_batch_precompute_G2: R[j] is
+   replaced by 2 R[j], or by R[j] + Q[j], and the line through them is
+   appended to result[j]. A point whose denominator is zero (R[j] of order
+   2, or R[j] = +-Q[j]) gets a denominator of one so that the batch
+   inversion goes through, and is marked in degenerate[j]. */
+class bls12_381_affine_ate_batch_steps {
+public:
+    std::vector<bls12_381_Fq2> RX, RY;
+    std::vector<bool> degenerate;
+
+    bls12_381_affine_ate_batch_steps(const std::vector<bls12_381_G2> &Q) :
+        RX(Q.size()), RY(Q.size()), degenerate(Q.size(), false), inv(Q.size()), scratch(Q.size())
+    {
+        for (size_t j = 0; j < Q.size(); ++j)
+        {
+            RX[j] = Q[j].X;
+            RY[j] = Q[j].Y;
+        }
+    }
+
+    void doubling_step(std::vector<bls12_381_ate_G2_precomp> &result)
+    {
+        for (size_t j = 0; j < RX.size(); ++j)
+        {
+            inv[j] = RY[j] + RY[j];
+            flag_if_zero(j);
+        }
+        batch_invert(inv.data(), scratch.data(), inv.size());
+
+        for (size_t j = 0; j < RX.size(); ++j)
+        {
+            const bls12_381_Fq2 X_squared = RX[j].squared();
+            const bls12_381_Fq2 lambda = (X_squared + X_squared + X_squared) * inv[j];
+            result[j].coeffs.emplace_back(affine_line_coeffs(lambda, RX[j], RY[j]));
+            const bls12_381_Fq2 X3 = lambda.squared() - (RX[j] + RX[j]);
+            RY[j] = lambda * (RX[j] - X3) - RY[j];
+            RX[j] = X3;
+        }
+    }
+
+    void addition_step(const std::vector<bls12_381_ate_G2_precomp> &base,
+                       std::vector<bls12_381_ate_G2_precomp> &result)
+    {
+        for (size_t j = 0; j < RX.size(); ++j)
+        {
+            inv[j] = RX[j] - base[j].QX;
+            flag_if_zero(j);
+        }
+        batch_invert(inv.data(), scratch.data(), inv.size());
+
+        for (size_t j = 0; j < RX.size(); ++j)
+        {
+            const bls12_381_Fq2 lambda = (RY[j] - base[j].QY) * inv[j];
+            result[j].coeffs.emplace_back(affine_line_coeffs(lambda, RX[j], RY[j]));
+            const bls12_381_Fq2 X3 = lambda.squared() - (RX[j] + base[j].QX);
+            RY[j] = lambda * (RX[j] - X3) - RY[j];
+            RX[j] = X3;
+        }
+    }
+
+private:
+    std::vector<bls12_381_Fq2> inv, scratch;
+
+    void flag_if_zero(const size_t j)
+    {
+        if (inv[j].is_zero())
+        {
+            inv[j] = bls12_381_Fq2::one();
+            degenerate[j] = true;
+        }
+    }
+};
+
+std::vector<bls12_381_ate_G2_precomp> bls12_381_affine_ate_batch_precompute_G2(const std::vector<bls12_381_G2> &Q)
+{
+    enter_block("Call to bls12_381_affine_ate_batch_precompute_G2");
+
+    std::vector<bls12_381_G2> Qaffine(Q);
+    batch_to_special(Qaffine);
+
+    const bigint<bls12_381_Fq::num_limbs> &loop_count = bls12_381_ate_loop_count;
+    const size_t num_coeffs = loop_count.num_bits() - 1 + mpn_popcount(loop_count.data, loop_count.N) - 1;
+
+    const size_t n = Q.size();
+    std::vector<bls12_381_ate_G2_precomp> result(n);
+    for (size_t j = 0; j < n; ++j)
+    {
+        result[j].QX = Qaffine[j].X;
+        result[j].QY = Qaffine[j].Y;
+        result[j].coeffs.reserve(num_coeffs);
+    }
+
+    bls12_381_affine_ate_batch_steps R(Qaffine);
+    for (long i = loop_count.num_bits() - 2; i >= 0; --i)
+    {
+        R.doubling_step(result);
+        if (loop_count.test_bit(i))
+        {
+            R.addition_step(result, result);
+        }
+    }
+
+    /* points outside G2 can run into a vertical line */
+    for (size_t j = 0; j < n; ++j)
+    {
+        if (R.degenerate[j])
+        {
+            result[j] = bls12_381_ate_precompute_G2(Qaffine[j]);
+        }
+    }
+
+    leave_block("Call to bls12_381_affine_ate_batch_precompute_G2");
+    return result;
+}
+
+std::vector<bls12_381_ate_G2_precomp> bls12_381_ate_batch_precompute_G2(const std::vector<bls12_381_G2> &Q)
+{
+    if (Q.size() >= bls12_381_affine_ate_min_points)
+    {
+        return bls12_381_affine_ate_batch_precompute_G2(Q);
+    }
+
+    std::vector<bls12_381_ate_G2_precomp> result;
+    result.reserve(Q.size());
+    for (const bls12_381_G2 &point : Q)
+    {
+        result.emplace_back(bls12_381_ate_precompute_G2(point));
+    }
+    return result;
+}
+
 bls12_381_Fq12 bls12_381_ate_miller_loop(const bls12_381_ate_G1_precomp &prec_P,
                                      const bls12_381_ate_G2_precomp &prec_Q)
 {
@@ -415,6 +561,58 @@ bls12_381_Fq12 bls12_381_ate_double_miller_loop(const bls12_381_ate_G1_precomp &
     return f;
 }
 
+bls12_381_Fq12 bls12_381_ate_multi_miller_loop(const std::vector<bls12_381_ate_G1_precomp> &prec_P,
+                                               const std::vector<bls12_381_ate_G2_precomp> &prec_Q)
+{
+    enter_block("Call to bls12_381_ate_multi_miller_loop");
+    assert(prec_P.size() == prec_Q.size());
+
+    bls12_381_Fq12 f = bls12_381_Fq12::one();
+
+    bool found_one = false;
+    size_t idx = 0;
+
+    const bigint<bls12_381_Fq::num_limbs> &loop_count = bls12_381_ate_loop_count;
+    for (long i = loop_count.max_bits(); i >= 0; --i)
+    {
+        const bool bit = loop_count.test_bit(i);
+        if (!found_one)
+        {
+            /* this skips the MSB itself */
+            found_one |= bit;
+            continue;
+        }
+
+        /* as in bls12_381_ate_double_miller_loop, one squaring per bit for all the pairs */
+        f.square_inplace();
+        for (size_t j = 0; j < prec_P.size(); ++j)
+        {
+            const bls12_381_ate_ell_coeffs &c = prec_Q[j].coeffs[idx];
+            f = f.mul_by_045(c.ell_0, prec_P[j].PY * c.ell_VW, prec_P[j].PX * c.ell_VV);
+        }
+        ++idx;
+
+        if (bit)
+        {
+            for (size_t j = 0; j < prec_P.size(); ++j)
+            {
+                const bls12_381_ate_ell_coeffs &c = prec_Q[j].coeffs[idx];
+                f = f.mul_by_045(c.ell_0, prec_P[j].PY * c.ell_VW, prec_P[j].PX * c.ell_VV);
+            }
+            ++idx;
+        }
+    }
+
+    if (bls12_381_ate_is_loop_count_neg)
+    {
+        f = f.inverse();
+    }
+
+    leave_block("Call to bls12_381_ate_multi_miller_loop");
+
+    return f;
+}
+
 bls12_381_Fq12 bls12_381_ate_pairing(const bls12_381_G1& P, const bls12_381_G2 &Q)
 {
     enter_block("Call to bls12_381_ate_pairing");
@@ -446,6 +644,11 @@ bls12_381_G2_precomp bls12_381_precompute_G2(const bls12_381_G2& Q)
     return bls12_381_ate_precompute_G2(Q);
 }
 
+std::vector<bls12_381_G2_precomp> bls12_381_batch_precompute_G2(const std::vector<bls12_381_G2> &Q)
+{
+    return bls12_381_ate_batch_precompute_G2(Q);
+}
+
 bls12_381_Fq12 bls12_381_miller_loop(const bls12_381_G1_precomp &prec_P,
                           const bls12_381_G2_precomp &prec_Q)
 {
@@ -460,6 +663,12 @@ bls12_381_Fq12 bls12_381_double_miller_loop(const bls12_381_G1_precomp &prec_P1,
     return bls12_381_ate_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
 }
 
+bls12_381_Fq12 bls12_381_multi_miller_loop(const std::vector<bls12_381_G1_precomp> &prec_P,
+                                           const std::vector<bls12_381_G2_precomp> &prec_Q)
+{
+    return bls12_381_ate_multi_miller_loop(prec_P, prec_Q);
+}
+
 bls12_381_Fq12 bls12_381_pairing(const bls12_381_G1& P,
                       const bls12_381_G2 &Q)
 {
@@ -51,12 +51,29 @@ struct bls12_381_ate_G2_precomp {
 bls12_381_ate_G1_precomp bls12_381_ate_precompute_G1(const bls12_381_G1& P);
 bls12_381_ate_G2_precomp bls12_381_ate_precompute_G2(const bls12_381_G2& Q);
 
+/**
+ * bls12_381_ate_precompute_G2 for all of Q at once, with the doubling and
+ * addition steps in affine coordinates: each step shares one batched
+ * inversion between the points. The line coefficients differ from those of
+ * bls12_381_ate_precompute_G2 by factors in F_q^2, which the final
+ * exponentiation removes. Points must be non-zero.
+ */
+std::vector<bls12_381_ate_G2_precomp> bls12_381_affine_ate_batch_precompute_G2(const std::vector<bls12_381_G2> &Q);
+/* the batch size from which bls12_381_ate_batch_precompute_G2 goes affine; a heuristic taken
+   from alt_bn128_affine_ate_min_points, as the crossover here is at or below it */
+const std::size_t bls12_381_affine_ate_min_points = 4;
+/* bls12_381_ate_precompute_G2 of every point of Q, or its affine batch version for large batches */
+std::vector<bls12_381_ate_G2_precomp> bls12_381_ate_batch_precompute_G2(const std::vector<bls12_381_G2> &Q);
+
 bls12_381_Fq12 bls12_381_ate_miller_loop(const bls12_381_ate_G1_precomp &prec_P,
                               const bls12_381_ate_G2_precomp &prec_Q);
 bls12_381_Fq12 bls12_381_ate_double_miller_loop(const bls12_381_ate_G1_precomp &prec_P1,
                                      const bls12_381_ate_G2_precomp &prec_Q1,
                                      const bls12_381_ate_G1_precomp &prec_P2,
                                      const bls12_381_ate_G2_precomp &prec_Q2);
+/* product of the Miller loops of (prec_P[i], prec_Q[i]), sharing the squarings */
+bls12_381_Fq12 bls12_381_ate_multi_miller_loop(const std::vector<bls12_381_ate_G1_precomp> &prec_P,
+                                               const std::vector<bls12_381_ate_G2_precomp> &prec_Q);
 
 bls12_381_Fq12 bls12_381_ate_pairing(const bls12_381_G1& P,
                           const bls12_381_G2 &Q);
@@ -71,6 +88,7 @@ typedef bls12_381_ate_G2_precomp bls12_381_G2_precomp;
 bls12_381_G1_precomp bls12_381_precompute_G1(const bls12_381_G1& P);
 
 bls12_381_G2_precomp bls12_381_precompute_G2(const bls12_381_G2& Q);
+std::vector<bls12_381_G2_precomp> bls12_381_batch_precompute_G2(const std::vector<bls12_381_G2> &Q);
 
 bls12_381_Fq12 bls12_381_miller_loop(const bls12_381_G1_precomp &prec_P,
                           const bls12_381_G2_precomp &prec_Q);
@@ -80,6 +98,9 @@ bls12_381_Fq12 bls12_381_double_miller_loop(const bls12_381_G1_precomp &prec_P1,
                                  const bls12_381_G1_precomp &prec_P2,
                                  const bls12_381_G2_precomp &prec_Q2);
 
+bls12_381_Fq12 bls12_381_multi_miller_loop(const std::vector<bls12_381_G1_precomp> &prec_P,
+                                           const std::vector<bls12_381_G2_precomp> &prec_Q);
+
 bls12_381_Fq12 bls12_381_pairing(const bls12_381_G1& P,
                       const bls12_381_G2 &Q);
 
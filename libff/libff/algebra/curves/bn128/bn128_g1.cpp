@@ -507,18 +507,21 @@ std::istream& operator>>(std::istream& in, std::vector<bn128_G1> &v)
 
 void bn128_G1::batch_to_special_all_non_zeros(std::vector<bn128_G1> &vec)
 {
-    std::vector<bn::Fp> Z_vec;
-    Z_vec.reserve(vec.size());
+    batch_to_special_all_non_zeros(vec.data(), vec.size());
+}
 
-    for (auto &el: vec)
+void bn128_G1::batch_to_special_all_non_zeros(bn128_G1 *vec, const size_t count)
+{
+    std::vector<bn::Fp> Z_vec(count);
+    for (size_t i = 0; i < count; ++i)
     {
-        Z_vec.emplace_back(el.Z);
+        Z_vec[i] = vec[i].Z;
     }
     bn_batch_invert<bn::Fp>(Z_vec);
 
     const bn::Fp one = 1;
 
-    for (size_t i = 0; i < vec.size(); ++i)
+    for (size_t i = 0; i < count; ++i)
     {
         bn::Fp Z2, Z3;
         bn::Fp::square(Z2, Z_vec[i]);
@@ -84,6 +84,7 @@ public:
     friend std::istream& operator>>(std::istream &in, bn128_G2 &g);
 
     static void batch_to_special_all_non_zeros(std::vector<bn128_G2> &vec);
+    static void batch_to_special_all_non_zeros(bn128_G2 *vec, const std::size_t count);
 };
 
 template<mp_size_t m>
@@ -32,6 +32,11 @@ bn128_GT bn128_GT::operator*(const bn128_GT &other) const
     return result;
 }
 
+bn128_GT bn128_GT::squared() const
+{
+    return (*this) * (*this);
+}
+
 bn128_GT bn128_GT::unitary_inverse() const
 {
     bn128_GT result(*this);
@@ -30,6 +30,7 @@ public:
     bool operator!=(const bn128_GT &other) const;
 
     bn128_GT operator*(const bn128_GT &other) const;
+    bn128_GT squared() const;
     bn128_GT unitary_inverse() const;
 
     static bn128_GT one();
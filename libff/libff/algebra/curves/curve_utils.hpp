@@ -7,15 +7,36 @@
 
 #ifndef CURVE_UTILS_HPP_
 #define CURVE_UTILS_HPP_
+#include <cstddef>
 #include <cstdint>
 
 #include <libff/algebra/field_utils/bigint.hpp>
 
 namespace libff {
 
+/**
+ * Default scalar multiplication: fixed_window_wnaf_exp with the window of
+ * GroupT::wnaf_window_table for the bit length of scalar, which adds odd
+ * multiples of base from a table in affine form (mixed additions) and does
+ * not allocate. Short scalars, and groups whose table is not initialized,
+ * use double-and-add.
+ */
 template<typename GroupT, mp_size_t m>
 GroupT scalar_mul(const GroupT &base, const bigint<m> &scalar);
 
+/**
+ * Scalar multiplication with a schedule that does not depend on the scalar:
+ * the scalar is recoded into ceil(64 m / w) odd signed digits (Joye--Tunstall
+ * regular recoding), each of which costs w doublings and one addition from a
+ * table of odd multiples of base. Even scalars are handled as scalar + 1,
+ * followed by a subtraction of base that is performed in either case.
+ *
+ * Only the exceptional cases of the group law (adding a point to itself or to
+ * its negation, or base being zero) take a different, cheaper, path.
+ */
+template<typename GroupT, mp_size_t m, std::size_t w>
+GroupT fixed_window_scalar_mul(const GroupT &base, const bigint<m> &scalar);
+
 } // namespace libff
 #include <libff/algebra/curves/curve_utils.tcc>
 
@@ -8,29 +8,111 @@
 #ifndef CURVE_UTILS_TCC_
 #define CURVE_UTILS_TCC_
 
+#include <cassert>
+
+#include <libff/algebra/scalar_multiplication/wnaf.hpp>
+
 namespace libff {
 
 template<typename GroupT, mp_size_t m>
 GroupT scalar_mul(const GroupT &base, const bigint<m> &scalar)
 {
-    GroupT result = GroupT::zero();
+    /* the window of opt_window_wnaf_exp, which itself falls back to this function */
+    const std::size_t scalar_bits = scalar.num_bits();
+    std::size_t window = 0;
+    for (long i = GroupT::wnaf_window_table.size() - 1; i >= 0; --i)
+    {
+        if (scalar_bits >= GroupT::wnaf_window_table[i])
+        {
+            window = i+1;
+            break;
+        }
+    }
 
-    bool found_one = false;
-    for (long i = static_cast<long>(scalar.max_bits() - 1); i >= 0; --i)
+    if (window == 0)
     {
-        if (found_one)
+        GroupT result = GroupT::zero();
+
+        bool found_one = false;
+        for (long i = static_cast<long>(scalar.max_bits() - 1); i >= 0; --i)
         {
-            result = result.dbl();
+            if (found_one)
+            {
+                result = result.dbl();
+            }
+
+            if (scalar.test_bit(i))
+            {
+                found_one = true;
+                result = result + base;
+            }
         }
 
-        if (scalar.test_bit(i))
+        return result;
+    }
+
+    return fixed_window_wnaf_exp(window, base, scalar);
+}
+
+template<typename GroupT, mp_size_t m, std::size_t w>
+GroupT fixed_window_scalar_mul(const GroupT &base, const bigint<m> &scalar)
+{
+    static_assert(w >= 1 && w < GMP_NUMB_BITS - 1, "window must fit in a limb");
+    constexpr std::size_t table_size = std::size_t(1) << (w - 1);
+    constexpr std::size_t digit_count = (m * GMP_NUMB_BITS + w - 1) / w;
+
+    /* table[i] = (2i + 1) * base */
+    GroupT table[table_size];
+    table[0] = base;
+    const GroupT base_dbl = base.dbl();
+    for (std::size_t i = 1; i < table_size; ++i)
+    {
+        table[i] = table[i-1] + base_dbl;
+    }
+
+    /* Joye Tunstall --- Exponent Recoding and Regular Exponentiation Algorithms; Section 3.2:
+       for odd k, d = (k mod 2^(w+1)) - 2^w is odd and (k - d) / 2^w is odd again */
+    const bool is_even = !scalar.test_bit(0);
+    mp_limb_t k[m + 1];
+    mpn_copyi(k, scalar.data, m);
+    k[m] = 0;
+    k[0] |= 1;
+
+    long digits[digit_count];
+    for (std::size_t i = 0; i < digit_count; ++i)
+    {
+        const long d = static_cast<long>(k[0] & ((mp_limb_t(2) << w) - 1)) - (1l << w);
+        if (d < 0)
+        {
+            mpn_add_1(k, k, m + 1, static_cast<mp_limb_t>(-d));
+        }
+        else
         {
-            found_one = true;
-            result = result + base;
+            mpn_sub_1(k, k, m + 1, static_cast<mp_limb_t>(d));
         }
+        mpn_rshift(k, k, m + 1, w);
+        digits[i] = d;
+    }
+    /* what is left is the leading digit, which is always 1 */
+#ifdef DEBUG
+    assert(k[0] == 1);
+#endif
+
+    GroupT result = base;
+    for (long i = static_cast<long>(digit_count) - 1; i >= 0; --i)
+    {
+        for (std::size_t j = 0; j < w; ++j)
+        {
+            result = result.dbl();
+        }
+
+        const long d = digits[i];
+        const GroupT &multiple = table[(d < 0 ? -d : d) >> 1];
+        result = (d < 0 ? result - multiple : result + multiple);
     }
 
-    return result;
+    const GroupT corrected = result - base;
+    return is_even ? corrected : result;
 }
 
 } // namespace libff
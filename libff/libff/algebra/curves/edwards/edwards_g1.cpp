@@ -390,18 +390,21 @@ std::istream& operator>>(std::istream& in, std::vector<edwards_G1> &v)
 
 void edwards_G1::batch_to_special_all_non_zeros(std::vector<edwards_G1> &vec)
 {
-    std::vector<edwards_Fq> Z_vec;
-    Z_vec.reserve(vec.size());
+    batch_to_special_all_non_zeros(vec.data(), vec.size());
+}
 
-    for (auto &el: vec)
+void edwards_G1::batch_to_special_all_non_zeros(edwards_G1 *vec, const size_t count)
+{
+    std::vector<edwards_Fq> Z_vec(count), prod(count);
+    for (size_t i = 0; i < count; ++i)
     {
-        Z_vec.emplace_back(el.Z);
+        Z_vec[i] = vec[i].Z;
     }
-    batch_invert<edwards_Fq>(Z_vec);
+    batch_invert<edwards_Fq>(Z_vec.data(), prod.data(), count);
 
     const edwards_Fq one = edwards_Fq::one();
 
-    for (size_t i = 0; i < vec.size(); ++i)
+    for (size_t i = 0; i < count; ++i)
     {
         vec[i].X = vec[i].X * Z_vec[i];
         vec[i].Y = vec[i].Y * Z_vec[i];
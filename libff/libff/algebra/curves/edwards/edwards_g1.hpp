@@ -75,6 +75,7 @@ public:
     friend std::istream& operator>>(std::istream &in, edwards_G1 &g);
 
     static void batch_to_special_all_non_zeros(std::vector<edwards_G1> &vec);
+    static void batch_to_special_all_non_zeros(edwards_G1 *vec, const std::size_t count);
 };
 
 template<mp_size_t m>
@@ -81,6 +81,7 @@ public:
     friend std::istream& operator>>(std::istream &in, edwards_G2 &g);
 
     static void batch_to_special_all_non_zeros(std::vector<edwards_G2> &vec);
+    static void batch_to_special_all_non_zeros(edwards_G2 *vec, const std::size_t count);
 };
 
 template<mp_size_t m>
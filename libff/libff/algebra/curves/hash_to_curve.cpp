@@ -0,0 +1,85 @@
+/** @file
+ *****************************************************************************
+ Implementation of expand_message_xmd with SHA-256.
+
+ See hash_to_curve.hpp .
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <stdexcept>
+
+#include <sodium/crypto_hash_sha256.h>
+
+#include <libff/algebra/curves/hash_to_curve.hpp>
+
+namespace libff {
+
+using std::size_t;
+
+std::vector<unsigned char> expand_message_xmd(const std::string &msg,
+                                              const std::string &dst,
+                                              const size_t len_in_bytes)
+{
+    const size_t b_in_bytes = crypto_hash_sha256_BYTES;
+    const size_t s_in_bytes = 64;
+
+    const size_t ell = (len_in_bytes + b_in_bytes - 1) / b_in_bytes;
+    if (ell > 255 || len_in_bytes > 65535)
+    {
+        throw std::invalid_argument("expand_message_xmd: len_in_bytes is too large");
+    }
+
+    /* DST_prime = DST || I2OSP(len(DST), 1), with an oversized DST replaced
+       by SHA-256("H2C-OVERSIZE-DST-" || DST) */
+    std::string dst_prime = dst;
+    if (dst.size() > 255)
+    {
+        const std::string prefix = "H2C-OVERSIZE-DST-";
+        unsigned char hash[crypto_hash_sha256_BYTES];
+        crypto_hash_sha256_state sha256;
+        crypto_hash_sha256_init(&sha256);
+        crypto_hash_sha256_update(&sha256, (const unsigned char*)prefix.data(), prefix.size());
+        crypto_hash_sha256_update(&sha256, (const unsigned char*)dst.data(), dst.size());
+        crypto_hash_sha256_final(&sha256, hash);
+        dst_prime.assign((const char*)hash, sizeof(hash));
+    }
+    dst_prime.push_back((char)dst_prime.size());
+
+    /* b_0 = H(Z_pad || msg || I2OSP(len_in_bytes, 2) || I2OSP(0, 1) || DST_prime) */
+    const unsigned char z_pad[s_in_bytes] = { 0 };
+    const unsigned char l_i_b_str[3] = { (unsigned char)(len_in_bytes >> 8), (unsigned char)len_in_bytes, 0 };
+    unsigned char b_0[crypto_hash_sha256_BYTES];
+    crypto_hash_sha256_state sha256;
+    crypto_hash_sha256_init(&sha256);
+    crypto_hash_sha256_update(&sha256, z_pad, sizeof(z_pad));
+    crypto_hash_sha256_update(&sha256, (const unsigned char*)msg.data(), msg.size());
+    crypto_hash_sha256_update(&sha256, l_i_b_str, sizeof(l_i_b_str));
+    crypto_hash_sha256_update(&sha256, (const unsigned char*)dst_prime.data(), dst_prime.size());
+    crypto_hash_sha256_final(&sha256, b_0);
+
+    /* b_i = H((b_0 xor b_(i-1)) || I2OSP(i, 1) || DST_prime), where b_1 has
+       b_0 alone in place of the xor */
+    std::vector<unsigned char> uniform_bytes(ell * b_in_bytes);
+    for (size_t i = 1; i <= ell; ++i)
+    {
+        unsigned char input[crypto_hash_sha256_BYTES + 1];
+        for (size_t j = 0; j < b_in_bytes; ++j)
+        {
+            input[j] = b_0[j] ^ (i == 1 ? 0 : uniform_bytes[(i - 2) * b_in_bytes + j]);
+        }
+        input[b_in_bytes] = (unsigned char)i;
+
+        crypto_hash_sha256_init(&sha256);
+        crypto_hash_sha256_update(&sha256, input, sizeof(input));
+        crypto_hash_sha256_update(&sha256, (const unsigned char*)dst_prime.data(), dst_prime.size());
+        crypto_hash_sha256_final(&sha256, &uniform_bytes[(i - 1) * b_in_bytes]);
+    }
+
+    uniform_bytes.resize(len_in_bytes);
+    return uniform_bytes;
+}
+
+} // namespace libff
@@ -0,0 +1,133 @@
+/** @file
+ *****************************************************************************
+ Declaration of the curve-independent parts of hashing to elliptic curves
+ (RFC 9380): expand_message_xmd with SHA-256, hash_to_field, the
+ sqrt_ratio and sgn0 helpers, and the simplified SWU, isogeny and
+ Shallue--van de Woestijne maps.
+
+ The maps run a fixed sequence of field operations: square roots go through
+ sqrt_ratio, whose exponents depend only on the field, and the branches of
+ the RFC are selections between values that are all computed. They return
+ points in Jacobian coordinates without inverting anything, so that a batch
+ of hashes shares its inversions in the final batch_to_special.
+
+ The per-curve suites are in alt_bn128/alt_bn128_hash_to_curve.hpp and
+ bls12_381/bls12_381_hash_to_curve.hpp .
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef HASH_TO_CURVE_HPP_
+#define HASH_TO_CURVE_HPP_
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <libff/algebra/fields/prime_base/fp.hpp>
+#include <libff/algebra/fields/prime_extension/fp2.hpp>
+
+namespace libff {
+
+/**
+ * expand_message_xmd(msg, dst, len_in_bytes) with SHA-256 (RFC 9380, 5.3.1).
+ * A dst longer than 255 bytes is first hashed as in 5.3.3. Throws
+ * std::invalid_argument if len_in_bytes is above 8160.
+ */
+std::vector<unsigned char> expand_message_xmd(const std::string &msg,
+                                              const std::string &dst,
+                                              const std::size_t len_in_bytes);
+
+/**
+ * hash_to_field(msg, count) (RFC 9380, 5.2) with expand_message_xmd, where
+ * every base field element is reduced from L uniform bytes.
+ */
+template<typename FieldT>
+std::vector<FieldT> hash_to_field(const std::string &msg,
+                                  const std::string &dst,
+                                  const std::size_t count,
+                                  const std::size_t L);
+
+/** The "sign" of a field element (RFC 9380, 4.1). */
+template<mp_size_t n, const bigint<n>& modulus>
+bool sgn0(const Fp_model<n, modulus> &x);
+template<mp_size_t n, const bigint<n>& modulus>
+bool sgn0(const Fp2_model<n, modulus> &x);
+
+/** The constants of sqrt_ratio for a quadratic non-residue Z of FieldT. */
+template<typename FieldT>
+struct sqrt_ratio_constants {
+    FieldT Z;
+    FieldT Z_to_t;                /* Z^t, with |FieldT| - 1 = 2^s * t */
+    FieldT Z_to_t_plus_1_over_2;  /* Z^((t+1)/2) */
+
+    sqrt_ratio_constants() = default;
+    explicit sqrt_ratio_constants(const FieldT &Z);
+};
+
+/**
+ * sqrt_ratio(u, v) (RFC 9380, F.2.1.1) for v != 0: returns true and sets y to
+ * a square root of u/v if u/v is a square, and otherwise returns false and
+ * sets y to a square root of Z * u/v.
+ */
+template<typename FieldT>
+bool sqrt_ratio(const FieldT &u,
+                const FieldT &v,
+                const sqrt_ratio_constants<FieldT> &c,
+                FieldT &y);
+
+/** The simplified SWU map to y^2 = x^3 + A * x + B, with A and B non-zero (RFC 9380, 6.6.2). */
+template<typename FieldT>
+struct sswu_map_params {
+    FieldT A, B;
+    sqrt_ratio_constants<FieldT> sqrt_ratio;  /* for the non-square Z of the map */
+
+    sswu_map_params() = default;
+    sswu_map_params(const FieldT &A, const FieldT &B, const FieldT &Z);
+};
+
+/** Sets (x_num / x_den, y) to the image of u, with x_den non-zero. */
+template<typename FieldT>
+void map_to_curve_simple_swu(const FieldT &u,
+                             const sswu_map_params<FieldT> &params,
+                             FieldT &x_num,
+                             FieldT &x_den,
+                             FieldT &y);
+
+/**
+ * The rational map (x, y) -> (x_num(x) / x_den(x), y * y_num(x) / y_den(x))
+ * of an isogeny, with the coefficients of each polynomial listed by
+ * increasing degree (RFC 9380, 6.6.3).
+ */
+template<typename FieldT>
+struct isogeny_map_params {
+    std::vector<FieldT> x_num, x_den, y_num, y_den;
+};
+
+/** The image of (x_num / x_den, y) in Jacobian coordinates. */
+template<typename GroupT, typename FieldT>
+GroupT isogeny_map(const FieldT &x_num,
+                   const FieldT &x_den,
+                   const FieldT &y,
+                   const isogeny_map_params<FieldT> &params);
+
+/** The Shallue--van de Woestijne map to y^2 = x^3 + A * x + B (RFC 9380, 6.6.1). */
+template<typename FieldT>
+struct svdw_map_params {
+    FieldT A, B, Z;
+    FieldT c1, c2, c3, c4;
+    sqrt_ratio_constants<FieldT> sqrt_ratio;  /* for FieldT::nqr; only its square case is used */
+
+    svdw_map_params() = default;
+    svdw_map_params(const FieldT &A, const FieldT &B, const FieldT &Z);
+};
+
+/** The image of u in Jacobian coordinates. */
+template<typename GroupT, typename FieldT>
+GroupT map_to_curve_svdw(const FieldT &u, const svdw_map_params<FieldT> &params);
+
+} // namespace libff
+#include <libff/algebra/curves/hash_to_curve.tcc>
+
+#endif // HASH_TO_CURVE_HPP_
@@ -0,0 +1,309 @@
+/** @file
+ *****************************************************************************
+ Implementation of the curve-independent parts of hashing to elliptic curves.
+
+ See hash_to_curve.hpp .
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef HASH_TO_CURVE_TCC_
+#define HASH_TO_CURVE_TCC_
+#include <algorithm>
+#include <cassert>
+#include <optional>
+#include <stdexcept>
+
+namespace libff {
+
+/* OS2IP(bytes[0..L)) mod p, accumulated as acc * 2^(8 * chunk_len) + chunk
+   over big-endian chunks of chunk_len bytes, each of them below p. */
+template<mp_size_t n, const bigint<n>& modulus>
+void hash_to_field_element(const unsigned char *bytes,
+                           const std::size_t L,
+                           Fp_model<n, modulus> &out)
+{
+    typedef Fp_model<n, modulus> FieldT;
+
+    const std::size_t chunk_len = (FieldT::num_bits - 1) / 8;
+    bigint<n> shift_bits;
+    shift_bits.data[(8 * chunk_len) / GMP_NUMB_BITS] = mp_limb_t(1) << ((8 * chunk_len) % GMP_NUMB_BITS);
+    const FieldT shift(shift_bits);
+
+    FieldT acc = FieldT::zero();
+    std::size_t len = (L % chunk_len == 0 ? chunk_len : L % chunk_len);
+    for (std::size_t pos = 0; pos < L; pos += len, len = chunk_len)
+    {
+        bigint<n> chunk;
+        for (std::size_t j = 0; j < len; ++j)
+        {
+            const std::size_t bit = 8 * (len - 1 - j);
+            chunk.data[bit / GMP_NUMB_BITS] |= mp_limb_t(bytes[pos + j]) << (bit % GMP_NUMB_BITS);
+        }
+        acc = acc * shift + FieldT(chunk);
+    }
+    out = acc;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void hash_to_field_element(const unsigned char *bytes,
+                           const std::size_t L,
+                           Fp2_model<n, modulus> &out)
+{
+    hash_to_field_element(bytes, L, out.c0);
+    hash_to_field_element(bytes + L, L, out.c1);
+}
+
+template<typename FieldT>
+std::vector<FieldT> hash_to_field(const std::string &msg,
+                                  const std::string &dst,
+                                  const std::size_t count,
+                                  const std::size_t L)
+{
+    const std::size_t m = FieldT::extension_degree();
+    const std::vector<unsigned char> uniform_bytes = expand_message_xmd(msg, dst, count * m * L);
+
+    std::vector<FieldT> result(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        hash_to_field_element(&uniform_bytes[i * m * L], L, result[i]);
+    }
+    return result;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+bool sgn0(const Fp_model<n, modulus> &x)
+{
+    return x.as_bigint().data[0] & 1;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+bool sgn0(const Fp2_model<n, modulus> &x)
+{
+    return sgn0(x.c0) || (x.c0.is_zero() && sgn0(x.c1));
+}
+
+template<typename FieldT>
+sqrt_ratio_constants<FieldT>::sqrt_ratio_constants(const FieldT &Z) :
+    Z(Z),
+    Z_to_t(Z ^ FieldT::t),
+    Z_to_t_plus_1_over_2((Z ^ FieldT::t_minus_1_over_2) * Z)
+{
+}
+
+template<typename FieldT>
+bool sqrt_ratio(const FieldT &u,
+                const FieldT &v,
+                const sqrt_ratio_constants<FieldT> &c,
+                FieldT &y)
+{
+    /* The steps of RFC 9380, F.2.1.1, with c1 = s, c3 = (t-1)/2,
+       c4 = 2^s - 1, c5 = 2^(s-1), c6 = Z^t and c7 = Z^((t+1)/2). */
+    const std::size_t s = FieldT::s;
+    const FieldT one = FieldT::one();
+
+    FieldT tv1 = c.Z_to_t;
+    FieldT tv2 = v ^ ((1ul << s) - 1);
+    FieldT tv3 = tv2.squared() * v;
+    FieldT tv5 = (u * tv3) ^ FieldT::t_minus_1_over_2;
+    tv5 = tv5 * tv2;
+    tv2 = tv5 * v;
+    tv3 = tv5 * u;
+    FieldT tv4 = tv3 * tv2;
+    tv5 = tv4;
+    for (std::size_t j = 1; j < s; ++j)
+    {
+        tv5 = tv5.squared();
+    }
+    const bool is_qr = (tv5 == one);
+    tv2 = tv3 * c.Z_to_t_plus_1_over_2;
+    tv5 = tv4 * tv1;
+    tv3 = (is_qr ? tv3 : tv2);
+    tv4 = (is_qr ? tv4 : tv5);
+
+    for (std::size_t i = s; i >= 2; --i)
+    {
+        tv5 = tv4;
+        for (std::size_t j = 2; j < i; ++j)
+        {
+            tv5 = tv5.squared();
+        }
+        const bool e1 = (tv5 == one);
+        tv2 = tv3 * tv1;
+        tv1 = tv1.squared();
+        tv5 = tv4 * tv1;
+        tv3 = (e1 ? tv3 : tv2);
+        tv4 = (e1 ? tv4 : tv5);
+    }
+
+    y = tv3;
+    return is_qr;
+}
+
+template<typename FieldT>
+sswu_map_params<FieldT>::sswu_map_params(const FieldT &A, const FieldT &B, const FieldT &Z) :
+    A(A), B(B), sqrt_ratio(Z)
+{
+}
+
+template<typename FieldT>
+void map_to_curve_simple_swu(const FieldT &u,
+                             const sswu_map_params<FieldT> &params,
+                             FieldT &x_num,
+                             FieldT &x_den,
+                             FieldT &y)
+{
+    /* RFC 9380, F.2, stopping before the final division x = x_num / x_den */
+    const FieldT &Z = params.sqrt_ratio.Z;
+
+    const FieldT tv1 = Z * u.squared();
+    FieldT tv2 = tv1.squared() + tv1;
+    const FieldT tv3 = params.B * (tv2 + FieldT::one());
+    const FieldT tv4 = params.A * (tv2.is_zero() ? Z : -tv2);
+
+    /* g(tv3 / tv4) = tv2 / tv6 */
+    FieldT tv6 = tv4.squared();
+    tv2 = (tv3.squared() + params.A * tv6) * tv3;
+    tv6 = tv6 * tv4;
+    tv2 = tv2 + params.B * tv6;
+
+    FieldT y1;
+    const bool is_gx1_square = sqrt_ratio(tv2, tv6, params.sqrt_ratio, y1);
+    const FieldT y2 = tv1 * u * y1;
+
+    x_num = (is_gx1_square ? tv3 : tv1 * tv3);
+    x_den = tv4;
+    y = (is_gx1_square ? y1 : y2);
+    const FieldT neg_y = -y;
+    y = (sgn0(u) == sgn0(y) ? y : neg_y);
+}
+
+/* The polynomial with coefficients k, homogenized to the degree d of k:
+   sum_i k[i] * x_num^i * x_den^(d-i), with x_den_powers[j] = x_den^j. */
+template<typename FieldT>
+FieldT isogeny_map_evaluate(const std::vector<FieldT> &k,
+                            const FieldT &x_num,
+                            const std::vector<FieldT> &x_den_powers)
+{
+    const std::size_t d = k.size() - 1;
+    FieldT acc = k[d];
+    for (std::size_t i = d; i-- > 0; )
+    {
+        acc = acc * x_num + k[i] * x_den_powers[d - i];
+    }
+    return acc;
+}
+
+template<typename GroupT, typename FieldT>
+GroupT isogeny_map(const FieldT &x_num,
+                   const FieldT &x_den,
+                   const FieldT &y,
+                   const isogeny_map_params<FieldT> &params)
+{
+    assert(params.x_num.size() >= params.x_den.size());
+    assert(params.y_num.size() >= params.y_den.size());
+
+    const std::size_t max_degree = std::max(params.x_num.size(), params.y_num.size()) - 1;
+    std::vector<FieldT> x_den_powers(max_degree + 1);
+    x_den_powers[0] = FieldT::one();
+    for (std::size_t i = 1; i <= max_degree; ++i)
+    {
+        x_den_powers[i] = x_den_powers[i-1] * x_den;
+    }
+
+    /* x' = xn / xd and y' = yn / yd, where the homogenized numerators and
+       denominators are brought to the same degree by powers of x_den */
+    const FieldT xn = isogeny_map_evaluate(params.x_num, x_num, x_den_powers);
+    const FieldT xd = isogeny_map_evaluate(params.x_den, x_num, x_den_powers) *
+        x_den_powers[params.x_num.size() - params.x_den.size()];
+    const FieldT yn = y * isogeny_map_evaluate(params.y_num, x_num, x_den_powers);
+    const FieldT yd = isogeny_map_evaluate(params.y_den, x_num, x_den_powers) *
+        x_den_powers[params.y_num.size() - params.y_den.size()];
+
+    /* (x', y') = (X / Z^2, Y / Z^3) for Z = xd * yd; a zero denominator
+       (a point of the kernel) gives the point at infinity */
+    const FieldT Z = xd * yd;
+    return GroupT(xn * yd * Z, yn * xd * Z.squared(), Z);
+}
+
+template<typename FieldT>
+svdw_map_params<FieldT>::svdw_map_params(const FieldT &A, const FieldT &B, const FieldT &Z) :
+    A(A), B(B), Z(Z), sqrt_ratio(FieldT::nqr)
+{
+    /* c1 = g(Z), c2 = -Z / 2, c3 = sqrt(-g(Z) * (3 * Z^2 + 4 * A)) with
+       sgn0(c3) = 0 and c4 = -4 * g(Z) / (3 * Z^2 + 4 * A) */
+    const FieldT Z2 = Z.squared();
+    const FieldT gZ = (Z2 + A) * Z + B;
+    const FieldT h = Z2 + Z2 + Z2 + A + A + A + A;
+
+    const std::optional<FieldT> sqrt = (-gZ * h).sqrt();
+    if (!sqrt)
+    {
+        throw std::invalid_argument("svdw_map_params: Z does not satisfy the criteria of RFC 9380, H.1");
+    }
+
+    c1 = gZ;
+    c2 = -Z * (FieldT::one() + FieldT::one()).inverse();
+    c3 = (sgn0(*sqrt) ? -*sqrt : *sqrt);
+    c4 = -(gZ + gZ + gZ + gZ) * h.inverse();
+}
+
+/* g(n / d) = gx_num / gx_den for the curve of params */
+template<typename FieldT>
+void svdw_map_gx(const FieldT &n,
+                 const FieldT &d,
+                 const svdw_map_params<FieldT> &params,
+                 FieldT &gx_num,
+                 FieldT &gx_den)
+{
+    const FieldT d2 = d.squared();
+    gx_den = d2 * d;
+    gx_num = (n.squared() + params.A * d2) * n + params.B * gx_den;
+}
+
+template<typename GroupT, typename FieldT>
+GroupT map_to_curve_svdw(const FieldT &u, const svdw_map_params<FieldT> &params)
+{
+    /* RFC 9380, F.1, with every candidate x kept as a fraction: the RFC's
+       x1, x2 = c2 -+ u * c3 / tv2 and x3 = Z + c4 * tv2^2 / tv1^2, except
+       that x1 = x2 = c2 and x3 = Z where tv1 * tv2 = 0 (inv0). */
+    const FieldT one = FieldT::one();
+    const FieldT u2c1 = u.squared() * params.c1;
+    const FieldT tv1 = one - u2c1;
+    const FieldT tv2 = one + u2c1;
+    const bool exceptional = (tv1.is_zero() || tv2.is_zero());
+
+    const FieldT c2_tv2 = params.c2 * tv2;
+    const FieldT c3_u = params.c3 * u;
+    const FieldT tv1_squared = tv1.squared();
+    const FieldT x12_den = (exceptional ? one : tv2);
+    const FieldT x1_num = (exceptional ? params.c2 : c2_tv2 - c3_u);
+    const FieldT x2_num = (exceptional ? params.c2 : c2_tv2 + c3_u);
+    const FieldT x3_den = (exceptional ? one : tv1_squared);
+    const FieldT x3_num = (exceptional ? params.Z : params.Z * tv1_squared + params.c4 * tv2.squared());
+
+    /* every candidate gets a square root, so that the work does not depend
+       on which one is taken; g(x3) is always a square */
+    FieldT gx_num, gx_den, y1, y2, y3;
+    svdw_map_gx(x1_num, x12_den, params, gx_num, gx_den);
+    const bool e1 = sqrt_ratio(gx_num, gx_den, params.sqrt_ratio, y1);
+    svdw_map_gx(x2_num, x12_den, params, gx_num, gx_den);
+    const bool e2 = sqrt_ratio(gx_num, gx_den, params.sqrt_ratio, y2);
+    svdw_map_gx(x3_num, x3_den, params, gx_num, gx_den);
+    sqrt_ratio(gx_num, gx_den, params.sqrt_ratio, y3);
+
+    const FieldT x_num = (e1 ? x1_num : (e2 ? x2_num : x3_num));
+    const FieldT x_den = (e1 || e2 ? x12_den : x3_den);
+    FieldT y = (e1 ? y1 : (e2 ? y2 : y3));
+    const FieldT neg_y = -y;
+    y = (sgn0(u) == sgn0(y) ? y : neg_y);
+
+    /* (x, y) = (X / Z^2, Y / Z^3) for Z = x_den */
+    return GroupT(x_num * x_den, y * x_den.squared() * x_den, x_den);
+}
+
+} // namespace libff
+
+#endif // HASH_TO_CURVE_TCC_
@@ -87,6 +87,7 @@ public:
     friend std::istream& operator>>(std::istream &in, mnt4_G1 &g);
 
     static void batch_to_special_all_non_zeros(std::vector<mnt4_G1> &vec);
+    static void batch_to_special_all_non_zeros(mnt4_G1 *vec, const std::size_t count);
 };
 
 template<mp_size_t m>
@@ -490,18 +490,21 @@ std::istream& operator>>(std::istream& in, std::vector<mnt6_G1> &v)
 
 void mnt6_G1::batch_to_special_all_non_zeros(std::vector<mnt6_G1> &vec)
 {
-    std::vector<mnt6_Fq> Z_vec;
-    Z_vec.reserve(vec.size());
+    batch_to_special_all_non_zeros(vec.data(), vec.size());
+}
 
-    for (auto &el: vec)
+void mnt6_G1::batch_to_special_all_non_zeros(mnt6_G1 *vec, const size_t count)
+{
+    std::vector<mnt6_Fq> Z_vec(count), prod(count);
+    for (size_t i = 0; i < count; ++i)
     {
-        Z_vec.emplace_back(el.Z);
+        Z_vec[i] = vec[i].Z;
     }
-    batch_invert<mnt6_Fq>(Z_vec);
+    batch_invert<mnt6_Fq>(Z_vec.data(), prod.data(), count);
 
     const mnt6_Fq one = mnt6_Fq::one();
 
-    for (size_t i = 0; i < vec.size(); ++i)
+    for (size_t i = 0; i < count; ++i)
     {
         vec[i] = mnt6_G1(vec[i].X * Z_vec[i], vec[i].Y * Z_vec[i], one);
     }
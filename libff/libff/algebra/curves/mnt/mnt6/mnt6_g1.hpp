@@ -87,6 +87,7 @@ public:
     friend std::istream& operator>>(std::istream &in, mnt6_G1 &g);
 
     static void batch_to_special_all_non_zeros(std::vector<mnt6_G1> &vec);
+    static void batch_to_special_all_non_zeros(mnt6_G1 *vec, const std::size_t count);
 };
 
 template<mp_size_t m>
@@ -0,0 +1,104 @@
+/**
+ *****************************************************************************
+ Profiling of the default scalar multiplication (see curve_utils.hpp) against
+ bitwise double-and-add, as scalar_mul was written before it used wNAF, and
+ against fixed_window_scalar_mul, for G1 and G2 of alt_bn128 and bls12_381.
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <cstdio>
+#include <vector>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_pp.hpp>
+#include <libff/algebra/curves/curve_utils.hpp>
+#include <libff/common/profiling.hpp>
+
+using namespace libff;
+
+using std::size_t;
+
+template<typename GroupT, mp_size_t m>
+GroupT double_and_add(const GroupT &base, const bigint<m> &scalar)
+{
+    GroupT result = GroupT::zero();
+
+    bool found_one = false;
+    for (long i = static_cast<long>(scalar.max_bits() - 1); i >= 0; --i)
+    {
+        if (found_one)
+        {
+            result = result.dbl();
+        }
+
+        if (scalar.test_bit(i))
+        {
+            found_one = true;
+            result = result + base;
+        }
+    }
+
+    return result;
+}
+
+template<typename GroupT, typename FieldT>
+void profile_scalar_mul(const char *name, const size_t reps)
+{
+    typedef bigint<FieldT::num_limbs> scalar_t;
+
+    std::vector<GroupT> bases;
+    std::vector<scalar_t> scalars;
+    for (size_t i = 0; i < reps; ++i)
+    {
+        bases.emplace_back(GroupT::random_element());
+        scalars.emplace_back(FieldT::random_element().as_bigint());
+    }
+
+    std::vector<GroupT> expected(reps), answers(reps), fixed(reps);
+
+    long long start_time = get_nsec_time();
+    for (size_t i = 0; i < reps; ++i)
+    {
+        expected[i] = double_and_add(bases[i], scalars[i]);
+    }
+    const long long double_and_add_time = (get_nsec_time() - start_time) / reps;
+
+    start_time = get_nsec_time();
+    for (size_t i = 0; i < reps; ++i)
+    {
+        fixed[i] = fixed_window_scalar_mul<GroupT, FieldT::num_limbs, 5>(bases[i], scalars[i]);
+    }
+    const long long fixed_window_time = (get_nsec_time() - start_time) / reps;
+
+    start_time = get_nsec_time();
+    for (size_t i = 0; i < reps; ++i)
+    {
+        answers[i] = scalar_mul(bases[i], scalars[i]);
+    }
+    const long long wnaf_time = (get_nsec_time() - start_time) / reps;
+
+    if (answers != expected || fixed != expected)
+    {
+        fprintf(stderr, "Answers NOT MATCHING for %s\n", name);
+    }
+
+    printf("%-16s %16lld %16lld %16lld\n", name, double_and_add_time, fixed_window_time, wnaf_time);
+}
+
+int main()
+{
+    inhibit_profiling_info = true;
+
+    alt_bn128_pp::init_public_params();
+    bls12_381_pp::init_public_params();
+
+    printf("%-16s %16s %16s %16s\n", "", "double-add ns", "fixed window ns", "wnaf ns");
+    profile_scalar_mul<alt_bn128_G1, alt_bn128_Fr>("alt_bn128 G1", 1000);
+    profile_scalar_mul<alt_bn128_G2, alt_bn128_Fr>("alt_bn128 G2", 300);
+    profile_scalar_mul<bls12_381_G1, bls12_381_Fr>("bls12_381 G1", 1000);
+    profile_scalar_mul<bls12_381_G2, bls12_381_Fr>("bls12_381 G2", 300);
+
+    return 0;
+}
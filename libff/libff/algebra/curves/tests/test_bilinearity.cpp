@@ -4,15 +4,21 @@
  *             and contributors (see AUTHORS).
  * @copyright  MIT license (see LICENSE file)
  *****************************************************************************/
+#include <functional>
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <libff/algebra/curves/edwards/edwards_pp.hpp>
+#include <libff/common/parallel.hpp>
 #include <libff/common/profiling.hpp>
 #ifdef CURVE_BN128
 #include <libff/algebra/curves/bn128/bn128_pp.hpp>
 #include <libff/algebra/curves/bn128/bn128_pp.hpp>
 #endif
+#include <libff/algebra/curves/alt_bn128/alt_bn128_flat_fq12.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_batch_verify.hpp>
 #include <libff/algebra/curves/bls12_381/bls12_381_pp.hpp>
 #include <libff/algebra/curves/mnt/mnt4/mnt4_pp.hpp>
 #include <libff/algebra/curves/mnt/mnt6/mnt6_pp.hpp>
@@ -93,6 +99,312 @@ void double_miller_loop_test()
     EXPECT_EQ(ans_1 * ans_2, ans_12);
 }
 
+void bls12_381_multi_miller_loop_test()
+{
+    std::vector<bls12_381_G1_precomp> prec_P;
+    std::vector<bls12_381_G2_precomp> prec_Q;
+    bls12_381_Fq12 expected = bls12_381_Fq12::one();
+    EXPECT_EQ(bls12_381_multi_miller_loop(prec_P, prec_Q), expected);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const bls12_381_G1 P = bls12_381_Fr::random_element() * bls12_381_G1::one();
+        const bls12_381_G2 Q = bls12_381_Fr::random_element() * bls12_381_G2::one();
+        prec_P.emplace_back(bls12_381_precompute_G1(P));
+        prec_Q.emplace_back(bls12_381_precompute_G2(Q));
+
+        expected *= bls12_381_miller_loop(prec_P.back(), prec_Q.back());
+        EXPECT_EQ(bls12_381_multi_miller_loop(prec_P, prec_Q), expected);
+    }
+}
+
+void alt_bn128_multi_miller_loop_test()
+{
+    std::vector<alt_bn128_G1_precomp> prec_P;
+    std::vector<alt_bn128_G2_precomp> prec_Q;
+    alt_bn128_Fq12 expected = alt_bn128_Fq12::one();
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const alt_bn128_G1 P = alt_bn128_Fr::random_element() * alt_bn128_G1::one();
+        const alt_bn128_G2 Q = alt_bn128_Fr::random_element() * alt_bn128_G2::one();
+        prec_P.emplace_back(alt_bn128_precompute_G1(P));
+        prec_Q.emplace_back(alt_bn128_precompute_G2(Q));
+
+        expected *= alt_bn128_miller_loop(prec_P.back(), prec_Q.back());
+        EXPECT_EQ(alt_bn128_final_exponentiation(alt_bn128_multi_miller_loop(prec_P, prec_Q)),
+                  alt_bn128_final_exponentiation(expected));
+    }
+}
+
+template<typename G1T, typename G2T, typename G1PrecompT, typename G2PrecompT, typename GTT, typename Fq12T>
+void batch_precompute_G2_test(const std::size_t min_points,
+                              G1PrecompT (*precompute_G1)(const G1T&),
+                              G2PrecompT (*precompute_G2)(const G2T&),
+                              std::vector<G2PrecompT> (*affine_batch_precompute_G2)(const std::vector<G2T>&),
+                              std::vector<G2PrecompT> (*batch_precompute_G2)(const std::vector<G2T>&),
+                              Fq12T (*miller_loop)(const G1PrecompT&, const G2PrecompT&),
+                              GTT (*final_exponentiation)(const Fq12T&))
+{
+    std::vector<G2T> Q;
+    for (std::size_t i = 0; i < min_points + 2; ++i)
+    {
+        Q.emplace_back(G2T::random_element() + G2T::random_element());
+    }
+    const G1PrecompT prec_P = precompute_G1(G1T::random_element());
+
+    const std::vector<G2PrecompT> affine = affine_batch_precompute_G2(Q);
+    EXPECT_EQ(batch_precompute_G2(Q), affine);
+    ASSERT_EQ(affine.size(), Q.size());
+    for (std::size_t j = 0; j < Q.size(); ++j)
+    {
+        const G2PrecompT projective = precompute_G2(Q[j]);
+        EXPECT_EQ(affine[j].QX, projective.QX);
+        EXPECT_EQ(affine[j].QY, projective.QY);
+        EXPECT_EQ(affine[j].coeffs.size(), projective.coeffs.size());
+        EXPECT_EQ(final_exponentiation(miller_loop(prec_P, affine[j])),
+                  final_exponentiation(miller_loop(prec_P, projective)));
+    }
+
+    const std::vector<G2T> few(Q.begin(), Q.begin() + 2);
+    EXPECT_EQ(batch_precompute_G2(few), std::vector<G2PrecompT>({ precompute_G2(few[0]), precompute_G2(few[1]) }));
+    EXPECT_TRUE(batch_precompute_G2({}).empty());
+}
+
+void alt_bn128_pairing_product_test()
+{
+    typedef std::pair<alt_bn128_G1, alt_bn128_G2> pair_type;
+    std::vector<pair_type> pairs;
+    EXPECT_TRUE(alt_bn128_pairing_product_is_one(pairs));
+
+    const alt_bn128_Fr a = alt_bn128_Fr::random_element();
+    const alt_bn128_Fr b = alt_bn128_Fr::random_element();
+    const alt_bn128_G1 P = alt_bn128_Fr::random_element() * alt_bn128_G1::one();
+    const alt_bn128_G2 Q = alt_bn128_Fr::random_element() * alt_bn128_G2::one();
+
+    pairs.emplace_back(P, Q);
+    EXPECT_FALSE(alt_bn128_pairing_product_is_one(pairs));
+    pairs.emplace_back(-P, Q);
+    EXPECT_TRUE(alt_bn128_pairing_product_is_one(pairs));
+
+    /* e(aP, bQ) * e(-abP, Q) */
+    pairs = { pair_type(a * P, b * Q), pair_type(-(a * b) * P, Q) };
+    EXPECT_TRUE(alt_bn128_pairing_product_is_one(pairs));
+    pairs.emplace_back(alt_bn128_G1::zero(), Q);
+    pairs.emplace_back(P, alt_bn128_G2::zero());
+    EXPECT_TRUE(alt_bn128_pairing_product_is_one(pairs));
+    pairs[1].first = -(a * b + alt_bn128_Fr::one()) * P;
+    EXPECT_FALSE(alt_bn128_pairing_product_is_one(pairs));
+
+    pairs = { pair_type(alt_bn128_G1::zero(), alt_bn128_G2::zero()) };
+    EXPECT_TRUE(alt_bn128_pairing_product_is_one(pairs));
+
+    /* enough pairs for the affine G2 precomputation: e(a_1 P, b_1 Q) * ... * e(-(a_1 b_1 + ...) P, Q) */
+    pairs.clear();
+    alt_bn128_Fr sum = alt_bn128_Fr::zero();
+    for (size_t i = 0; i < alt_bn128_affine_ate_min_points; ++i)
+    {
+        const alt_bn128_Fr a_i = alt_bn128_Fr::random_element();
+        const alt_bn128_Fr b_i = alt_bn128_Fr::random_element();
+        pairs.emplace_back(a_i * P, b_i * Q);
+        sum += a_i * b_i;
+    }
+    pairs.emplace_back(-sum * P, Q);
+    EXPECT_TRUE(alt_bn128_pairing_product_is_one(pairs));
+    pairs.back().first = -(sum + alt_bn128_Fr::one()) * P;
+    EXPECT_FALSE(alt_bn128_pairing_product_is_one(pairs));
+}
+
+/* Runs each task on its own thread, in reverse order, to check that slices do not depend on each other. */
+parallel_executor thread_per_task_executor()
+{
+    parallel_executor executor;
+    executor.concurrency = 3;
+    executor.run = [](const size_t num_tasks, const std::function<void(size_t)> &task) {
+        std::vector<std::thread> threads;
+        for (size_t i = num_tasks; i-- > 0; )
+        {
+            threads.emplace_back(task, i);
+        }
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+    };
+    return executor;
+}
+
+void alt_bn128_multi_pairing_test()
+{
+    typedef std::pair<alt_bn128_G1, alt_bn128_G2> pair_type;
+    const alt_bn128_G1 P = alt_bn128_Fr::random_element() * alt_bn128_G1::one();
+    const alt_bn128_G2 Q = alt_bn128_Fr::random_element() * alt_bn128_G2::one();
+
+    /* more pairs than slices, some slices with a single pair after the zero pairs are skipped */
+    std::vector<pair_type> pairs;
+    alt_bn128_GT expected = alt_bn128_GT::one();
+    alt_bn128_Fr sum = alt_bn128_Fr::zero();
+    for (size_t i = 0; i < 7; ++i)
+    {
+        const alt_bn128_Fr a_i = alt_bn128_Fr::random_element();
+        const alt_bn128_Fr b_i = alt_bn128_Fr::random_element();
+        pairs.emplace_back(a_i * P, b_i * Q);
+        expected = expected * alt_bn128_reduced_pairing(a_i * P, b_i * Q);
+        sum += a_i * b_i;
+    }
+    pairs.emplace_back(alt_bn128_G1::zero(), Q);
+
+    for (const parallel_executor &executor : { default_parallel_executor(), thread_per_task_executor() })
+    {
+        set_parallel_executor(executor);
+        for (const size_t min_parallel_pairs : { (size_t) 1, alt_bn128_parallel_pairing_min_pairs, pairs.size() + 1 })
+        {
+            EXPECT_EQ(alt_bn128_multi_pairing(pairs, min_parallel_pairs), expected);
+
+            std::vector<pair_type> product_is_one(pairs);
+            product_is_one.emplace_back(-sum * P, Q);
+            EXPECT_TRUE(alt_bn128_pairing_product_is_one(product_is_one, min_parallel_pairs));
+            product_is_one.back().first = -(sum + alt_bn128_Fr::one()) * P;
+            EXPECT_FALSE(alt_bn128_pairing_product_is_one(product_is_one, min_parallel_pairs));
+        }
+        EXPECT_EQ(alt_bn128_multi_pairing({ pair_type(P, Q), pair_type(-P, Q) }, 1), alt_bn128_GT::one());
+        EXPECT_EQ(alt_bn128_multi_pairing({}), alt_bn128_GT::one());
+    }
+    set_parallel_executor(default_parallel_executor());
+}
+
+/* The members of alt_bn128_flat_Fq12, in the form of alt_bn128_flat_Fq12_portable. */
+struct alt_bn128_flat_Fq12_members {
+    static void mul_into(const alt_bn128_flat_Fq12 &x, const alt_bn128_flat_Fq12 &y, alt_bn128_flat_Fq12 &result)
+    {
+        x.mul_into(y, result);
+    }
+    static void square_inplace(alt_bn128_flat_Fq12 &x) { x.square_inplace(); }
+    static void cyclotomic_square_inplace(alt_bn128_flat_Fq12 &x) { x.cyclotomic_square_inplace(); }
+    static void mul_by_024_inplace(alt_bn128_flat_Fq12 &x,
+                                   const alt_bn128_Fq2 &ell_0,
+                                   const alt_bn128_Fq2 &ell_VW,
+                                   const alt_bn128_Fq2 &ell_VV)
+    {
+        x.mul_by_024_inplace(ell_0, ell_VW, ell_VV);
+    }
+    static void unitary_inverse_inplace(alt_bn128_flat_Fq12 &x) { x.unitary_inverse_inplace(); }
+    static void frobenius_inplace(alt_bn128_flat_Fq12 &x, const unsigned long power) { x.frobenius_inplace(power); }
+    static alt_bn128_flat_Fq12 cyclotomic_exp(const alt_bn128_flat_Fq12 &x, const bigint<alt_bn128_q_limbs> &exponent)
+    {
+        return x.cyclotomic_exp(exponent);
+    }
+};
+
+/* The flat operations of FlatOps against the generic tower. */
+template<typename FlatOps>
+void alt_bn128_flat_fq12_ops_test()
+{
+    for (size_t i = 0; i < 10; ++i)
+    {
+        /* include zero, -1 and the largest coefficients through negation */
+        const alt_bn128_Fq12 a = (i == 0 ? alt_bn128_Fq12::zero() : alt_bn128_Fq12::random_element());
+        const alt_bn128_Fq12 b = (i == 1 ? -alt_bn128_Fq12::one() : -alt_bn128_Fq12::random_element());
+        const alt_bn128_flat_Fq12 flat_a(a), flat_b(b);
+        EXPECT_EQ(flat_a.to_Fq12(), a);
+
+        alt_bn128_flat_Fq12 r;
+        FlatOps::mul_into(flat_a, flat_b, r);
+        EXPECT_EQ(r.to_Fq12(), a * b);
+        r = flat_a;
+        FlatOps::mul_into(r, r, r);
+        EXPECT_EQ(r.to_Fq12(), a * a);
+        r = flat_a;
+        FlatOps::square_inplace(r);
+        EXPECT_EQ(r.to_Fq12(), a.squared());
+
+        const alt_bn128_Fq2 ell_0 = alt_bn128_Fq2::random_element();
+        const alt_bn128_Fq2 ell_VW = alt_bn128_Fq2::random_element();
+        const alt_bn128_Fq2 ell_VV = alt_bn128_Fq2::random_element();
+        r = flat_a;
+        FlatOps::mul_by_024_inplace(r, ell_0, ell_VW, ell_VV);
+        EXPECT_EQ(r.to_Fq12(), a.mul_by_024(ell_0, ell_VW, ell_VV));
+
+        r = flat_a;
+        FlatOps::unitary_inverse_inplace(r);
+        EXPECT_EQ(r.to_Fq12(), a.unitary_inverse());
+        for (unsigned long power = 0; power < 12; ++power)
+        {
+            r = flat_a;
+            FlatOps::frobenius_inplace(r, power);
+            EXPECT_EQ(r.to_Fq12(), a.Frobenius_map(power));
+        }
+
+        /* an element of the cyclotomic subgroup */
+        alt_bn128_Fq12 c = (i == 0 ? alt_bn128_Fq12::one() : a.unitary_inverse() * a.inverse());
+        c = c.Frobenius_map(2) * c;
+        const alt_bn128_flat_Fq12 flat_c(c);
+        r = flat_c;
+        FlatOps::cyclotomic_square_inplace(r);
+        EXPECT_EQ(r.to_Fq12(), c.cyclotomic_squared());
+        const alt_bn128_flat_Fq12 flat_c_z = FlatOps::cyclotomic_exp(flat_c, alt_bn128_final_exponent_z);
+        EXPECT_EQ(flat_c_z.to_Fq12(), c.cyclotomic_exp(alt_bn128_final_exponent_z));
+        EXPECT_TRUE(flat_c_z == alt_bn128_flat_Fq12(c.cyclotomic_exp(alt_bn128_final_exponent_z)));
+        EXPECT_EQ(flat_c != flat_a, c != a);
+    }
+}
+
+void alt_bn128_flat_fq12_test()
+{
+    EXPECT_EQ(alignof(alt_bn128_flat_Fq12), 64u);
+    EXPECT_EQ(alt_bn128_flat_Fq12::one().to_Fq12(), alt_bn128_Fq12::one());
+
+    alt_bn128_flat_fq12_ops_test<alt_bn128_flat_Fq12_members>();
+    /* the mpn kernels, which the members only use where the intrinsics are unavailable */
+    alt_bn128_flat_fq12_ops_test<alt_bn128_flat_Fq12_portable>();
+}
+
+bls12_381_signed_message bls12_381_random_signed_message()
+{
+    const bls12_381_Fr sk = bls12_381_Fr::random_element();
+    const bls12_381_G2 H = bls12_381_Fr::random_element() * bls12_381_G2::one();
+    return { sk * bls12_381_G1::one(), H, sk * H };
+}
+
+void bls12_381_batch_verify_test()
+{
+    std::vector<bls12_381_signed_message> batch;
+    EXPECT_TRUE(bls12_381_batch_verify_signatures(batch));
+    EXPECT_TRUE(bls12_381_find_invalid_signatures(batch).empty());
+
+    for (size_t i = 0; i < 9; ++i)
+    {
+        batch.emplace_back(bls12_381_random_signed_message());
+        EXPECT_TRUE(bls12_381_verify_signature(batch.back()));
+    }
+    EXPECT_TRUE(bls12_381_batch_verify_signatures(batch));
+    EXPECT_TRUE(bls12_381_find_invalid_signatures(batch).empty());
+
+    /* a single signature over another message */
+    batch[4].signature = batch[3].signature;
+    EXPECT_FALSE(bls12_381_verify_signature(batch[4]));
+    EXPECT_FALSE(bls12_381_batch_verify_signatures(batch));
+    EXPECT_EQ(bls12_381_find_invalid_signatures(batch), std::vector<size_t>({ 4 }));
+
+    /* two invalid signatures whose errors cancel out in the plain sum */
+    batch[4] = bls12_381_random_signed_message();
+    const bls12_381_G2 delta = bls12_381_Fr::random_element() * bls12_381_G2::one();
+    batch[1].signature = batch[1].signature + delta;
+    batch[7].signature = batch[7].signature - delta;
+    EXPECT_FALSE(bls12_381_batch_verify_signatures(batch));
+    EXPECT_EQ(bls12_381_find_invalid_signatures(batch), std::vector<size_t>({ 1, 7 }));
+
+    /* a public key at infinity with the signature at infinity */
+    batch[1] = bls12_381_random_signed_message();
+    batch[7] = bls12_381_random_signed_message();
+    batch[0].public_key = bls12_381_G1::zero();
+    batch[0].signature = bls12_381_G2::zero();
+    EXPECT_FALSE(bls12_381_verify_signature(batch[0]));
+    EXPECT_FALSE(bls12_381_batch_verify_signatures(batch));
+    batch[8].signature = bls12_381_G2::one();
+    EXPECT_EQ(bls12_381_find_invalid_signatures(batch), std::vector<size_t>({ 0, 8 }));
+}
+
 template<typename ppT>
 void affine_pairing_test()
 {
@@ -151,6 +463,74 @@ TEST_F(CurveBilinearityTest, DoubleMillerLoopTest)
 #endif
 }
 
+TEST_F(CurveBilinearityTest, MultiMillerLoopTest)
+{
+    alt_bn128_multi_miller_loop_test();
+    bls12_381_multi_miller_loop_test();
+}
+
+TEST_F(CurveBilinearityTest, AltBn128LoopCountNafTest)
+{
+    mpz_t sum, loop_count;
+    mpz_init(sum);
+    mpz_init(loop_count);
+    for (long i = alt_bn128_ate_loop_count_naf_size - 1; i >= 0; --i)
+    {
+        const signed char digit = alt_bn128_ate_loop_count_naf[i];
+        EXPECT_TRUE(digit == 0 || digit == 1 || digit == -1);
+        if (i > 0)
+        {
+            EXPECT_TRUE(digit == 0 || alt_bn128_ate_loop_count_naf[i - 1] == 0);
+        }
+        mpz_mul_2exp(sum, sum, 1);
+        if (digit > 0)
+        {
+            mpz_add_ui(sum, sum, 1);
+        }
+        else if (digit < 0)
+        {
+            mpz_sub_ui(sum, sum, 1);
+        }
+    }
+    EXPECT_EQ(alt_bn128_ate_loop_count_naf[alt_bn128_ate_loop_count_naf_size - 1], 1);
+    alt_bn128_ate_loop_count.to_mpz(loop_count);
+    EXPECT_EQ(mpz_cmp(sum, loop_count), 0);
+    mpz_clear(loop_count);
+    mpz_clear(sum);
+}
+
+TEST_F(CurveBilinearityTest, BatchPrecomputeG2Test)
+{
+    batch_precompute_G2_test(alt_bn128_affine_ate_min_points,
+                             alt_bn128_precompute_G1, alt_bn128_precompute_G2,
+                             alt_bn128_affine_ate_batch_precompute_G2, alt_bn128_batch_precompute_G2,
+                             alt_bn128_miller_loop, alt_bn128_final_exponentiation);
+    batch_precompute_G2_test(bls12_381_affine_ate_min_points,
+                             bls12_381_precompute_G1, bls12_381_precompute_G2,
+                             bls12_381_affine_ate_batch_precompute_G2, bls12_381_batch_precompute_G2,
+                             bls12_381_miller_loop, bls12_381_final_exponentiation);
+}
+
+TEST_F(CurveBilinearityTest, PairingProductTest)
+{
+    alt_bn128_pairing_product_test();
+}
+
+TEST_F(CurveBilinearityTest, MultiPairingTest)
+{
+    alt_bn128_multi_pairing_test();
+}
+
+TEST_F(CurveBilinearityTest, FlatFq12Test)
+{
+    alt_bn128_flat_fq12_test();
+}
+
+TEST_F(CurveBilinearityTest, BatchVerifyTest)
+{
+    bls12_381_batch_verify_test();
+}
+
 TEST_F(CurveBilinearityTest, AffinePairingTest)
 {
     affine_pairing_test<mnt6_pp>();
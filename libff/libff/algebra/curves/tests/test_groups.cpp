@@ -4,6 +4,10 @@
  *             and contributors (see AUTHORS).
  * @copyright  MIT license (see LICENSE file)
  *****************************************************************************/
+#include <atomic>
+#include <functional>
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <libff/algebra/curves/edwards/edwards_pp.hpp>
@@ -14,10 +18,17 @@
 #ifdef CURVE_BN128
 #include <libff/algebra/curves/bn128/bn128_pp.hpp>
 #endif
+#include <fstream>
 #include <sstream>
 
+#include <unistd.h>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_binary_serialization.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
 #include <libff/algebra/curves/bls12_381/bls12_381_pp.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include <libff/common/binary_file_view.hpp>
+#include <libff/common/parallel.hpp>
 
 using namespace libff;
 
@@ -139,6 +150,224 @@ void test_mul_by_q()
     EXPECT_EQ(GroupT::field_char() * a, a.mul_by_q());
 }
 
+template<typename GroupT>
+void test_scalar_mul()
+{
+    typedef bigint<GroupT::scalar_field::num_limbs> scalar_bigint;
+
+    const GroupT a = GroupT::random_element();
+    const scalar_bigint scalars[] = {
+        scalar_bigint(0ul), scalar_bigint(1ul), scalar_bigint(5ul), scalar_bigint(1000ul), scalar_bigint(0xfffffffful),
+        GroupT::order(),
+        GroupT::scalar_field::random_element().as_bigint(),
+        GroupT::scalar_field::random_element().as_bigint(),
+    };
+    for (const scalar_bigint &s : scalars)
+    {
+        /* double-and-add */
+        GroupT expected = GroupT::zero();
+        for (long i = static_cast<long>(s.max_bits() - 1); i >= 0; --i)
+        {
+            expected = expected.dbl();
+            if (s.test_bit(i))
+            {
+                expected = expected + a;
+            }
+        }
+
+        EXPECT_EQ(scalar_mul<GroupT>(a, s), expected);
+        EXPECT_EQ(scalar_mul<GroupT>(GroupT::zero(), s), GroupT::zero());
+        EXPECT_EQ((fixed_window_wnaf_exp<1>(a, s)), expected);
+        EXPECT_EQ((fixed_window_wnaf_exp<3>(a, s)), expected);
+        EXPECT_EQ((fixed_window_wnaf_exp<wnaf_max_window>(a, s)), expected);
+    }
+    EXPECT_EQ(scalar_mul<GroupT>(a, GroupT::order()), GroupT::zero());
+}
+
+void test_find_wnaf()
+{
+    typedef bigint<4> scalar_bigint;
+
+    scalar_bigint all_ones;
+    for (mp_size_t i = 0; i < scalar_bigint::N; ++i)
+    {
+        all_ones.data[i] = ~mp_limb_t(0);
+    }
+    const scalar_bigint scalars[] = {
+        scalar_bigint(0ul), scalar_bigint(1ul), scalar_bigint(0xfffffffful), all_ones,
+        alt_bn128_Fr::random_element().as_bigint(),
+    };
+
+    mpz_t value, expected;
+    mpz_init(value);
+    mpz_init(expected);
+    for (const scalar_bigint &s : scalars)
+    {
+        s.to_mpz(expected);
+        for (size_t window = 1; window <= wnaf_max_window; ++window)
+        {
+            int8_t digits[wnaf_max_digits<scalar_bigint::N>()];
+            const size_t num_digits = find_wnaf(window, s, digits);
+            EXPECT_TRUE(num_digits == 0 || digits[num_digits - 1] != 0);
+
+            /* odd digits below 2^window, each followed by at least window zeros */
+            mpz_set_ui(value, 0);
+            size_t last_non_zero = 0;
+            for (size_t i = num_digits; i-- > 0; )
+            {
+                mpz_mul_2exp(value, value, 1);
+                const int d = digits[i];
+                if (d == 0)
+                {
+                    continue;
+                }
+                EXPECT_TRUE(d % 2 != 0);
+                EXPECT_LT(d < 0 ? -d : d, 1 << window);
+                EXPECT_TRUE(i + 1 == num_digits || last_non_zero - i > window);
+                last_non_zero = i;
+                if (d > 0)
+                {
+                    mpz_add_ui(value, value, d);
+                }
+                else
+                {
+                    mpz_sub_ui(value, value, -d);
+                }
+            }
+            EXPECT_EQ(mpz_cmp(value, expected), 0);
+
+            const std::vector<long> naf = find_wnaf(window, s);
+            EXPECT_EQ(naf.size(), s.max_bits() + 1);
+            for (size_t i = 0; i < naf.size(); ++i)
+            {
+                EXPECT_EQ(naf[i], i < num_digits ? digits[i] : 0);
+            }
+        }
+    }
+    mpz_clear(expected);
+    mpz_clear(value);
+}
+
+template<typename GroupT>
+void test_fixed_window_scalar_mul()
+{
+    typedef bigint<GroupT::scalar_field::num_limbs> scalar_bigint;
+
+    const GroupT a = GroupT::random_element();
+    scalar_bigint all_ones;
+    for (mp_size_t i = 0; i < scalar_bigint::N; ++i)
+    {
+        all_ones.data[i] = ~mp_limb_t(0);
+    }
+
+    const scalar_bigint scalars[] = {
+        scalar_bigint(0ul), scalar_bigint(1ul), scalar_bigint(2ul), scalar_bigint(15ul), scalar_bigint(16ul),
+        GroupT::order(), all_ones,
+        GroupT::scalar_field::random_element().as_bigint(),
+        GroupT::scalar_field::random_element().as_bigint(),
+    };
+    for (const scalar_bigint &s : scalars)
+    {
+        const GroupT expected = scalar_mul<GroupT>(a, s);
+        EXPECT_EQ((fixed_window_scalar_mul<GroupT, scalar_bigint::N, 1>(a, s)), expected);
+        EXPECT_EQ((fixed_window_scalar_mul<GroupT, scalar_bigint::N, 4>(a, s)), expected);
+        EXPECT_EQ((fixed_window_scalar_mul<GroupT, scalar_bigint::N, 5>(a, s)), expected);
+    }
+    EXPECT_EQ((fixed_window_scalar_mul<GroupT, scalar_bigint::N, 4>(GroupT::zero(), all_ones)), GroupT::zero());
+}
+
+/* points of E(Fq) and E'(Fq2) that are not (in general) in the order-r subgroup */
+bls12_381_G1 bls12_381_random_curve_point_G1()
+{
+    while (true)
+    {
+        const bls12_381_Fq x = bls12_381_Fq::random_element();
+        const std::optional<bls12_381_Fq> y = (x.squared() * x + bls12_381_coeff_b).sqrt();
+        if (y)
+        {
+            return bls12_381_G1(x, *y, bls12_381_Fq::one());
+        }
+    }
+}
+
+bls12_381_G2 bls12_381_random_curve_point_G2()
+{
+    while (true)
+    {
+        const bls12_381_Fq2 x = bls12_381_Fq2::random_element();
+        const std::optional<bls12_381_Fq2> y = (x.squared() * x + bls12_381_twist_coeff_b).sqrt();
+        if (y)
+        {
+            return bls12_381_G2(x, *y, bls12_381_Fq2::one());
+        }
+    }
+}
+
+alt_bn128_G2 alt_bn128_random_curve_point_G2()
+{
+    while (true)
+    {
+        const alt_bn128_Fq2 x = alt_bn128_Fq2::random_element();
+        const std::optional<alt_bn128_Fq2> y = (x.squared() * x + alt_bn128_twist_coeff_b).sqrt();
+        if (y)
+        {
+            return alt_bn128_G2(x, *y, alt_bn128_Fq2::one());
+        }
+    }
+}
+
+template<typename GroupT>
+void test_subgroup_check(GroupT (*random_curve_point)(), const unsigned long small_order)
+{
+    EXPECT_TRUE(GroupT::zero().is_in_safe_subgroup());
+    EXPECT_TRUE(GroupT::one().is_in_safe_subgroup());
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+        const GroupT P = GroupT::random_element();
+        EXPECT_TRUE(P.is_in_safe_subgroup());
+
+        const GroupT R = random_curve_point();
+        EXPECT_TRUE(R.is_well_formed());
+        EXPECT_EQ(R.is_in_safe_subgroup(), (GroupT::order() * R).is_zero());
+        EXPECT_FALSE(R.is_in_safe_subgroup());
+        EXPECT_TRUE(R.mul_by_cofactor().is_in_safe_subgroup());
+    }
+
+    /* P + T for T of a small order dividing the cofactor: clear every other
+       factor of the group order, then multiply down to exact order. */
+    mpz_t n, h;
+    mpz_init(n);
+    mpz_init(h);
+    GroupT::order().to_mpz(n);
+    GroupT::h.to_mpz(h);
+    mpz_mul(n, n, h);
+    while (mpz_divisible_ui_p(n, small_order))
+    {
+        mpz_divexact_ui(n, n, small_order);
+    }
+    const bigint<GroupT::h_limbs + GroupT::scalar_field::num_limbs> other_factors(n);
+    mpz_clear(h);
+    mpz_clear(n);
+
+    GroupT T = GroupT::zero();
+    while (T.is_zero())
+    {
+        T = other_factors * random_curve_point();
+    }
+    while (!(bigint<1>(small_order) * T).is_zero())
+    {
+        T = bigint<1>(small_order) * T;
+    }
+    EXPECT_EQ(bigint<1>(small_order) * T, GroupT::zero());
+    EXPECT_FALSE(T.is_in_safe_subgroup());
+    EXPECT_FALSE((GroupT::random_element() + T).is_in_safe_subgroup());
+
+    /* the odd multiples in the table of scalar_mul run into zero */
+    const bigint<GroupT::scalar_field::num_limbs> s = GroupT::scalar_field::random_element().as_bigint();
+    EXPECT_EQ(s * T, bigint<1>(mpn_mod_1(s.data, s.N, small_order)) * T);
+}
+
 template<typename GroupT>
 void test_output()
 {
@@ -157,6 +386,120 @@ void test_output()
     }
 }
 
+template<typename T>
+void test_binary_serialization(const std::vector<T> &v)
+{
+    for (const binary_encoding encoding : { binary_montgomery, binary_canonical })
+    {
+        for (const binary_point_form form : { binary_projective, binary_affine })
+        {
+            binary_format fmt;
+            fmt.encoding = encoding;
+            fmt.form = form;
+
+            std::vector<unsigned char> buf(binary_size<T>(v.size(), fmt));
+            write_binary(buf.data(), v.data(), v.size(), fmt);
+
+            std::vector<T> w;
+            EXPECT_TRUE(read_binary(buf.data(), buf.size(), w));
+            EXPECT_EQ(v, w);
+
+            std::stringstream ss;
+            write_binary(ss, v, fmt);
+            EXPECT_EQ(ss.str(), std::string(buf.begin(), buf.end()));
+            w.clear();
+            EXPECT_TRUE(read_binary(ss, w));
+            EXPECT_EQ(v, w);
+
+            /* records in place */
+            size_t count = 0;
+            const T *native = binary_native_data<T>(buf.data(), buf.size(), count);
+            EXPECT_EQ(native != nullptr, binary_traits<T>::is_native(fmt) && binary_host_is_native());
+            if (native != nullptr)
+            {
+                EXPECT_EQ(std::vector<T>(native, native + count), v);
+            }
+            EXPECT_EQ(binary_native_data<T>(buf.data(), buf.size(), count, false), native);
+
+            /* truncated buffers */
+            EXPECT_FALSE(read_binary(buf.data(), buf.size() - 1, w));
+            EXPECT_FALSE(read_binary(buf.data(), binary_header::size - 1, w));
+        }
+    }
+}
+
+void test_alt_bn128_binary_serialization()
+{
+    std::vector<alt_bn128_Fq> fq;
+    std::vector<alt_bn128_Fq2> fq2;
+    std::vector<alt_bn128_Fq12> fq12;
+    std::vector<alt_bn128_G1> g1 = { alt_bn128_G1::zero(), alt_bn128_G1::one() };
+    std::vector<alt_bn128_G2> g2 = { alt_bn128_G2::zero(), alt_bn128_G2::one() };
+    std::vector<alt_bn128_ate_G2_precomp> prec_Q;
+    for (size_t i = 0; i < 5; ++i)
+    {
+        fq.emplace_back(alt_bn128_Fq::random_element());
+        fq2.emplace_back(alt_bn128_Fq2::random_element());
+        fq12.emplace_back(alt_bn128_Fq12::random_element());
+        g1.emplace_back(alt_bn128_G1::random_element());
+        g2.emplace_back(alt_bn128_G2::random_element());
+        prec_Q.emplace_back(alt_bn128_ate_precompute_G2(alt_bn128_G2::random_element()));
+    }
+
+    test_binary_serialization(fq);
+    test_binary_serialization(fq2);
+    test_binary_serialization(fq12);
+    test_binary_serialization(g1);
+    test_binary_serialization(g2);
+    test_binary_serialization(prec_Q);
+    test_binary_serialization(std::vector<alt_bn128_G1>());
+
+    std::vector<unsigned char> buf(binary_size<alt_bn128_G1>(g1.size()));
+    write_binary(buf.data(), g1.data(), g1.size());
+    std::vector<alt_bn128_G1> w;
+
+    /* another kind, or the same kind over another field */
+    std::vector<alt_bn128_G2> w2;
+    EXPECT_FALSE(read_binary(buf.data(), buf.size(), w2));
+    std::vector<unsigned char> fq_buf(binary_size<alt_bn128_Fq>(fq.size()));
+    write_binary(fq_buf.data(), fq.data(), fq.size());
+    std::vector<bls12_381_Fq> bls_fq;
+    EXPECT_FALSE(read_binary(fq_buf.data(), fq_buf.size(), bls_fq));
+
+    /* a coordinate that is not reduced, also in place unless the caller trusts the buffer */
+    std::vector<unsigned char> bad = buf;
+    std::memset(bad.data() + binary_header::size, 0xff, 32);
+    EXPECT_FALSE(read_binary(bad.data(), bad.size(), w));
+    if (binary_host_is_native())
+    {
+        size_t count = 0;
+        EXPECT_EQ(binary_native_data<alt_bn128_G1>(bad.data(), bad.size(), count), nullptr);
+        EXPECT_NE(binary_native_data<alt_bn128_G1>(bad.data(), bad.size(), count, false), nullptr);
+    }
+
+    /* another version */
+    bad = buf;
+    bad[4] = 2;
+    EXPECT_FALSE(read_binary(bad.data(), bad.size(), w));
+
+    /* streams whose header claims more records than they hold, or than memory can */
+    for (const uint64_t count : { (uint64_t)g1.size() + 1, (uint64_t)1 << 60, UINT64_MAX })
+    {
+        bad = buf;
+        for (size_t i = 0; i < 8; ++i)
+        {
+            bad[32 + i] = (unsigned char)(count >> (8 * i));
+        }
+        std::stringstream ss(std::string(bad.begin(), bad.end()));
+        EXPECT_FALSE(read_binary(ss, w));
+
+        /* and with a bad magic, which is rejected before the count is used */
+        bad[0] = 'X';
+        std::stringstream bad_magic(std::string(bad.begin(), bad.end()));
+        EXPECT_FALSE(read_binary(bad_magic, w));
+    }
+}
+
 TEST_F(CurveGroupsTest, GroupTest)
 {
     test_group<G1<edwards_pp> >();
@@ -180,6 +523,47 @@ TEST_F(CurveGroupsTest, GroupTest)
 #endif
 }
 
+TEST_F(CurveGroupsTest, ScalarMulTest)
+{
+    test_scalar_mul<G1<edwards_pp> >();
+    test_scalar_mul<G2<edwards_pp> >();
+
+    test_scalar_mul<G1<mnt4_pp> >();
+    test_scalar_mul<G2<mnt4_pp> >();
+
+    test_scalar_mul<G1<mnt6_pp> >();
+    test_scalar_mul<G2<mnt6_pp> >();
+
+    test_scalar_mul<G1<alt_bn128_pp> >();
+    test_scalar_mul<G2<alt_bn128_pp> >();
+
+    test_scalar_mul<G1<bls12_381_pp> >();
+    test_scalar_mul<G2<bls12_381_pp> >();
+}
+
+TEST_F(CurveGroupsTest, FindWnafTest)
+{
+    test_find_wnaf();
+}
+
+TEST_F(CurveGroupsTest, FixedWindowScalarMulTest)
+{
+    test_fixed_window_scalar_mul<G1<mnt4_pp> >();
+    test_fixed_window_scalar_mul<G2<mnt4_pp> >();
+
+    test_fixed_window_scalar_mul<G1<alt_bn128_pp> >();
+    test_fixed_window_scalar_mul<G2<alt_bn128_pp> >();
+
+    test_fixed_window_scalar_mul<G1<bls12_381_pp> >();
+    test_fixed_window_scalar_mul<G2<bls12_381_pp> >();
+}
+
+TEST_F(CurveGroupsTest, SubgroupCheckTest)
+{
+    test_subgroup_check<G1<bls12_381_pp> >(bls12_381_random_curve_point_G1, 3);
+    test_subgroup_check<G2<bls12_381_pp> >(bls12_381_random_curve_point_G2, 13);
+}
+
 TEST_F(CurveGroupsTest, OutputTest)
 {
     test_output<G1<edwards_pp> >();
@@ -203,6 +587,236 @@ TEST_F(CurveGroupsTest, OutputTest)
 #endif
 }
 
+TEST_F(CurveGroupsTest, BinarySerializationTest)
+{
+    test_alt_bn128_binary_serialization();
+}
+
+void test_alt_bn128_binary_file_view()
+{
+    const size_t n = 100;
+    std::vector<alt_bn128_G1> bases;
+    std::vector<alt_bn128_Fr> scalars;
+    for (size_t i = 0; i < n; ++i)
+    {
+        bases.emplace_back(alt_bn128_G1::random_element());
+        scalars.emplace_back(alt_bn128_Fr::random_element());
+    }
+
+    char path[] = "/tmp/libff_binary_file_view_XXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        write_binary(out, bases);
+    }
+    {
+        binary_file_view<alt_bn128_G1> view(path);
+        ASSERT_EQ(view.size(), n);
+        view.prefetch();
+        for (size_t i = 0; i < n; ++i)
+        {
+            EXPECT_EQ(view[i], bases[i]);
+        }
+
+        const alt_bn128_G1 expected = multi_exp<alt_bn128_G1, alt_bn128_Fr, multi_exp_method_naive>(
+            bases.begin(), bases.end(), scalars.begin(), scalars.end(), 1);
+        EXPECT_EQ((multi_exp<alt_bn128_G1, alt_bn128_Fr, multi_exp_method_BDLO12>(
+            view.begin(), view.end(), scalars.begin(), scalars.end(), 1)), expected);
+        EXPECT_EQ((multi_exp<alt_bn128_G1, alt_bn128_Fr, multi_exp_method_BDLO12>(
+            view.begin(), view.end(), scalars.begin(), scalars.end(), 3)), expected);
+
+        binary_file_view<alt_bn128_G1> moved(std::move(view));
+        EXPECT_EQ(view.size(), 0u);
+        EXPECT_EQ(moved[n - 1], bases[n - 1]);
+    }
+
+    /* a coordinate that is not reduced: rejected unless the caller trusts the file */
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(binary_header::size + 5 * sizeof(alt_bn128_G1));
+        const std::string not_reduced(32, '\xff');
+        file.write(not_reduced.data(), not_reduced.size());
+    }
+    EXPECT_THROW(binary_file_view<alt_bn128_G1> view(path), std::runtime_error);
+    EXPECT_EQ(binary_file_view<alt_bn128_G1>(path, false).size(), n);
+
+    /* points of another kind, and points not in memory layout */
+    EXPECT_THROW(binary_file_view<alt_bn128_G2> view(path), std::runtime_error);
+    {
+        binary_format fmt;
+        fmt.form = binary_affine;
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        write_binary(out, bases, fmt);
+    }
+    EXPECT_THROW(binary_file_view<alt_bn128_G1> view(path), std::runtime_error);
+
+    unlink(path);
+    EXPECT_THROW(binary_file_view<alt_bn128_G1> view(path), std::runtime_error);
+}
+
+TEST_F(CurveGroupsTest, BinaryFileViewTest)
+{
+    test_alt_bn128_binary_file_view();
+}
+
+template<typename GroupT, typename FieldT>
+void test_multi_exp_accumulator()
+{
+    const size_t n = 300;
+    std::vector<GroupT> bases;
+    std::vector<FieldT> scalars;
+    for (size_t i = 0; i < n; ++i)
+    {
+        bases.emplace_back(GroupT::random_element());
+        scalars.emplace_back(i % 7 == 0 ? FieldT::zero() : i % 7 == 1 ? FieldT::one() : FieldT::random_element());
+    }
+    const GroupT expected = multi_exp<GroupT, FieldT, multi_exp_method_naive>(
+        bases.begin(), bases.end(), scalars.begin(), scalars.end(), 1);
+
+    for (const size_t chunk : { (size_t)1, (size_t)64, n })
+    {
+        multi_exp_accumulator<GroupT, FieldT> acc(n);
+        EXPECT_EQ(acc.finalize(), GroupT::zero());
+        for (size_t i = 0; i < n; i += chunk)
+        {
+            acc.push(&bases[i], &scalars[i], std::min(chunk, n - i));
+        }
+        EXPECT_EQ(acc.size(), n);
+        EXPECT_EQ(acc.finalize(), expected);
+    }
+
+    /* a window chosen for far fewer terms than are pushed */
+    multi_exp_accumulator<GroupT, FieldT> small(1);
+    small.push(bases, scalars);
+    EXPECT_EQ(small.finalize(), expected);
+}
+
+TEST_F(CurveGroupsTest, MultiExpAccumulatorTest)
+{
+    test_multi_exp_accumulator<alt_bn128_G1, alt_bn128_Fr>();
+    test_multi_exp_accumulator<alt_bn128_G2, alt_bn128_Fr>();
+    test_multi_exp_accumulator<bls12_381_G1, bls12_381_Fr>();
+}
+
+template<typename GroupT, typename FieldT>
+void test_multi_exp_affine()
+{
+    /* enough terms for multi_exp_affine_min_window, with repeated and opposite bases */
+    const size_t n = 1 << 12;
+    std::vector<GroupT> bases;
+    std::vector<FieldT> scalars;
+    GroupT P = GroupT::random_element();
+    for (size_t i = 0; i < n; ++i)
+    {
+        P = P.dbl() + GroupT::one();
+        bases.emplace_back(i % 11 == 0 ? GroupT::zero() : i % 11 == 1 ? bases[i - 1] : i % 11 == 2 ? -bases[i - 2] : P);
+        scalars.emplace_back(i % 5 == 0 ? FieldT(3) : FieldT::random_element());
+    }
+    batch_to_special(bases);
+    /* a base not in special form */
+    bases[n - 1] = bases[n - 1].dbl();
+
+    const GroupT expected = multi_exp<GroupT, FieldT, multi_exp_method_BDLO12>(
+        bases.begin(), bases.end(), scalars.begin(), scalars.end(), 1);
+    EXPECT_EQ((multi_exp<GroupT, FieldT, multi_exp_method_BDLO12_affine>(
+        bases.begin(), bases.end(), scalars.begin(), scalars.end(), 1)), expected);
+
+    /* all terms in one bucket of every window */
+    std::vector<FieldT> same(n, FieldT::random_element());
+    EXPECT_EQ((multi_exp<GroupT, FieldT, multi_exp_method_BDLO12_affine>(
+        bases.data(), same.data(), n, 1)),
+        (multi_exp<GroupT, FieldT, multi_exp_method_BDLO12>(bases.data(), same.data(), n, 1)));
+
+    /* small inputs fall back to BDLO12 */
+    EXPECT_EQ((multi_exp<GroupT, FieldT, multi_exp_method_BDLO12_affine>(
+        bases.data(), scalars.data(), 10, 1)),
+        (multi_exp<GroupT, FieldT, multi_exp_method_naive>(bases.begin(), bases.begin() + 10, scalars.begin(), scalars.begin() + 10, 1)));
+}
+
+TEST_F(CurveGroupsTest, MultiExpAffineTest)
+{
+    test_multi_exp_affine<alt_bn128_G1, alt_bn128_Fr>();
+    test_multi_exp_affine<alt_bn128_G2, alt_bn128_Fr>();
+    test_multi_exp_affine<bls12_381_G1, bls12_381_Fr>();
+    test_multi_exp_affine<bls12_381_G2, bls12_381_Fr>();
+}
+
+/* Runs each task on its own thread, and records whether run is entered from one of its tasks. */
+struct reentry_checking_executor {
+    std::atomic<size_t> running;
+    std::atomic<bool> reentered;
+
+    reentry_checking_executor() : running(0), reentered(false) {}
+
+    parallel_executor executor(const size_t concurrency)
+    {
+        parallel_executor result;
+        result.concurrency = concurrency;
+        result.run = [this](const size_t num_tasks, const std::function<void(size_t)> &task) {
+            if (running.load() > 0)
+            {
+                reentered = true;
+            }
+            std::vector<std::thread> threads;
+            for (size_t i = num_tasks; i-- > 0; )
+            {
+                threads.emplace_back([this, &task, i]() {
+                    ++running;
+                    task(i);
+                    --running;
+                });
+            }
+            for (auto &t : threads)
+            {
+                t.join();
+            }
+        };
+        return result;
+    }
+};
+
+template<typename GroupT>
+void test_batch_to_special(const size_t n)
+{
+    std::vector<GroupT> vec;
+    GroupT P = GroupT::random_element();
+    for (size_t i = 0; i < n; ++i)
+    {
+        P = P + GroupT::one();
+        vec.emplace_back(i % 97 == 0 ? GroupT::zero() : P);
+    }
+
+    reentry_checking_executor checker;
+    for (const size_t concurrency : { 1, 3 })
+    {
+        std::vector<GroupT> special(vec);
+        set_parallel_executor(checker.executor(concurrency));
+        batch_to_special(special);
+        set_parallel_executor(default_parallel_executor());
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            EXPECT_TRUE(special[i].is_special());
+            EXPECT_EQ(special[i], vec[i]);
+        }
+    }
+    EXPECT_FALSE(checker.reentered);
+}
+
+TEST_F(CurveGroupsTest, BatchToSpecialTest)
+{
+    /* more than two slices of the largest size, batch_slice_size(n) = 2^14 */
+    test_batch_to_special<alt_bn128_G1>(2 * (1 << 14) + 1000);
+    test_batch_to_special<alt_bn128_G2>(3000);
+    test_batch_to_special<bls12_381_G1>(3000);
+    test_batch_to_special<edwards_G1>(3000);
+    test_batch_to_special<mnt4_G2>(3000);
+    test_batch_to_special<mnt6_G1>(3000);
+}
+
 TEST_F(CurveGroupsTest, MulByQTest)
 {
     test_mul_by_q<G2<edwards_pp> >();
@@ -211,3 +825,26 @@ TEST_F(CurveGroupsTest, MulByQTest)
     test_mul_by_q<G2<alt_bn128_pp> >();
     test_mul_by_q<G2<bls12_381_pp> >();
 }
+
+TEST_F(CurveGroupsTest, CofactorClearingTest)
+{
+    /* h_eff of RFC 9380, 8.8.2 */
+    const bigint<11> bls12_381_h_eff("209869847837335686905080341498658477663839067235703451875306851526599783796572738804459333109033834234622528588876978987822447936461846631641690358257586228683615991308971558879306463436166481");
+
+    EXPECT_EQ(alt_bn128_G2::zero().mul_by_cofactor(), alt_bn128_G2::zero());
+    EXPECT_EQ(bls12_381_G2::zero().clear_cofactor(), bls12_381_G2::zero());
+    EXPECT_EQ(bls12_381_G2::one().clear_cofactor(), bls12_381_h_eff * bls12_381_G2::one());
+    for (size_t i = 0; i < 10; ++i)
+    {
+        const alt_bn128_G2 P = alt_bn128_random_curve_point_G2();
+        const alt_bn128_G2 hP = P.mul_by_cofactor();
+        EXPECT_EQ(hP, alt_bn128_G2::h * P);
+        EXPECT_FALSE(hP.is_zero());
+        EXPECT_TRUE((alt_bn128_G2::order() * hP).is_zero());
+
+        const bls12_381_G2 R = bls12_381_random_curve_point_G2();
+        const bls12_381_G2 hR = R.clear_cofactor();
+        EXPECT_EQ(hR, bls12_381_h_eff * R);
+        EXPECT_TRUE(hR.is_in_safe_subgroup());
+    }
+}
@@ -0,0 +1,199 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_hash_to_curve.hpp>
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_hash_to_curve.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_pp.hpp>
+#include <libff/algebra/curves/hash_to_curve.hpp>
+
+using namespace libff;
+
+class HashToCurveTest: public ::testing::Test {
+public:
+    HashToCurveTest()
+    {
+        alt_bn128_pp::init_public_params();
+        bls12_381_pp::init_public_params();
+    }
+};
+
+std::string to_hex(const std::vector<unsigned char> &bytes)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    for (unsigned char b : bytes)
+    {
+        hex.push_back(digits[b >> 4]);
+        hex.push_back(digits[b & 0xf]);
+    }
+    return hex;
+}
+
+template<typename GroupT, typename FieldT>
+struct known_answer {
+    std::string msg;
+    FieldT x, y;
+};
+
+template<typename GroupT, typename FieldT>
+void expect_known_answers(GroupT (*hash)(const std::string &, const std::string &),
+                          const std::string &dst,
+                          const std::vector<known_answer<GroupT, FieldT>> &answers)
+{
+    for (const auto &answer : answers)
+    {
+        GroupT P = hash(answer.msg, dst);
+        P.to_affine_coordinates();
+        EXPECT_EQ(P.X, answer.x) << "msg \"" << answer.msg << "\"";
+        EXPECT_EQ(P.Y, answer.y) << "msg \"" << answer.msg << "\"";
+        /* whatever produced the vector, it must be a point of the prime-order subgroup */
+        EXPECT_TRUE(P.is_well_formed());
+        EXPECT_EQ(GroupT::order() * P, GroupT::zero());
+    }
+}
+
+template<typename GroupT>
+void expect_batch_matches_single(GroupT (*hash)(const std::string &, const std::string &),
+                                 std::vector<GroupT> (*batch_hash)(const std::vector<std::string> &,
+                                                                   const std::string &),
+                                 const std::string &dst)
+{
+    std::vector<std::string> msgs;
+    for (size_t i = 0; i < 20; ++i)
+    {
+        msgs.emplace_back(std::string(i, 'a' + (i % 26)));
+    }
+
+    const std::vector<GroupT> points = batch_hash(msgs, dst);
+    ASSERT_EQ(points.size(), msgs.size());
+    for (size_t i = 0; i < msgs.size(); ++i)
+    {
+        EXPECT_EQ(points[i], hash(msgs[i], dst));
+        EXPECT_TRUE(points[i].is_special());
+        EXPECT_TRUE(points[i].is_well_formed());
+        EXPECT_EQ(GroupT::order() * points[i], GroupT::zero());
+    }
+    EXPECT_TRUE(batch_hash({}, dst).empty());
+}
+
+template<typename FieldT>
+void expect_sqrt_ratio(const FieldT &Z)
+{
+    const sqrt_ratio_constants<FieldT> c(Z);
+    size_t squares = 0;
+    for (size_t i = 0; i < 50; ++i)
+    {
+        const FieldT u = (i == 0 ? FieldT::zero() : FieldT::random_element());
+        FieldT v = FieldT::random_element();
+        while (v.is_zero())
+        {
+            v = FieldT::random_element();
+        }
+
+        FieldT y;
+        if (sqrt_ratio(u, v, c, y))
+        {
+            EXPECT_EQ(y.squared() * v, u);
+            ++squares;
+        }
+        else
+        {
+            EXPECT_EQ(y.squared() * v, Z * u);
+        }
+    }
+    /* about half of the ratios are squares */
+    EXPECT_GT(squares, 10u);
+    EXPECT_LT(squares, 40u);
+}
+
+TEST_F(HashToCurveTest, ExpandMessageXmd)
+{
+    /* RFC 9380, K.1 */
+    const std::string dst = "QUUX-V01-CS02-with-expander-SHA256-128";
+    EXPECT_EQ(to_hex(expand_message_xmd("", dst, 0x20)),
+              "68a985b87eb6b46952128911f2a4412bbc302a9d759667f87f7a21d803f07235");
+    EXPECT_EQ(to_hex(expand_message_xmd("abc", dst, 0x80)),
+              "abba86a6129e366fc877aab32fc4ffc70120d8996c88aee2fe4b32d6c7b6437a"
+              "647e6c3163d40b76a73cf6a5674ef1d890f95b664ee0afa5359a5c4e07985635"
+              "bbecbac65d747d3d2da7ec2b8221b17b0ca9dc8a1ac1c07ea6a1e60583e2cb00"
+              "058e77b7b72a298425cd1b941ad4ec65e8afc50303a22c0f99b0509b4c895f40");
+
+    std::string long_dst;
+    for (size_t i = 0; i < 6; ++i)
+    {
+        long_dst += "QUUX-V01-CS02-with-expander-SHA256-128-long-DST-";
+    }
+    EXPECT_EQ(to_hex(expand_message_xmd("abc", long_dst, 0x20)),
+              "531d790a8f5d839b0e91e4eace788cb2a9a67c3fe5185616e34209238eb72945");
+
+    EXPECT_EQ(expand_message_xmd("abc", dst, 8160).size(), 8160u);
+    EXPECT_THROW(expand_message_xmd("abc", dst, 8161), std::invalid_argument);
+}
+
+TEST_F(HashToCurveTest, SqrtRatio)
+{
+    expect_sqrt_ratio(alt_bn128_Fq::nqr);
+    expect_sqrt_ratio(alt_bn128_Fq2::nqr);
+    expect_sqrt_ratio(bls12_381_Fq(11));
+    expect_sqrt_ratio(bls12_381_Fq2(-bls12_381_Fq(2), -bls12_381_Fq::one()));
+}
+
+TEST_F(HashToCurveTest, Bls12_381KnownAnswers)
+{
+    /* BLS12381G1_XMD:SHA-256_SSWU_RO_ and BLS12381G2_XMD:SHA-256_SSWU_RO_, RFC 9380, J.9.1 and J.10.1 */
+    expect_known_answers<bls12_381_G1, bls12_381_Fq>(bls12_381_hash_to_G1,
+        "QUUX-V01-CS02-with-BLS12381G1_XMD:SHA-256_SSWU_RO_", {
+        { "", bls12_381_Fq("794311575721400831362957049303781044852006323422624111893352859557450008308620925451441746926395141598720928151969"),
+          bls12_381_Fq("1343412193624222137939591894701031123123641958980729764240763391191550653712890272928110356903136085217047453540965") },
+        { "abc", bls12_381_Fq("513738460217615943921285247703448567647875874745567372796164155472383127756567780059136521508428662765965997467907"),
+          bls12_381_Fq("1786897908129645780825838873875416513994655004408749907941296449131605892957529391590865627492442562626458913769565") },
+    });
+    expect_known_answers<bls12_381_G2, bls12_381_Fq2>(bls12_381_hash_to_G2,
+        "QUUX-V01-CS02-with-BLS12381G2_XMD:SHA-256_SSWU_RO_", {
+        { "", bls12_381_Fq2(bls12_381_Fq("193548053368451749411421515628510806626565736652086807419354395577367693778571452628423727082668900187036482254730"), bls12_381_Fq("891930009643099423308102777951250899694559203647724988361022851024990473423938537113948850338098230396747396259901")),
+          bls12_381_Fq2(bls12_381_Fq("771717272055834152378281705972671257005357145478800908373659404991537354153455452961747174765859335819766715637138"), bls12_381_Fq("2810310118582126634041133454180705304393079139103252956502404531123692847658283858246402311867775854528543237781718")) },
+        { "abc", bls12_381_Fq2(bls12_381_Fq("424958340463073975547762735517193206833255107941790909009827635556634414746056077714431786321247871628515967727334"), bls12_381_Fq("3018679803970127877262826393814472528557413504329194740495363852840690589001358162447917674089074634504498585239512")),
+          bls12_381_Fq2(bls12_381_Fq("3621308185128395459888995526527127556614768604472132176060423302734876099689739385100475320409412954617897892887112"), bls12_381_Fq("102447784096837908713257069727879782642075240724579670654226801345708452018676587771714457671432122751958633012502")) },
+    });
+}
+
+TEST_F(HashToCurveTest, AltBn128KnownAnswers)
+{
+    /* BN254G1_XMD:SHA-256_SVDW_RO_ is not in RFC 9380; these are the vectors
+       of the BN254 suite of draft-irtf-cfrg-hash-to-curve as shipped with
+       gnark-crypto (ecc/bn254). */
+    expect_known_answers<alt_bn128_G1, alt_bn128_Fq>(alt_bn128_hash_to_G1,
+        "QUUX-V01-CS02-with-BN254G1_XMD:SHA-256_SVDW_RO_", {
+        { "", alt_bn128_Fq("4790658965958450548702669593570794336562317867247372723806336874591549759110"),
+          alt_bn128_Fq("1163238807669877429342450210709044731909255047583162173012265677391336920021") },
+        { "abc", alt_bn128_Fq("16267524812466668166267883771992486438338357688076900798565538061554532963281"),
+          alt_bn128_Fq("1844916233815282837483764409618609279507070495361570126601873459268232811805") },
+    });
+    /* Regression values only: no published BN254G2 suite clears the cofactor
+       by multiplying with h, so these come from this implementation (and
+       agree with a separate script following RFC 9380, 5.2 and 6.6.1). */
+    expect_known_answers<alt_bn128_G2, alt_bn128_Fq2>(alt_bn128_hash_to_G2,
+        "QUUX-V01-CS02-with-BN254G2_XMD:SHA-256_SVDW_RO_", {
+        { "", alt_bn128_Fq2(alt_bn128_Fq("15744322331499198469412574578711527980447355494179720691955202817862476201203"), alt_bn128_Fq("21820100640413659566404071027459456071661321970477855236748890288997221353484")),
+          alt_bn128_Fq2(alt_bn128_Fq("17649527776303199896155775805195728269677443110603816011047029139361403037717"), alt_bn128_Fq("21163850021865976080485047716065140769740841652976444462882025596810458406418")) },
+        { "abc", alt_bn128_Fq2(alt_bn128_Fq("18518363453537869211894741032774280747479403225562984522944903103174042990286"), alt_bn128_Fq("4834248011746048457622922680928539156251702578771284539135587844835448114111")),
+          alt_bn128_Fq2(alt_bn128_Fq("11185884977979390854522796296580597377643569436952289939564474687978639826243"), alt_bn128_Fq("6777616693646426010113181580717235176582397677568317940531485828201217384464")) },
+    });
+}
+
+TEST_F(HashToCurveTest, BatchMatchesSingle)
+{
+    expect_batch_matches_single(bls12_381_hash_to_G1, bls12_381_batch_hash_to_G1, "libff-test-G1");
+    expect_batch_matches_single(bls12_381_hash_to_G2, bls12_381_batch_hash_to_G2, "libff-test-G2");
+    expect_batch_matches_single(alt_bn128_hash_to_G1, alt_bn128_batch_hash_to_G1, "libff-test-G1");
+    expect_batch_matches_single(alt_bn128_hash_to_G2, alt_bn128_batch_hash_to_G2, "libff-test-G2");
+}
@@ -0,0 +1,69 @@
+/** @file
+ *****************************************************************************
+ Declaration of windowed addition chains: the sliding-window recoding of an
+ exponent into runs of squarings and multiplications by odd powers of the
+ base. power() recodes variable exponents at run time; exponents fixed at
+ compile time are recoded once with make_addition_chain.
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef ADDITION_CHAIN_HPP_
+#define ADDITION_CHAIN_HPP_
+
+#include <array>
+#include <cstddef>
+
+namespace libff {
+
+/** Largest window of a chain; its table holds up to 2^(window-1) odd powers of the base. */
+constexpr std::size_t addition_chain_max_window = 6;
+
+/** One step of a chain: result = result^(2^squarings) * base^digit, with digit odd or zero. */
+struct addition_chain_step
+{
+    unsigned squarings;
+    unsigned digit;
+};
+
+/**
+ * A chain of at most max_steps steps. The first step has a non-zero digit
+ * and no squarings; a chain with no steps computes the zero exponent.
+ */
+template<std::size_t window, std::size_t max_steps>
+struct addition_chain
+{
+    std::size_t num_steps;
+    addition_chain_step steps[max_steps];
+};
+
+/** Window size of the sliding-window recoding of an exponent of num_bits bits. */
+constexpr std::size_t sliding_window_size(const std::size_t num_bits);
+
+/**
+ * Sliding-window recoding of the exponent held in num_limbs little-endian
+ * limbs. Writes at most 8 * sizeof(LimbT) * num_limbs steps and returns
+ * their number.
+ */
+template<typename LimbT>
+constexpr std::size_t sliding_window_recode(const LimbT *limbs,
+                                            const std::size_t num_limbs,
+                                            const std::size_t window,
+                                            addition_chain_step *steps);
+
+/**
+ * The chain of a fixed exponent given as little-endian 64-bit limbs, e.g.
+ *
+ *   constexpr auto chain = make_addition_chain<5>(std::array<unsigned long long, 4>{ ... });
+ *   FieldT y = power(x, chain);
+ */
+template<std::size_t window, std::size_t n>
+constexpr addition_chain<window, 64 * n> make_addition_chain(const std::array<unsigned long long, n> &exponent);
+
+} // namespace libff
+
+#include <libff/algebra/field_utils/addition_chain.tcc>
+
+#endif // ADDITION_CHAIN_HPP_
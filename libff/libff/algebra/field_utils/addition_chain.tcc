@@ -0,0 +1,94 @@
+/** @file
+ *****************************************************************************
+ Implementation of windowed addition chains.
+
+ See addition_chain.hpp .
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef ADDITION_CHAIN_TCC_
+#define ADDITION_CHAIN_TCC_
+
+namespace libff {
+
+constexpr std::size_t sliding_window_size(const std::size_t num_bits)
+{
+    /* a window of w bits costs 2^(w-1) multiplications for the table and saves about num_bits/(w+1) */
+    return (num_bits > 239 ? 5 :
+            num_bits > 79 ? 4 :
+            num_bits > 23 ? 3 : 1);
+}
+
+template<typename LimbT>
+constexpr std::size_t sliding_window_recode(const LimbT *limbs,
+                                            const std::size_t num_limbs,
+                                            const std::size_t window,
+                                            addition_chain_step *steps)
+{
+    constexpr std::size_t limb_bits = 8 * sizeof(LimbT);
+
+    long i = long(limb_bits * num_limbs) - 1;
+    while (i >= 0 && !((limbs[i / limb_bits] >> (i % limb_bits)) & 1))
+    {
+        --i;
+    }
+
+    std::size_t num_steps = 0;
+    unsigned squarings = 0;
+    while (i >= 0)
+    {
+        if (!((limbs[i / limb_bits] >> (i % limb_bits)) & 1))
+        {
+            ++squarings;
+            --i;
+            continue;
+        }
+
+        /* the longest window of at most window bits that starts at bit i and ends in a one */
+        long j = (i + 1 >= long(window) ? i + 1 - long(window) : 0);
+        while (!((limbs[j / limb_bits] >> (j % limb_bits)) & 1))
+        {
+            ++j;
+        }
+
+        unsigned digit = 0;
+        for (long k = i; k >= j; --k)
+        {
+            digit = (digit << 1) | unsigned((limbs[k / limb_bits] >> (k % limb_bits)) & 1);
+        }
+
+        /* the first step starts from the base power itself */
+        steps[num_steps].squarings = (num_steps == 0 ? 0 : squarings + unsigned(i - j + 1));
+        steps[num_steps].digit = digit;
+        ++num_steps;
+
+        squarings = 0;
+        i = j - 1;
+    }
+
+    if (squarings != 0)
+    {
+        steps[num_steps].squarings = squarings;
+        steps[num_steps].digit = 0;
+        ++num_steps;
+    }
+
+    return num_steps;
+}
+
+template<std::size_t window, std::size_t n>
+constexpr addition_chain<window, 64 * n> make_addition_chain(const std::array<unsigned long long, n> &exponent)
+{
+    static_assert(window >= 1 && window <= addition_chain_max_window, "window out of range");
+
+    addition_chain<window, 64 * n> chain = {};
+    chain.num_steps = sliding_window_recode(exponent.data(), n, window, chain.steps);
+    return chain;
+}
+
+} // namespace libff
+
+#endif // ADDITION_CHAIN_TCC_
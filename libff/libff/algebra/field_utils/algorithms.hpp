@@ -1,6 +1,6 @@
 /** @file
  *****************************************************************************
- Declaration of interfaces for (square-and-multiply) exponentiation and
+ Declaration of interfaces for (sliding-window) exponentiation and
  Tonelli-Shanks square root.
  *****************************************************************************
  * @author     This file is part of libff, developed by SCIPR Lab
@@ -13,15 +13,16 @@
 
 #include <cstdint>
 
+#include "libff/algebra/field_utils/addition_chain.hpp"
 #include "libff/algebra/field_utils/bigint.hpp"
 
 namespace libff {
 
-/** Repeated squaring. */
+/** Sliding-window exponentiation. */
 template<typename FieldT, mp_size_t m>
 FieldT power(const FieldT &base, const bigint<m> &exponent);
 
-/** Repeated squaring. */
+/** Sliding-window exponentiation. */
 template<typename FieldT>
 FieldT power(const FieldT &base, const unsigned long exponent);
 
@@ -32,9 +33,18 @@ FieldT power(const FieldT &base, const unsigned long exponent);
 template<typename FieldT>
 FieldT power(const FieldT &base, const unsigned long long exponent);
 
+/** The exponent is given by its 64-bit limbs, most significant first. */
 template<typename FieldT>
 FieldT power(const FieldT &base, const std::vector<unsigned long long> exponent);
 
+/** Exponentiation along num_steps steps of an addition chain (see addition_chain.hpp). */
+template<typename FieldT>
+FieldT power(const FieldT &base, const addition_chain_step *steps, const size_t num_steps);
+
+/** Exponentiation by the fixed exponent of chain. */
+template<typename FieldT, size_t window, size_t max_steps>
+FieldT power(const FieldT &base, const addition_chain<window, max_steps> &chain);
+
 /**
  * Tonelli-Shanks square root with given s, t, and quadratic non-residue.
  * Only terminates if there is a square root. Only works if required parameters
@@ -1,7 +1,7 @@
 /** @file
  *****************************************************************************
- Declaration of interfaces for (square-and-multiply) exponentiation and
- Tonelli-Shanks square root.
+ Implementation of (sliding-window) exponentiation and Tonelli-Shanks
+ square root.
  *****************************************************************************
  * @author     This file is part of libff, developed by SCIPR Lab
  *             and contributors (see AUTHORS).
@@ -11,6 +11,9 @@
 #ifndef ALGORITHMS_TCC_
 #define ALGORITHMS_TCC_
 
+#include <algorithm>
+#include <cassert>
+
 #include "libff/common/utils.hpp"
 #include "libff/common/profiling.hpp"
 
@@ -18,29 +21,64 @@ namespace libff {
 
 using std::size_t;
 
-template<typename FieldT, mp_size_t m>
-FieldT power(const FieldT &base, const bigint<m> &exponent)
+template<typename FieldT>
+FieldT power(const FieldT &base, const addition_chain_step *steps, const size_t num_steps)
 {
-    FieldT result = FieldT::one();
-    bool found_one = false;
+    if (num_steps == 0)
+    {
+        return FieldT::one();
+    }
 
-    for (long i = exponent.max_bits() - 1; i >= 0; --i)
+    unsigned max_digit = 1;
+    for (size_t i = 0; i < num_steps; ++i)
     {
-        if (found_one)
+        max_digit = std::max(max_digit, steps[i].digit);
+    }
+    assert(max_digit < (1u << addition_chain_max_window));
+
+    /* table[k] = base^(2k+1) */
+    FieldT table[1u << (addition_chain_max_window - 1)];
+    table[0] = base;
+    if (max_digit > 1)
+    {
+        const FieldT base_squared = base.squared();
+        for (unsigned k = 1; 2 * k + 1 <= max_digit; ++k)
         {
-            result = result * result;
+            table[k] = table[k - 1] * base_squared;
         }
+    }
 
-        if (exponent.test_bit(i))
+    FieldT result = table[steps[0].digit / 2];
+    for (size_t i = 1; i < num_steps; ++i)
+    {
+        for (unsigned k = 0; k < steps[i].squarings; ++k)
+        {
+            result = result.squared();
+        }
+
+        if (steps[i].digit != 0)
         {
-            found_one = true;
-            result = result * base;
+            result = result * table[steps[i].digit / 2];
         }
     }
 
     return result;
 }
 
+template<typename FieldT, size_t window, size_t max_steps>
+FieldT power(const FieldT &base, const addition_chain<window, max_steps> &chain)
+{
+    return power<FieldT>(base, chain.steps, chain.num_steps);
+}
+
+template<typename FieldT, mp_size_t m>
+FieldT power(const FieldT &base, const bigint<m> &exponent)
+{
+    addition_chain_step steps[GMP_NUMB_BITS * m];
+    const size_t num_steps = sliding_window_recode(exponent.data, m, sliding_window_size(exponent.num_bits()), steps);
+    return power<FieldT>(base, steps, num_steps);
+}
+
 template<typename FieldT>
 FieldT power(const FieldT &base, const unsigned long exponent)
 {
@@ -50,53 +88,32 @@ FieldT power(const FieldT &base, const unsigned long exponent)
 template<typename FieldT>
 FieldT power(const FieldT &base, const unsigned long long exponent)
 {
-    FieldT result = FieldT::one();
-
-    bool found_one = false;
-
-    for (long i = 8 * sizeof(exponent) - 1; i >= 0; --i)
+    size_t num_bits = 0;
+    while (num_bits < 8 * sizeof(exponent) && (exponent >> num_bits) != 0)
     {
-        if (found_one)
-        {
-            result = result.squared();
-        }
-
-        if (exponent & (1ull << i))
-        {
-            found_one = true;
-            result *= base;
-        }
+        ++num_bits;
     }
 
-    return result;
+    addition_chain_step steps[8 * sizeof(exponent)];
+    const size_t num_steps = sliding_window_recode(&exponent, 1, sliding_window_size(num_bits), steps);
+    return power<FieldT>(base, steps, num_steps);
 }
 
 template<typename FieldT>
 FieldT power(const FieldT &base, const std::vector<unsigned long long> exponent)
 {
-    FieldT result = FieldT::one();
-
-    bool found_one = false;
-
-    for (unsigned long long j = 0; j < exponent.size(); j++)
+    const std::vector<unsigned long long> limbs(exponent.rbegin(), exponent.rend());
+    const size_t limb_bits = 8 * sizeof(unsigned long long);
+    size_t num_bits = limb_bits * limbs.size();
+    while (num_bits > 0 && ((limbs[(num_bits - 1) / limb_bits] >> ((num_bits - 1) % limb_bits)) & 1) == 0)
     {
-        unsigned long long cur_exp = exponent[j];
-        for (long i = 8 * sizeof(cur_exp) - 1; i >= 0; --i)
-        {
-            if (found_one)
-            {
-                result = result.squared();
-            }
-
-            if (cur_exp & (1ull << i))
-            {
-                found_one = true;
-                result *= base;
-            }
-        }
+        --num_bits;
     }
 
-    return result;
+    std::vector<addition_chain_step> steps(limb_bits * limbs.size());
+    const size_t num_steps = sliding_window_recode(limbs.data(), limbs.size(),
+                                                   sliding_window_size(num_bits), steps.data());
+    return power<FieldT>(base, steps.data(), num_steps);
 }
 
 template<typename FieldT>
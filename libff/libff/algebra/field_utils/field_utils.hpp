@@ -127,8 +127,30 @@ bit_vector convert_field_element_to_bit_vector(const FieldT &el, const std::size
 template<typename FieldT>
 FieldT convert_bit_vector_to_field_element(const bit_vector &v);
 
+/**
+ * Replaces each element of vec, all non-zero, by its inverse. The elements are
+ * split into slices of batch_slice_size(count) elements, which parallel_for
+ * inverts independently with one field inversion each.
+ */
 template<typename FieldT>
 void batch_invert(std::vector<FieldT> &vec);
+template<typename FieldT>
+void batch_invert(FieldT *vec, const std::size_t count);
+
+/**
+ * Montgomery's batch inversion of count non-zero elements on the calling
+ * thread, with prod as scratch space for count elements. It does not allocate.
+ */
+template<typename FieldT>
+void batch_invert(FieldT *vec, FieldT *prod, const std::size_t count);
+
+/**
+ * The slice size of batch_invert and batch_to_special: enough slices for
+ * every worker of the executor, but slices of at least 2^10 elements, so that
+ * the inversions stay cheap, and of at most 2^14, so that the scratch space of
+ * the slices in flight stays small.
+ */
+inline std::size_t batch_slice_size(const std::size_t count);
 
 } // namespace libff
 #include <libff/algebra/field_utils/field_utils.tcc>
@@ -10,9 +10,12 @@
 #ifndef FIELD_UTILS_TCC_
 #define FIELD_UTILS_TCC_
 
+#include <algorithm>
 #include <complex>
 #include <stdexcept>
 
+#include <libff/common/parallel.hpp>
+
 namespace libff {
 
 using std::size_t;
@@ -231,24 +234,46 @@ FieldT convert_bit_vector_to_field_element(const bit_vector &v)
     return res;
 }
 
+inline size_t batch_slice_size(const size_t count)
+{
+    const size_t per_worker = (count + parallel_concurrency() - 1) / parallel_concurrency();
+    return std::min<size_t>(std::max<size_t>(per_worker, 1ul << 10), 1ul << 14);
+}
+
 template<typename FieldT>
 void batch_invert(std::vector<FieldT> &vec)
 {
-    std::vector<FieldT> prod;
-    prod.reserve(vec.size());
+    batch_invert(vec.data(), vec.size());
+}
 
+template<typename FieldT>
+void batch_invert(FieldT *vec, const size_t count)
+{
+    const size_t slice_size = batch_slice_size(count);
+    const size_t num_slices = (count + slice_size - 1) / slice_size;
+
+    parallel_for(num_slices, [&](const size_t s) {
+        const size_t slice_count = std::min(slice_size, count - s * slice_size);
+        std::vector<FieldT> prod(slice_count);
+        batch_invert(vec + s * slice_size, prod.data(), slice_count);
+    });
+}
+
+template<typename FieldT>
+void batch_invert(FieldT *vec, FieldT *prod, const size_t count)
+{
     FieldT acc = FieldT::one();
 
-    for (auto el : vec)
+    for (size_t i = 0; i < count; ++i)
     {
-        assert(!el.is_zero());
-        prod.emplace_back(acc);
-        acc = acc * el;
+        assert(!vec[i].is_zero());
+        prod[i] = acc;
+        acc = acc * vec[i];
     }
 
     FieldT acc_inverse = acc.inverse();
 
-    for (long i = static_cast<long>(vec.size()-1); i >= 0; --i)
+    for (size_t i = count; i-- > 0; )
     {
         const FieldT old_el = vec[i];
         vec[i] = acc_inverse * prod[i];
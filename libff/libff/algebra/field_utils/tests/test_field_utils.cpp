@@ -11,8 +11,12 @@
 #include "libff/algebra/field_utils/field_utils.hpp"
 #include "libff/algebra/field_utils/algorithms.hpp"
 #include "libff/algebra/fields/binary/gf64.hpp"
+#include "libff/algebra/curves/alt_bn128/alt_bn128_init.hpp"
 #include "libff/algebra/curves/edwards/edwards_fields.hpp"
+#include "libff/common/parallel.hpp"
+#include "libff/common/utils.hpp"
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace libff;
 
@@ -53,6 +57,100 @@ TEST(ExponentiationTest, SimpleTest) {
     }
 }
 
+template<typename FieldT, mp_size_t m>
+FieldT power_square_and_multiply(const FieldT &base, const bigint<m> &exponent)
+{
+    FieldT result = FieldT::one();
+    for (long i = exponent.max_bits() - 1; i >= 0; --i)
+    {
+        result = result.squared();
+        if (exponent.test_bit(i))
+        {
+            result *= base;
+        }
+    }
+
+    return result;
+}
+
+TEST(ExponentiationTest, SlidingWindowTest)
+{
+    init_alt_bn128_params();
+    typedef alt_bn128_Fq FieldT;
+
+    const FieldT X = FieldT::random_element();
+    EXPECT_EQ(power<FieldT>(X, bigint<4>(0ul)), FieldT::one());
+    EXPECT_EQ(power<FieldT>(X, std::vector<unsigned long long>()), FieldT::one());
+
+    for (size_t i = 0; i < 20; ++i)
+    {
+        /* random exponents of every window size, with runs of zeros */
+        bigint<4> exponent = FieldT::random_element().as_bigint();
+        exponent.data[i % 4] = 0;
+        for (size_t j = 4 - i / 5; j < 4; ++j)
+        {
+            exponent.data[j] = 0;
+        }
+
+        const FieldT expected = power_square_and_multiply(X, exponent);
+        EXPECT_EQ(power<FieldT>(X, exponent), expected);
+        EXPECT_EQ(X ^ exponent, expected);
+        EXPECT_EQ(power<FieldT>(X, std::vector<unsigned long long>(
+                                        { exponent.data[3], exponent.data[2], exponent.data[1], exponent.data[0] })),
+                  expected);
+        EXPECT_EQ(power<FieldT>(X, (unsigned long long) exponent.data[1]),
+                  power_square_and_multiply(X, bigint<1>(exponent.data[1])));
+    }
+}
+
+TEST(ExponentiationTest, AdditionChainTest)
+{
+    /* 0b1011000111 with windows of 3 bits: 101, 1, 000, 111 */
+    constexpr auto chain = make_addition_chain<3>(std::array<unsigned long long, 1>{ 0x2c7ull });
+    static_assert(chain.num_steps == 3, "unexpected number of steps");
+    static_assert(chain.steps[0].squarings == 0 && chain.steps[0].digit == 5, "unexpected first step");
+    static_assert(chain.steps[1].squarings == 1 && chain.steps[1].digit == 1, "unexpected second step");
+    static_assert(chain.steps[2].squarings == 6 && chain.steps[2].digit == 7, "unexpected third step");
+
+    constexpr auto zero_chain = make_addition_chain<3>(std::array<unsigned long long, 1>{ 0ull });
+    static_assert(zero_chain.num_steps == 0, "the zero exponent has no steps");
+
+    init_alt_bn128_params();
+    typedef alt_bn128_Fq FieldT;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        const FieldT X = FieldT::random_element();
+        EXPECT_EQ(power<FieldT>(X, chain), X ^ 0x2c7ul);
+        EXPECT_EQ(power<FieldT>(X, zero_chain), FieldT::one());
+        EXPECT_EQ(power<FieldT>(X, alt_bn128_Fq_q_minus_3_over_4_chain), X ^ FieldT::t_minus_1_over_2);
+    }
+}
+
+TEST(ExponentiationTest, AdditionChainSqrtTest)
+{
+    init_alt_bn128_params();
+    typedef alt_bn128_Fq FieldT;
+
+    EXPECT_EQ(alt_bn128_Fq_sqrt(FieldT::zero()), FieldT::zero());
+    EXPECT_EQ(alt_bn128_Fq_sqrt(FieldT::one())->squared(), FieldT::one());
+    /* q = 3 (mod 4), so -1 is not a square */
+    EXPECT_EQ(alt_bn128_Fq_sqrt(-FieldT::one()), std::nullopt);
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+        const FieldT X = random_element_non_zero<FieldT>();
+        const FieldT X2 = X.squared();
+        const std::optional<FieldT> root = alt_bn128_Fq_sqrt(X2);
+        ASSERT_NE(root, std::nullopt);
+        EXPECT_EQ(root->squared(), X2);
+        EXPECT_EQ(alt_bn128_Fq_sqrt(-X2), std::nullopt);
+    }
+
+    /* y^2 = x^3 + 3 as in G1 decompression: x = 1 is the generator, no point has x = 4 */
+    EXPECT_EQ(alt_bn128_Fq_sqrt(FieldT("4"))->squared(), FieldT("4"));
+    EXPECT_EQ(alt_bn128_Fq_sqrt(FieldT("67")), std::nullopt);
+}
+
 TEST(FieldUtilsTest, BigintTest)
 {
     bigint<3> zero = bigint<3>("0");
@@ -155,3 +253,46 @@ TEST(FieldUtilsTest, FieldVectorConversionTest)
     for (size_t i = 3; i < vec3.size(); i++)
         EXPECT_EQ(vec3[i], 0);
 }
+
+/* Runs each task on its own thread, in reverse order, to check that slices do not depend on each other. */
+parallel_executor thread_per_task_executor()
+{
+    parallel_executor executor;
+    executor.concurrency = 4;
+    executor.run = [](const size_t num_tasks, const std::function<void(size_t)> &task) {
+        std::vector<std::thread> threads;
+        for (size_t i = num_tasks; i-- > 0; )
+        {
+            threads.emplace_back(task, i);
+        }
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+    };
+    return executor;
+}
+
+TEST(FieldUtilsTest, BatchInvertTest)
+{
+    init_edwards_fields();
+
+    for (const parallel_executor &executor : { default_parallel_executor(), thread_per_task_executor() })
+    {
+        set_parallel_executor(executor);
+        for (const size_t n : { 0, 1, 1000, 40000 })
+        {
+            std::vector<edwards_Fq> vec;
+            for (size_t i = 0; i < n; ++i)
+            {
+                vec.emplace_back(edwards_Fq(i + 1));
+            }
+            batch_invert(vec);
+            for (size_t i = 0; i < n; ++i)
+            {
+                EXPECT_EQ(vec[i] * edwards_Fq(i + 1), edwards_Fq::one());
+            }
+        }
+    }
+    set_parallel_executor(default_parallel_executor());
+}
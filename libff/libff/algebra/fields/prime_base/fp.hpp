@@ -63,6 +63,14 @@ public:
     static bigint<n> Rsquared; // R^2, where R = W^k, where k = ??
     static bigint<n> Rcubed;   // R^3
 
+    /**
+     * Double-width accumulator for lazy reduction: a product of two Montgomery
+     * representations that has not been Montgomery-reduced yet. Values are kept
+     * in [0, modulus * R), so sums and differences of several products can be
+     * formed with add_no_reduce/sub_no_reduce and reduced once with reduce().
+     */
+    typedef bigint<2*n> unreduced;
+
     Fp_model() {};
     Fp_model(const bigint<n> &b);
     Fp_model(const long x, const bool is_unsigned=false);
@@ -72,6 +80,15 @@ public:
     /** Performs the operation montgomery_reduce(other * this.mont_repr). */
     void mul_reduce(const bigint<n> &other);
 
+    /** Returns this.mont_repr * other.mont_repr, without Montgomery reduction. */
+    unreduced mul_no_reduce(const Fp_model& other) const;
+    unreduced squared_no_reduce() const;
+    /** Returns montgomery_reduce(T), for T in [0, modulus * R). */
+    static Fp_model reduce(const unreduced &T);
+    /** acc = acc + other (resp. acc - other) modulo modulus * R. */
+    static void add_no_reduce(unreduced &acc, const unreduced &other);
+    static void sub_no_reduce(unreduced &acc, const unreduced &other);
+
     void clear();
     void print() const;
     void randomize();
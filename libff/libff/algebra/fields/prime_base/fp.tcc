@@ -193,6 +193,81 @@ void Fp_model<n,modulus>::mul_reduce(const bigint<n> &other)
     }
 }
 
+template<mp_size_t n, const bigint<n>& modulus>
+typename Fp_model<n,modulus>::unreduced Fp_model<n,modulus>::mul_no_reduce(const Fp_model<n,modulus>& other) const
+{
+#ifdef PROFILE_OP_COUNTS
+    this->mul_cnt++;
+#endif
+    unreduced res;
+    mpn_mul_n(res.data, this->mont_repr.data, other.mont_repr.data, n);
+    return res;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+typename Fp_model<n,modulus>::unreduced Fp_model<n,modulus>::squared_no_reduce() const
+{
+#ifdef PROFILE_OP_COUNTS
+    this->sqr_cnt++;
+#endif
+    unreduced res;
+    mpn_sqr(res.data, this->mont_repr.data, n);
+    return res;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp_model<n,modulus> Fp_model<n,modulus>::reduce(const unreduced &T)
+{
+    mp_limb_t res[2*n];
+    mpn_copyi(res, T.data, 2*n);
+
+    /* Same reduction as in mul_reduce, Algorithm 14.32 in Handbook of Applied Cryptography. */
+    mp_limb_t carryout = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        mp_limb_t k = inv * res[i];
+        carryout = mpn_addmul_1(res+i, modulus.data, n, k);
+        carryout = mpn_add_1(res+n+i, res+n+i, n-i, carryout);
+    }
+
+    Fp_model<n, modulus> r;
+    if (carryout || mpn_cmp(res+n, modulus.data, n) >= 0)
+    {
+        mpn_sub_n(r.mont_repr.data, res+n, modulus.data, n);
+    }
+    else
+    {
+        mpn_copyi(r.mont_repr.data, res+n, n);
+    }
+    return r;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp_model<n,modulus>::add_no_reduce(unreduced &acc, const unreduced &other)
+{
+#ifdef PROFILE_OP_COUNTS
+    add_cnt++;
+#endif
+    /* modulus * R has n zero low limbs, so only the high half needs adjusting */
+    const mp_limb_t carry = mpn_add_n(acc.data, acc.data, other.data, 2*n);
+    if (carry || mpn_cmp(acc.data+n, modulus.data, n) >= 0)
+    {
+        mpn_sub_n(acc.data+n, acc.data+n, modulus.data, n);
+    }
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp_model<n,modulus>::sub_no_reduce(unreduced &acc, const unreduced &other)
+{
+#ifdef PROFILE_OP_COUNTS
+    sub_cnt++;
+#endif
+    if (mpn_sub_n(acc.data, acc.data, other.data, 2*n))
+    {
+        mpn_add_n(acc.data+n, acc.data+n, modulus.data, n);
+    }
+}
+
 template<mp_size_t n, const bigint<n>& modulus>
 Fp_model<n,modulus>::Fp_model(const bigint<n> &b)
 {
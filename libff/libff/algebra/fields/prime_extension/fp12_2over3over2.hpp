@@ -109,10 +109,19 @@ public:
     Fp12_2over3over2_model cyclotomic_squared() const;
     std::optional<Fp12_2over3over2_model> sqrt() const;
 
+    /* In-place and output-parameter forms; result may alias this or other. */
+    void mul_into(const Fp12_2over3over2_model &other, Fp12_2over3over2_model &result) const;
+    Fp12_2over3over2_model& square_inplace(); // complex squaring
+    Fp12_2over3over2_model& cyclotomic_square_inplace();
+    Fp12_2over3over2_model& frobenius_inplace(unsigned long power);
+    Fp12_2over3over2_model& unitary_inverse_inplace();
+
     Fp12_2over3over2_model mul_by_024(const my_Fp2 &ell_0, const my_Fp2 &ell_VW, const my_Fp2 &ell_VV) const;
+    Fp12_2over3over2_model& mul_by_024_inplace(const my_Fp2 &ell_0, const my_Fp2 &ell_VW, const my_Fp2 &ell_VV);
     Fp12_2over3over2_model mul_by_045(const my_Fp2 &ell_0, const my_Fp2 &ell_VW, const my_Fp2 &ell_VV) const;
 
     static my_Fp6 mul_by_non_residue(const my_Fp6 &elt);
+    static typename my_Fp6::unreduced mul_by_non_residue_no_reduce(const typename my_Fp6::unreduced &elt);
 
     template<mp_size_t m>
     Fp12_2over3over2_model cyclotomic_exp(const bigint<m> &exponent) const;
@@ -129,6 +138,10 @@ public:
 
     friend std::ostream& operator<< <n, modulus>(std::ostream &out, const Fp12_2over3over2_model<n, modulus> &el);
     friend std::istream& operator>> <n, modulus>(std::istream &in, Fp12_2over3over2_model<n, modulus> &el);
+
+private:
+    /** Computes c0 + c1*y = (a + b*y)^2 in Fp4 = Fp2[y]/(y^2 - my_Fp6::non_residue), with lazy reduction. */
+    static void Fp4_square(my_Fp2 &c0, my_Fp2 &c1, const my_Fp2 &a, const my_Fp2 &b);
 };
 
 #ifdef PROFILE_OP_COUNTS
@@ -20,6 +20,16 @@ Fp6_3over2_model<n, modulus> Fp12_2over3over2_model<n,modulus>::mul_by_non_resid
     return Fp6_3over2_model<n, modulus>(non_residue * elt.c2, elt.c0, elt.c1);
 }
 
+template<mp_size_t n, const bigint<n>& modulus>
+typename Fp6_3over2_model<n, modulus>::unreduced Fp12_2over3over2_model<n,modulus>::mul_by_non_residue_no_reduce(const typename my_Fp6::unreduced &elt)
+{
+    typename my_Fp6::unreduced res;
+    res.c0 = my_Fp6::mul_by_non_residue_no_reduce(my_Fp2::reduce(elt.c2));
+    res.c1 = elt.c0;
+    res.c2 = elt.c1;
+    return res;
+}
+
 template<mp_size_t n, const bigint<n>& modulus>
 Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::zero()
 {
@@ -112,6 +122,14 @@ Fp12_2over3over2_model<n, modulus> operator*(const Fp6_3over2_model<n, modulus>
 
 template<mp_size_t n, const bigint<n>& modulus>
 Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::operator*(const Fp12_2over3over2_model<n,modulus> &other) const
+{
+    Fp12_2over3over2_model<n,modulus> result;
+    this->mul_into(other, result);
+    return result;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp12_2over3over2_model<n,modulus>::mul_into(const Fp12_2over3over2_model<n,modulus> &other, Fp12_2over3over2_model<n,modulus> &result) const
 {
 #ifdef PROFILE_OP_COUNTS
     this->mul_cnt++;
@@ -120,11 +138,18 @@ Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::operator*(c
 
     const my_Fp6 &A = other.c0, &B = other.c1,
         &a = this->c0, &b = this->c1;
-    const my_Fp6 aA = a * A;
-    const my_Fp6 bB = b * B;
+    const typename my_Fp6::unreduced aA = a.mul_no_reduce(A);
+    const typename my_Fp6::unreduced bB = b.mul_no_reduce(B);
+
+    typename my_Fp6::unreduced res0 = aA;
+    my_Fp6::add_no_reduce(res0, mul_by_non_residue_no_reduce(bB));
+
+    typename my_Fp6::unreduced res1 = (a + b).mul_no_reduce(A + B);
+    my_Fp6::sub_no_reduce(res1, aA);
+    my_Fp6::sub_no_reduce(res1, bB);
 
-    return Fp12_2over3over2_model<n,modulus>(aA + Fp12_2over3over2_model<n, modulus>::mul_by_non_residue(bB),
-                                             (a + b)*(A+B) - aA - bB);
+    result.c0 = my_Fp6::reduce(res0);
+    result.c1 = my_Fp6::reduce(res1);
 }
 
 template<mp_size_t n, const bigint<n>& modulus>
@@ -171,7 +196,7 @@ Fp12_2over3over2_model<n,modulus>& Fp12_2over3over2_model<n,modulus>::operator-=
 template<mp_size_t n, const bigint<n>& modulus>
 Fp12_2over3over2_model<n,modulus>& Fp12_2over3over2_model<n,modulus>::operator*=(const Fp12_2over3over2_model<n,modulus>& other)
 {
-    (*this) = *this * other;
+    this->mul_into(other, *this);
     return (*this);
 }
 
@@ -199,8 +224,7 @@ Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::squared() c
 template<mp_size_t n, const bigint<n>& modulus>
 Fp12_2over3over2_model<n,modulus>& Fp12_2over3over2_model<n,modulus>::square()
 {
-    (*this) = squared();
-    return (*this);
+    return square_inplace();
 }
 
 template<mp_size_t n, const bigint<n>& modulus>
@@ -221,6 +245,13 @@ Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::squared_kar
 
 template<mp_size_t n, const bigint<n>& modulus>
 Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::squared_complex() const
+{
+    Fp12_2over3over2_model<n,modulus> result(*this);
+    return result.square_inplace();
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp12_2over3over2_model<n,modulus>& Fp12_2over3over2_model<n,modulus>::square_inplace()
 {
 #ifdef PROFILE_OP_COUNTS
     this->sqr_cnt++;
@@ -228,10 +259,22 @@ Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::squared_com
     /* Devegili OhEig Scott Dahab --- Multiplication and Squaring on Pairing-Friendly Fields.pdf; Section 3 (Complex squaring) */
 
     const my_Fp6 &a = this->c0, &b = this->c1;
-    const my_Fp6 ab = a * b;
+    const typename my_Fp6::unreduced ab = a.mul_no_reduce(b);
+    const my_Fp6 ab_reduced = my_Fp6::reduce(ab);
+
+    /* non_residue * ab, reusing the reduced ab.c2 */
+    typename my_Fp6::unreduced ab_nr;
+    ab_nr.c0 = my_Fp6::mul_by_non_residue_no_reduce(ab_reduced.c2);
+    ab_nr.c1 = ab.c0;
+    ab_nr.c2 = ab.c1;
+
+    typename my_Fp6::unreduced res0 = (a + b).mul_no_reduce(a + Fp12_2over3over2_model<n, modulus>::mul_by_non_residue(b));
+    my_Fp6::sub_no_reduce(res0, ab);
+    my_Fp6::sub_no_reduce(res0, ab_nr);
 
-    return Fp12_2over3over2_model<n,modulus>((a + b) * (a + Fp12_2over3over2_model<n, modulus>::mul_by_non_residue(b)) - ab - Fp12_2over3over2_model<n, modulus>::mul_by_non_residue(ab),
-                                             ab + ab);
+    c0 = my_Fp6::reduce(res0);
+    c1 = ab_reduced + ab_reduced;
+    return (*this);
 }
 
 template<mp_size_t n, const bigint<n>& modulus>
@@ -267,6 +310,20 @@ Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::Frobenius_m
                                              Frobenius_coeffs_c1[power % 12] * c1.Frobenius_map(power));
 }
 
+template<mp_size_t n, const bigint<n>& modulus>
+Fp12_2over3over2_model<n,modulus>& Fp12_2over3over2_model<n,modulus>::frobenius_inplace(unsigned long power)
+{
+    c0.frobenius_inplace(power);
+    c1.frobenius_inplace(power);
+    if (power % 12)
+    {
+        c1.c0 *= Frobenius_coeffs_c1[power % 12];
+        c1.c1 *= Frobenius_coeffs_c1[power % 12];
+        c1.c2 *= Frobenius_coeffs_c1[power % 12];
+    }
+    return (*this);
+}
+
 template<mp_size_t n, const bigint<n>& modulus>
 Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::unitary_inverse() const
 {
@@ -274,8 +331,22 @@ Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::unitary_inv
                                              -this->c1);
 }
 
+template<mp_size_t n, const bigint<n>& modulus>
+Fp12_2over3over2_model<n,modulus>& Fp12_2over3over2_model<n,modulus>::unitary_inverse_inplace()
+{
+    c1 = -c1;
+    return (*this);
+}
+
 template<mp_size_t n, const bigint<n>& modulus>
 Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::cyclotomic_squared() const
+{
+    Fp12_2over3over2_model<n,modulus> result(*this);
+    return result.cyclotomic_square_inplace();
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp12_2over3over2_model<n,modulus>& Fp12_2over3over2_model<n,modulus>::cyclotomic_square_inplace()
 {
     /* OLD: naive implementation
        return (*this).squared();
@@ -290,17 +361,11 @@ Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::cyclotomic_
     my_Fp2 t0, t1, t2, t3, t4, t5, tmp;
 
     // t0 + t1*y = (z0 + z1*y)^2 = a^2
-    tmp = z0 * z1;
-    t0 = (z0 + z1) * (z0 + my_Fp6::non_residue * z1) - tmp - my_Fp6::non_residue * tmp;
-    t1 = tmp + tmp;
+    Fp4_square(t0, t1, z0, z1);
     // t2 + t3*y = (z2 + z3*y)^2 = b^2
-    tmp = z2 * z3;
-    t2 = (z2 + z3) * (z2 + my_Fp6::non_residue * z3) - tmp - my_Fp6::non_residue * tmp;
-    t3 = tmp + tmp;
+    Fp4_square(t2, t3, z2, z3);
     // t4 + t5*y = (z4 + z5*y)^2 = c^2
-    tmp = z4 * z5;
-    t4 = (z4 + z5) * (z4 + my_Fp6::non_residue * z5) - tmp - my_Fp6::non_residue * tmp;
-    t5 = tmp + tmp;
+    Fp4_square(t4, t5, z4, z5);
 
     // for A
 
@@ -338,7 +403,9 @@ Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::cyclotomic_
     z5 = z5 + z5;
     z5 = z5 + t3;
 
-    return Fp12_2over3over2_model<n,modulus>(my_Fp6(z0,z4,z3),my_Fp6(z2,z1,z5));
+    this->c0 = my_Fp6(z0,z4,z3);
+    this->c1 = my_Fp6(z2,z1,z5);
+    return (*this);
 }
 
 template<mp_size_t n, const bigint<n>& modulus>
@@ -365,26 +432,37 @@ Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::mul_by_045(
     my_Fp2 x4 = ell_0;
     my_Fp2 x5 = ell_VV;
 
-    my_Fp2 t0, t1, t2, t3, t4, t5;
+    typename my_Fp2::unreduced t0, t1, t2, t3, t4, t5;
     my_Fp2 tmp1, tmp2;
 
     tmp1 = my_Fp6::non_residue * x4;
     tmp2 = my_Fp6::non_residue * x5;
 
-    t0 = x0 * z0 + tmp1 * z4 + tmp2 * z3;
-    t1 = x0 * z1 + tmp1 * z5 + tmp2 * z4;
-    t2 = x0 * z2 + x4 * z3 + tmp2 * z5;
-    t3 = x0 * z3 + tmp1 * z2 + tmp2 * z1;
-    t4 = x0 * z4 + x4 * z0 + tmp2 * z2;
-    t5 = x0 * z5 + x4 * z1 + x5 * z0;
+    /* each coefficient is a sum of three products, accumulated before a single reduction */
+    t0 = x0.mul_no_reduce(z0); my_Fp2::add_no_reduce(t0, tmp1.mul_no_reduce(z4)); my_Fp2::add_no_reduce(t0, tmp2.mul_no_reduce(z3));
+    t1 = x0.mul_no_reduce(z1); my_Fp2::add_no_reduce(t1, tmp1.mul_no_reduce(z5)); my_Fp2::add_no_reduce(t1, tmp2.mul_no_reduce(z4));
+    t2 = x0.mul_no_reduce(z2); my_Fp2::add_no_reduce(t2, x4.mul_no_reduce(z3));   my_Fp2::add_no_reduce(t2, tmp2.mul_no_reduce(z5));
+    t3 = x0.mul_no_reduce(z3); my_Fp2::add_no_reduce(t3, tmp1.mul_no_reduce(z2)); my_Fp2::add_no_reduce(t3, tmp2.mul_no_reduce(z1));
+    t4 = x0.mul_no_reduce(z4); my_Fp2::add_no_reduce(t4, x4.mul_no_reduce(z0));   my_Fp2::add_no_reduce(t4, tmp2.mul_no_reduce(z2));
+    t5 = x0.mul_no_reduce(z5); my_Fp2::add_no_reduce(t5, x4.mul_no_reduce(z1));   my_Fp2::add_no_reduce(t5, x5.mul_no_reduce(z0));
 
-    return Fp12_2over3over2_model<n,modulus>(my_Fp6(t0,t1,t2),my_Fp6(t3,t4,t5));
+    return Fp12_2over3over2_model<n,modulus>(my_Fp6(my_Fp2::reduce(t0), my_Fp2::reduce(t1), my_Fp2::reduce(t2)),
+                                             my_Fp6(my_Fp2::reduce(t3), my_Fp2::reduce(t4), my_Fp2::reduce(t5)));
 }
 
 template<mp_size_t n, const bigint<n>& modulus>
 Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::mul_by_024(const Fp2_model<n, modulus> &ell_0,
                                                                                 const Fp2_model<n, modulus> &ell_VW,
                                                                                 const Fp2_model<n, modulus> &ell_VV) const
+{
+    Fp12_2over3over2_model<n,modulus> result(*this);
+    return result.mul_by_024_inplace(ell_0, ell_VW, ell_VV);
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp12_2over3over2_model<n,modulus>& Fp12_2over3over2_model<n,modulus>::mul_by_024_inplace(const Fp2_model<n, modulus> &ell_0,
+                                                                                         const Fp2_model<n, modulus> &ell_VW,
+                                                                                         const Fp2_model<n, modulus> &ell_VV)
 {
     /* OLD: naive implementation
        Fp12_2over3over2_model<n,modulus> a(my_Fp6(ell_0, my_Fp2::zero(), ell_VV),
@@ -392,76 +470,101 @@ Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::mul_by_024(
 
        return (*this) * a;
     */
-    my_Fp2 z0 = this->c0.c0;
-    my_Fp2 z1 = this->c0.c1;
-    my_Fp2 z2 = this->c0.c2;
-    my_Fp2 z3 = this->c1.c0;
-    my_Fp2 z4 = this->c1.c1;
-    my_Fp2 z5 = this->c1.c2;
+    typedef typename my_Fp2::unreduced my_Fp2_unreduced;
 
-    my_Fp2 x0 = ell_0;
-    my_Fp2 x2 = ell_VV;
-    my_Fp2 x4 = ell_VW;
+    const my_Fp2 &z0 = this->c0.c0;
+    const my_Fp2 &z1 = this->c0.c1;
+    const my_Fp2 &z2 = this->c0.c2;
+    const my_Fp2 &z3 = this->c1.c0;
+    const my_Fp2 &z4 = this->c1.c1;
+    const my_Fp2 &z5 = this->c1.c2;
 
-    my_Fp2 t0, t1, t2, s0, T3, T4, D0, D2, D4, S1;
+    const my_Fp2 &x0 = ell_0;
+    const my_Fp2 &x2 = ell_VV;
+    const my_Fp2 &x4 = ell_VW;
 
-    D0 = z0 * x0;
-    D2 = z2 * x2;
-    D4 = z4 * x4;
-    t2 = z0 + z4;
-    t1 = z0 + z2;
-    s0 = z1 + z3 + z5;
+    /*
+      Same Karatsuba-style schedule as before, but every product stays in
+      double width: only the four sums multiplied by non_residue and the six
+      output coefficients are reduced.
+    */
+    const my_Fp2_unreduced D0 = z0.mul_no_reduce(x0);
+    const my_Fp2_unreduced D2 = z2.mul_no_reduce(x2);
+    const my_Fp2_unreduced D4 = z4.mul_no_reduce(x4);
+    my_Fp2_unreduced S1, T3, r0, r1, r2, r3, r4, r5;
 
     // For z.a_.a_ = z0.
-    S1 = z1 * x2;
-    T3 = S1 + D4;
-    T4 = my_Fp6::non_residue * T3 + D0;
-    z0 = T4;
+    S1 = z1.mul_no_reduce(x2);
+    T3 = S1;
+    my_Fp2::add_no_reduce(T3, D4);
+    r0 = my_Fp6::mul_by_non_residue_no_reduce(my_Fp2::reduce(T3));
+    my_Fp2::add_no_reduce(r0, D0);
 
     // For z.a_.b_ = z1
-    T3 = z5 * x4;
-    S1 = S1 + T3;
-    T3 = T3 + D2;
-    T4 = my_Fp6::non_residue * T3;
-    T3 = z1 * x0;
-    S1 = S1 + T3;
-    T4 = T4 + T3;
-    z1 = T4;
+    T3 = z5.mul_no_reduce(x4);
+    my_Fp2::add_no_reduce(S1, T3);
+    my_Fp2::add_no_reduce(T3, D2);
+    r1 = my_Fp6::mul_by_non_residue_no_reduce(my_Fp2::reduce(T3));
+    T3 = z1.mul_no_reduce(x0);
+    my_Fp2::add_no_reduce(S1, T3);
+    my_Fp2::add_no_reduce(r1, T3);
 
     // For z.a_.c_ = z2
-    t0 = x0 + x2;
-    T3 = t1 * t0 - D0 - D2;
-    T4 = z3 * x4;
-    S1 = S1 + T4;
-    T3 = T3 + T4;
-
-    // For z.b_.a_ = z3 (z3 needs z2)
-    t0 = z2 + z4;
-    z2 = T3;
-    t1 = x2 + x4;
-    T3 = t0 * t1 - D2 - D4;
-    T4 = my_Fp6::non_residue * T3;
-    T3 = z3 * x0;
-    S1 = S1 + T3;
-    T4 = T4 + T3;
-    z3 = T4;
+    r2 = (z0 + z2).mul_no_reduce(x0 + x2);
+    my_Fp2::sub_no_reduce(r2, D0);
+    my_Fp2::sub_no_reduce(r2, D2);
+    T3 = z3.mul_no_reduce(x4);
+    my_Fp2::add_no_reduce(S1, T3);
+    my_Fp2::add_no_reduce(r2, T3);
+
+    // For z.b_.a_ = z3
+    T3 = (z2 + z4).mul_no_reduce(x2 + x4);
+    my_Fp2::sub_no_reduce(T3, D2);
+    my_Fp2::sub_no_reduce(T3, D4);
+    r3 = my_Fp6::mul_by_non_residue_no_reduce(my_Fp2::reduce(T3));
+    T3 = z3.mul_no_reduce(x0);
+    my_Fp2::add_no_reduce(S1, T3);
+    my_Fp2::add_no_reduce(r3, T3);
 
     // For z.b_.b_ = z4
-    T3 = z5 * x2;
-    S1 = S1 + T3;
-    T4 = my_Fp6::non_residue * T3;
-    t0 = x0 + x4;
-    T3 = t2 * t0 - D0 - D4;
-    T4 = T4 + T3;
-    z4 = T4;
+    T3 = z5.mul_no_reduce(x2);
+    my_Fp2::add_no_reduce(S1, T3);
+    r4 = my_Fp6::mul_by_non_residue_no_reduce(my_Fp2::reduce(T3));
+    T3 = (z0 + z4).mul_no_reduce(x0 + x4);
+    my_Fp2::sub_no_reduce(T3, D0);
+    my_Fp2::sub_no_reduce(T3, D4);
+    my_Fp2::add_no_reduce(r4, T3);
 
     // For z.b_.c_ = z5.
-    t0 = x0 + x2 + x4;
-    T3 = s0 * t0 - S1;
-    z5 = T3;
+    r5 = (z1 + z3 + z5).mul_no_reduce(x0 + x2 + x4);
+    my_Fp2::sub_no_reduce(r5, S1);
+
+    /* all reads of z0..z5 are done, so the result can be written in place */
+    this->c0.c0 = my_Fp2::reduce(r0);
+    this->c0.c1 = my_Fp2::reduce(r1);
+    this->c0.c2 = my_Fp2::reduce(r2);
+    this->c1.c0 = my_Fp2::reduce(r3);
+    this->c1.c1 = my_Fp2::reduce(r4);
+    this->c1.c2 = my_Fp2::reduce(r5);
+    return (*this);
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp12_2over3over2_model<n,modulus>::Fp4_square(my_Fp2 &c0, my_Fp2 &c1, const my_Fp2 &a, const my_Fp2 &b)
+{
+    /* Karatsuba squaring: c0 = a^2 + non_residue * b^2, c1 = (a + b)^2 - a^2 - b^2 */
+    const typename my_Fp2::unreduced asq = a.squared_no_reduce();
+    const typename my_Fp2::unreduced bsq = b.squared_no_reduce();
+
+    typename my_Fp2::unreduced t0 = my_Fp6::mul_by_non_residue_no_reduce(my_Fp2::reduce(bsq));
+    my_Fp2::add_no_reduce(t0, asq);
 
-    return Fp12_2over3over2_model<n,modulus>(my_Fp6(z0,z1,z2),my_Fp6(z3,z4,z5));
+    typename my_Fp2::unreduced t1 = (a + b).squared_no_reduce();
+    my_Fp2::sub_no_reduce(t1, asq);
+    my_Fp2::sub_no_reduce(t1, bsq);
 
+    c0 = my_Fp2::reduce(t0);
+    c1 = my_Fp2::reduce(t1);
 }
 
 template<mp_size_t n, const bigint<n>& modulus>
@@ -477,14 +580,14 @@ Fp12_2over3over2_model<n, modulus> Fp12_2over3over2_model<n,modulus>::cyclotomic
         {
             if (found_one)
             {
-                res = res.cyclotomic_squared();
+                res.cyclotomic_square_inplace();
             }
 
             static const mp_limb_t one = 1;
             if (exponent.data[i] & (one<<j))
             {
                 found_one = true;
-                res = res * (*this);
+                res.mul_into(*this, res);
             }
         }
     }
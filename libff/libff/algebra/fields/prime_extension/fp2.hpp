@@ -52,6 +52,13 @@ public:
     static Fp2_model<n, modulus> nqr; // a quadratic nonresidue in Fp2
     static Fp2_model<n, modulus> nqr_to_t; // nqr^t
     static my_Fp Frobenius_coeffs_c1[2]; // non_residue^((modulus^i-1)/2) for i=0,1
+    static bool non_residue_is_minus_one; // set by curve initialization when U^2 = -1; enables cheaper formulas
+
+    /** Pair of double-width accumulators for lazy reduction, see Fp_model::unreduced. */
+    struct unreduced
+    {
+        typename my_Fp::unreduced c0, c1;
+    };
 
     my_Fp c0, c1;
     Fp2_model() {};
@@ -101,6 +108,18 @@ public:
     Fp2_model squared_karatsuba() const;
     Fp2_model squared_complex() const;
 
+    /* In-place and output-parameter forms; result may alias this or other. */
+    void mul_into(const Fp2_model &other, Fp2_model &result) const;
+    Fp2_model& square_inplace();
+    Fp2_model& frobenius_inplace(unsigned long power);
+
+    /* Lazy reduction: products are accumulated in double width and reduced once. */
+    unreduced mul_no_reduce(const Fp2_model &other) const;
+    unreduced squared_no_reduce() const;
+    static Fp2_model reduce(const unreduced &x);
+    static void add_no_reduce(unreduced &acc, const unreduced &other);
+    static void sub_no_reduce(unreduced &acc, const unreduced &other);
+
     static std::size_t ceil_size_in_bits() { return 2 * my_Fp::ceil_size_in_bits(); }
     static std::size_t floor_size_in_bits() { return 2 * my_Fp::floor_size_in_bits(); }
 
@@ -165,6 +184,9 @@ Fp2_model<n, modulus> Fp2_model<n, modulus>::nqr_to_t;
 template<mp_size_t n, const bigint<n>& modulus>
 Fp_model<n, modulus> Fp2_model<n, modulus>::Frobenius_coeffs_c1[2];
 
+template<mp_size_t n, const bigint<n>& modulus>
+bool Fp2_model<n, modulus>::non_residue_is_minus_one = false;
+
 } // namespace libff
 #include <libff/algebra/fields/prime_extension/fp2.tcc>
 
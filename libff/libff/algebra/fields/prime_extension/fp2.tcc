@@ -88,19 +88,21 @@ Fp2_model<n, modulus> operator*(const Fp_model<n, modulus> &lhs, const Fp2_model
 
 template<mp_size_t n, const bigint<n>& modulus>
 Fp2_model<n,modulus> Fp2_model<n,modulus>::operator*(const Fp2_model<n,modulus> &other) const
+{
+    Fp2_model<n,modulus> result;
+    this->mul_into(other, result);
+    return result;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp2_model<n,modulus>::mul_into(const Fp2_model<n,modulus> &other, Fp2_model<n,modulus> &result) const
 {
 #ifdef PROFILE_OP_COUNTS
     this->mul_cnt++;
 #endif
-    /* Devegili OhEig Scott Dahab --- Multiplication and Squaring on Pairing-Friendly Fields.pdf; Section 3 (Karatsuba) */
-    const my_Fp
-        &A = other.c0, &B = other.c1,
-        &a = this->c0, &b = this->c1;
-    const my_Fp aA = a * A;
-    const my_Fp bB = b * B;
-
-    return Fp2_model<n,modulus>(aA + non_residue * bB,
-                                (a + b)*(A+B) - aA - bB);
+    const unreduced res = this->mul_no_reduce(other);
+    result.c0 = my_Fp::reduce(res.c0);
+    result.c1 = my_Fp::reduce(res.c1);
 }
 
 template<mp_size_t n, const bigint<n>& modulus>
@@ -140,7 +142,7 @@ Fp2_model<n,modulus>& Fp2_model<n,modulus>::operator-=(const Fp2_model<n,modulus
 template<mp_size_t n, const bigint<n>& modulus>
 Fp2_model<n,modulus>& Fp2_model<n,modulus>::operator*=(const Fp2_model<n,modulus>& other)
 {
-    (*this) = *this * other;
+    this->mul_into(other, *this);
     return (*this);
 }
 
@@ -168,7 +170,26 @@ Fp2_model<n,modulus> Fp2_model<n,modulus>::squared() const
 template<mp_size_t n, const bigint<n>& modulus>
 Fp2_model<n,modulus>& Fp2_model<n,modulus>::square()
 {
-    (*this) = squared();
+    return square_inplace();
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp2_model<n,modulus>& Fp2_model<n,modulus>::square_inplace()
+{
+    if (non_residue_is_minus_one)
+    {
+#ifdef PROFILE_OP_COUNTS
+        this->sqr_cnt++;
+#endif
+        /* complex squaring, see squared_complex() */
+        const my_Fp t = (c0 + c1) * (c0 - c1);
+        c1 *= (c0 + c0);
+        c0 = t;
+    }
+    else
+    {
+        (*this) = squared_complex();
+    }
     return (*this);
 }
 
@@ -196,12 +217,91 @@ Fp2_model<n,modulus> Fp2_model<n,modulus>::squared_complex() const
 #endif
     /* Devegili OhEig Scott Dahab --- Multiplication and Squaring on Pairing-Friendly Fields.pdf; Section 3 (Complex squaring) */
     const my_Fp &a = this->c0, &b = this->c1;
+    if (non_residue_is_minus_one)
+    {
+        /* (a + b*U)^2 = (a + b)(a - b) + 2ab*U */
+        return Fp2_model<n,modulus>((a + b) * (a - b),
+                                    a * (b + b));
+    }
     const my_Fp ab = a * b;
 
     return Fp2_model<n,modulus>((a + b) * (a + non_residue * b) - ab - non_residue * ab,
                                 ab + ab);
 }
 
+template<mp_size_t n, const bigint<n>& modulus>
+typename Fp2_model<n,modulus>::unreduced Fp2_model<n,modulus>::mul_no_reduce(const Fp2_model<n,modulus> &other) const
+{
+    /* Devegili OhEig Scott Dahab --- Multiplication and Squaring on Pairing-Friendly Fields.pdf; Section 3 (Karatsuba) */
+    const my_Fp
+        &A = other.c0, &B = other.c1,
+        &a = this->c0, &b = this->c1;
+    const typename my_Fp::unreduced aA = a.mul_no_reduce(A);
+    const typename my_Fp::unreduced bB = b.mul_no_reduce(B);
+
+    unreduced res;
+    res.c0 = aA;
+    if (non_residue_is_minus_one)
+    {
+        my_Fp::sub_no_reduce(res.c0, bB);
+    }
+    else
+    {
+        my_Fp::add_no_reduce(res.c0, non_residue.mul_no_reduce(my_Fp::reduce(bB)));
+    }
+    res.c1 = (a + b).mul_no_reduce(A + B);
+    my_Fp::sub_no_reduce(res.c1, aA);
+    my_Fp::sub_no_reduce(res.c1, bB);
+    return res;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+typename Fp2_model<n,modulus>::unreduced Fp2_model<n,modulus>::squared_no_reduce() const
+{
+    const my_Fp &a = this->c0, &b = this->c1;
+
+    unreduced res;
+    if (non_residue_is_minus_one)
+    {
+        /* complex squaring, see squared_complex() */
+        res.c0 = (a + b).mul_no_reduce(a - b);
+        res.c1 = a.mul_no_reduce(b + b);
+    }
+    else
+    {
+        /* Karatsuba squaring, see squared_karatsuba() */
+        const typename my_Fp::unreduced asq = a.squared_no_reduce();
+        const typename my_Fp::unreduced bsq = b.squared_no_reduce();
+        res.c0 = asq;
+        my_Fp::add_no_reduce(res.c0, non_residue.mul_no_reduce(my_Fp::reduce(bsq)));
+        res.c1 = (a + b).squared_no_reduce();
+        my_Fp::sub_no_reduce(res.c1, asq);
+        my_Fp::sub_no_reduce(res.c1, bsq);
+    }
+    return res;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp2_model<n,modulus> Fp2_model<n,modulus>::reduce(const unreduced &x)
+{
+    return Fp2_model<n,modulus>(my_Fp::reduce(x.c0),
+                                my_Fp::reduce(x.c1));
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp2_model<n,modulus>::add_no_reduce(unreduced &acc, const unreduced &other)
+{
+    my_Fp::add_no_reduce(acc.c0, other.c0);
+    my_Fp::add_no_reduce(acc.c1, other.c1);
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp2_model<n,modulus>::sub_no_reduce(unreduced &acc, const unreduced &other)
+{
+    my_Fp::sub_no_reduce(acc.c0, other.c0);
+    my_Fp::sub_no_reduce(acc.c1, other.c1);
+}
+
 template<mp_size_t n, const bigint<n>& modulus>
 Fp2_model<n,modulus> Fp2_model<n,modulus>::inverse() const
 {
@@ -235,6 +335,17 @@ Fp2_model<n,modulus> Fp2_model<n,modulus>::Frobenius_map(unsigned long power) co
                                 Frobenius_coeffs_c1[power % 2] * c1);
 }
 
+template<mp_size_t n, const bigint<n>& modulus>
+Fp2_model<n,modulus>& Fp2_model<n,modulus>::frobenius_inplace(unsigned long power)
+{
+    if (power % 2)
+    {
+        /* Frobenius_coeffs_c1[1] = non_residue^((p-1)/2) = -1, as non_residue is not a square */
+        c1 = -c1;
+    }
+    return (*this);
+}
+
 template<mp_size_t n, const bigint<n>& modulus>
 std::optional<Fp2_model<n,modulus>> Fp2_model<n,modulus>::sqrt() const
 {
@@ -56,6 +56,12 @@ public:
     static my_Fp2 Frobenius_coeffs_c1[6]; // non_residue^((modulus^i-1)/3)   for i=0,1,2,3,4,5
     static my_Fp2 Frobenius_coeffs_c2[6]; // non_residue^((2*modulus^i-2)/3) for i=0,1,2,3,4,5
 
+    /** Triple of Fp2 double-width accumulators for lazy reduction, see Fp_model::unreduced. */
+    struct unreduced
+    {
+        typename my_Fp2::unreduced c0, c1, c2;
+    };
+
     my_Fp2 c0, c1, c2;
     Fp6_3over2_model() {};
     Fp6_3over2_model(const my_Fp2& c0, const my_Fp2& c1, const my_Fp2& c2) : c0(c0), c1(c1), c2(c2) {};
@@ -104,6 +110,19 @@ public:
 
     static my_Fp2 mul_by_non_residue(const my_Fp2 &elt);
 
+    /* In-place and output-parameter forms; result may alias this or other. */
+    void mul_into(const Fp6_3over2_model &other, Fp6_3over2_model &result) const;
+    Fp6_3over2_model& square_inplace();
+    Fp6_3over2_model& frobenius_inplace(unsigned long power);
+
+    /* Lazy reduction: products are accumulated in double width and reduced once. */
+    unreduced mul_no_reduce(const Fp6_3over2_model &other) const;
+    unreduced squared_no_reduce() const;
+    static Fp6_3over2_model reduce(const unreduced &x);
+    static void add_no_reduce(unreduced &acc, const unreduced &other);
+    static void sub_no_reduce(unreduced &acc, const unreduced &other);
+    static typename my_Fp2::unreduced mul_by_non_residue_no_reduce(const my_Fp2 &elt);
+
     static std::size_t ceil_size_in_bits() { return 3 * my_Fp2::ceil_size_in_bits(); }
     static std::size_t floor_size_in_bits() { return 3 * my_Fp2::floor_size_in_bits(); }
 
@@ -21,6 +21,12 @@ Fp2_model<n, modulus> Fp6_3over2_model<n,modulus>::mul_by_non_residue(const Fp2_
     return Fp2_model<n, modulus>(non_residue * elt);
 }
 
+template<mp_size_t n, const bigint<n>& modulus>
+typename Fp2_model<n, modulus>::unreduced Fp6_3over2_model<n,modulus>::mul_by_non_residue_no_reduce(const Fp2_model<n, modulus> &elt)
+{
+    return non_residue.mul_no_reduce(elt);
+}
+
 template<mp_size_t n, const bigint<n>& modulus>
 Fp6_3over2_model<n,modulus> Fp6_3over2_model<n,modulus>::zero()
 {
@@ -108,21 +114,22 @@ Fp6_3over2_model<n, modulus> operator*(const Fp2_model<n, modulus> &lhs, const F
 
 template<mp_size_t n, const bigint<n>& modulus>
 Fp6_3over2_model<n,modulus> Fp6_3over2_model<n,modulus>::operator*(const Fp6_3over2_model<n,modulus> &other) const
+{
+    Fp6_3over2_model<n,modulus> result;
+    this->mul_into(other, result);
+    return result;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp6_3over2_model<n,modulus>::mul_into(const Fp6_3over2_model<n,modulus> &other, Fp6_3over2_model<n,modulus> &result) const
 {
 #ifdef PROFILE_OP_COUNTS
     this->mul_cnt++;
 #endif
-    /* Devegili OhEig Scott Dahab --- Multiplication and Squaring on Pairing-Friendly Fields.pdf; Section 4 (Karatsuba) */
-
-    const my_Fp2 &A = other.c0, &B = other.c1, &C = other.c2,
-                 &a = this->c0, &b = this->c1, &c = this->c2;
-    const my_Fp2 aA = a*A;
-    const my_Fp2 bB = b*B;
-    const my_Fp2 cC = c*C;
-
-    return Fp6_3over2_model<n,modulus>(aA + Fp6_3over2_model<n,modulus>::mul_by_non_residue((b+c)*(B+C)-bB-cC),
-                                       (a+b)*(A+B)-aA-bB+Fp6_3over2_model<n,modulus>::mul_by_non_residue(cC),
-                                       (a+c)*(A+C)-aA+bB-cC);
+    const unreduced res = this->mul_no_reduce(other);
+    result.c0 = my_Fp2::reduce(res.c0);
+    result.c1 = my_Fp2::reduce(res.c1);
+    result.c2 = my_Fp2::reduce(res.c2);
 }
 
 template<mp_size_t n, const bigint<n>& modulus>
@@ -163,7 +170,7 @@ Fp6_3over2_model<n,modulus>& Fp6_3over2_model<n,modulus>::operator-=(const Fp6_3
 template<mp_size_t n, const bigint<n>& modulus>
 Fp6_3over2_model<n,modulus>& Fp6_3over2_model<n,modulus>::operator*=(const Fp6_3over2_model<n,modulus>& other)
 {
-    (*this) = *this * other;
+    this->mul_into(other, *this);
     return (*this);
 }
 
@@ -188,26 +195,108 @@ Fp6_3over2_model<n,modulus> Fp6_3over2_model<n,modulus>::squared() const
 #ifdef PROFILE_OP_COUNTS
     this->sqr_cnt++;
 #endif
+    return reduce(this->squared_no_reduce());
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+typename Fp6_3over2_model<n,modulus>::unreduced Fp6_3over2_model<n,modulus>::mul_no_reduce(const Fp6_3over2_model<n,modulus> &other) const
+{
+    /* Devegili OhEig Scott Dahab --- Multiplication and Squaring on Pairing-Friendly Fields.pdf; Section 4 (Karatsuba) */
+
+    const my_Fp2 &A = other.c0, &B = other.c1, &C = other.c2,
+                 &a = this->c0, &b = this->c1, &c = this->c2;
+    const typename my_Fp2::unreduced aA = a.mul_no_reduce(A);
+    const typename my_Fp2::unreduced bB = b.mul_no_reduce(B);
+    const typename my_Fp2::unreduced cC = c.mul_no_reduce(C);
+
+    /* only the two terms multiplied by non_residue are reduced early */
+    typename my_Fp2::unreduced t = (b+c).mul_no_reduce(B+C);
+    my_Fp2::sub_no_reduce(t, bB);
+    my_Fp2::sub_no_reduce(t, cC);
+
+    unreduced res;
+    res.c0 = aA;
+    my_Fp2::add_no_reduce(res.c0, mul_by_non_residue_no_reduce(my_Fp2::reduce(t)));
+
+    res.c1 = (a+b).mul_no_reduce(A+B);
+    my_Fp2::sub_no_reduce(res.c1, aA);
+    my_Fp2::sub_no_reduce(res.c1, bB);
+    my_Fp2::add_no_reduce(res.c1, mul_by_non_residue_no_reduce(my_Fp2::reduce(cC)));
+
+    res.c2 = (a+c).mul_no_reduce(A+C);
+    my_Fp2::sub_no_reduce(res.c2, aA);
+    my_Fp2::add_no_reduce(res.c2, bB);
+    my_Fp2::sub_no_reduce(res.c2, cC);
+    return res;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+typename Fp6_3over2_model<n,modulus>::unreduced Fp6_3over2_model<n,modulus>::squared_no_reduce() const
+{
     /* Devegili OhEig Scott Dahab --- Multiplication and Squaring on Pairing-Friendly Fields.pdf; Section 4 (CH-SQR2) */
 
     const my_Fp2 &a = this->c0, &b = this->c1, &c = this->c2;
-    const my_Fp2 s0 = a.squared();
-    const my_Fp2 ab = a*b;
-    const my_Fp2 s1 = ab + ab;
-    const my_Fp2 s2 = (a - b + c).squared();
-    const my_Fp2 bc = b*c;
-    const my_Fp2 s3 = bc + bc;
-    const my_Fp2 s4 = c.squared();
+    const typename my_Fp2::unreduced s0 = a.squared_no_reduce();
+    const typename my_Fp2::unreduced s1 = a.mul_no_reduce(b + b);
+    const typename my_Fp2::unreduced s2 = (a - b + c).squared_no_reduce();
+    const typename my_Fp2::unreduced s3 = b.mul_no_reduce(c + c);
+    const typename my_Fp2::unreduced s4 = c.squared_no_reduce();
 
-    return Fp6_3over2_model<n,modulus>(s0 + Fp6_3over2_model<n,modulus>::mul_by_non_residue(s3),
-                                       s1 + Fp6_3over2_model<n,modulus>::mul_by_non_residue(s4),
-                                       s1 + s2 + s3 - s0 - s4);
+    unreduced res;
+    res.c0 = s0;
+    my_Fp2::add_no_reduce(res.c0, mul_by_non_residue_no_reduce(my_Fp2::reduce(s3)));
+
+    res.c1 = s1;
+    my_Fp2::add_no_reduce(res.c1, mul_by_non_residue_no_reduce(my_Fp2::reduce(s4)));
+
+    res.c2 = s1;
+    my_Fp2::add_no_reduce(res.c2, s2);
+    my_Fp2::add_no_reduce(res.c2, s3);
+    my_Fp2::sub_no_reduce(res.c2, s0);
+    my_Fp2::sub_no_reduce(res.c2, s4);
+    return res;
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp6_3over2_model<n,modulus> Fp6_3over2_model<n,modulus>::reduce(const unreduced &x)
+{
+    return Fp6_3over2_model<n,modulus>(my_Fp2::reduce(x.c0),
+                                       my_Fp2::reduce(x.c1),
+                                       my_Fp2::reduce(x.c2));
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp6_3over2_model<n,modulus>::add_no_reduce(unreduced &acc, const unreduced &other)
+{
+    my_Fp2::add_no_reduce(acc.c0, other.c0);
+    my_Fp2::add_no_reduce(acc.c1, other.c1);
+    my_Fp2::add_no_reduce(acc.c2, other.c2);
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp6_3over2_model<n,modulus>::sub_no_reduce(unreduced &acc, const unreduced &other)
+{
+    my_Fp2::sub_no_reduce(acc.c0, other.c0);
+    my_Fp2::sub_no_reduce(acc.c1, other.c1);
+    my_Fp2::sub_no_reduce(acc.c2, other.c2);
 }
 
 template<mp_size_t n, const bigint<n>& modulus>
 Fp6_3over2_model<n,modulus>& Fp6_3over2_model<n,modulus>::square()
 {
-    (*this) = squared();
+    return square_inplace();
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp6_3over2_model<n,modulus>& Fp6_3over2_model<n,modulus>::square_inplace()
+{
+#ifdef PROFILE_OP_COUNTS
+    this->sqr_cnt++;
+#endif
+    const unreduced res = this->squared_no_reduce();
+    c0 = my_Fp2::reduce(res.c0);
+    c1 = my_Fp2::reduce(res.c1);
+    c2 = my_Fp2::reduce(res.c2);
     return (*this);
 }
 
@@ -248,6 +337,20 @@ Fp6_3over2_model<n,modulus> Fp6_3over2_model<n,modulus>::Frobenius_map(unsigned
                                        Frobenius_coeffs_c2[power % 6] * c2.Frobenius_map(power));
 }
 
+template<mp_size_t n, const bigint<n>& modulus>
+Fp6_3over2_model<n,modulus>& Fp6_3over2_model<n,modulus>::frobenius_inplace(unsigned long power)
+{
+    c0.frobenius_inplace(power);
+    c1.frobenius_inplace(power);
+    c2.frobenius_inplace(power);
+    if (power % 6)
+    {
+        c1 *= Frobenius_coeffs_c1[power % 6];
+        c2 *= Frobenius_coeffs_c2[power % 6];
+    }
+    return (*this);
+}
+
 template<mp_size_t n, const bigint<n>& modulus>
 std::optional<Fp6_3over2_model<n,modulus>> Fp6_3over2_model<n,modulus>::sqrt() const
 {
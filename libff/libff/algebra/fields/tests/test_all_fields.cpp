@@ -22,6 +22,7 @@
 #include "libff/common/utils.hpp"
 
 #include <gtest/gtest.h>
+#include <optional>
 #include <set>
 
 using namespace libff;
@@ -57,6 +58,14 @@ void expect_equal_or_negative(FieldT x, FieldT y)
     EXPECT_TRUE(x == y || x == -y);
 }
 
+/* for the prime fields, whose sqrt() is empty on non-squares */
+template<typename FieldT>
+void expect_equal_or_negative(std::optional<FieldT> x, FieldT y)
+{
+    ASSERT_TRUE(x.has_value());
+    expect_equal_or_negative(*x, y);
+}
+
 template<typename FieldT>
 void test_field()
 {
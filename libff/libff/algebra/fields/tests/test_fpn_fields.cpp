@@ -63,7 +63,7 @@ void test_sqrt()
     {
         FieldT a = FieldT::random_element();
         FieldT a_sq = a.squared();
-        FieldT a_sq_sqrt = a_sq.sqrt();
+        FieldT a_sq_sqrt = *a_sq.sqrt();
         EXPECT_TRUE(a_sq_sqrt == a || a_sq_sqrt == -a);
     }
 }
@@ -171,6 +171,68 @@ void test_cyclotomic_squaring<Fqk<mnt6_pp> >()
     EXPECT_EQ(beta.cyclotomic_squared(), beta.squared());
 }
 
+template<typename Fp12T>
+void test_Fp12_2over3over2_lazy_reduction()
+{
+    typedef typename Fp12T::my_Fp2 Fp2T;
+    typedef typename Fp12T::my_Fp6 Fp6T;
+
+    const Fp12T a = Fp12T::random_element();
+    const Fp12T b = Fp12T::random_element();
+    const Fp2T x0 = Fp2T::random_element();
+    const Fp2T x1 = Fp2T::random_element();
+    const Fp2T x2 = Fp2T::random_element();
+
+    // Sparse multiplications agree with the dense product.
+    EXPECT_EQ(a.mul_by_024(x0, x1, x2), a * Fp12T(Fp6T(x0, Fp2T::zero(), x2), Fp6T(Fp2T::zero(), x1, Fp2T::zero())));
+    EXPECT_EQ(a.mul_by_045(x0, x1, x2), a * Fp12T(Fp6T(x1, Fp2T::zero(), Fp2T::zero()), Fp6T(Fp2T::zero(), x0, x2)));
+
+    // Cyclotomic squaring, on an element of the cyclotomic subgroup.
+    const Fp12T c = a.Frobenius_map(6) * a.inverse();
+    const Fp12T d = c.Frobenius_map(2) * c;
+    EXPECT_EQ(d.cyclotomic_squared(), d.squared());
+
+    // The U^2 = -1 shortcuts agree with the generic formulas.
+    const Fp12T ab = a * b;
+    const Fp12T a_squared = a.squared();
+    const Fp2T x0x1 = x0 * x1;
+    const bool saved = Fp2T::non_residue_is_minus_one;
+    Fp2T::non_residue_is_minus_one = false;
+    EXPECT_EQ(a * b, ab);
+    EXPECT_EQ(a.squared(), a_squared);
+    EXPECT_EQ(x0 * x1, x0x1);
+    Fp2T::non_residue_is_minus_one = saved;
+}
+
+template<typename FieldT>
+void test_inplace_operations()
+{
+    const FieldT a = FieldT::random_element();
+    const FieldT b = FieldT::random_element();
+    const FieldT ab = a * b;
+
+    FieldT c;
+    a.mul_into(b, c);
+    EXPECT_EQ(c, ab);
+    c = a;
+    c.mul_into(b, c);
+    EXPECT_EQ(c, ab);
+    c = b;
+    a.mul_into(c, c);
+    EXPECT_EQ(c, ab);
+
+    c = a;
+    c.square_inplace();
+    EXPECT_EQ(c, a.squared());
+
+    for (size_t power = 0; power < 2 * FieldT::extension_degree(); ++power)
+    {
+        c = a;
+        c.frobenius_inplace(power);
+        EXPECT_EQ(c, a.Frobenius_map(power));
+    }
+}
+
 template<typename ppT>
 void test_all_fields()
 {
@@ -273,6 +335,30 @@ TEST_F(FpnFieldsTest, SquareTest)
     test_cyclotomic_squaring<Fqk<mnt4_pp> >();
 }
 
+TEST_F(FpnFieldsTest, LazyReductionTest)
+{
+    test_two_squarings<alt_bn128_Fq2>();
+    test_two_squarings<alt_bn128_Fq12>();
+    test_Fp12_2over3over2_lazy_reduction<alt_bn128_Fq12>();
+
+    test_two_squarings<bls12_381_Fq2>();
+    test_two_squarings<bls12_381_Fq12>();
+    test_Fp12_2over3over2_lazy_reduction<bls12_381_Fq12>();
+}
+
+TEST_F(FpnFieldsTest, InPlaceTest)
+{
+    test_inplace_operations<mnt4_Fq2>();
+
+    test_inplace_operations<alt_bn128_Fq2>();
+    test_inplace_operations<alt_bn128_Fq6>();
+    test_inplace_operations<alt_bn128_Fq12>();
+
+    test_inplace_operations<bls12_381_Fq2>();
+    test_inplace_operations<bls12_381_Fq6>();
+    test_inplace_operations<bls12_381_Fq12>();
+}
+
 TEST_F(FpnFieldsTest, ToomCookTest)
 {
     test_Fp4_toom_cook<mnt4_Fq4>();
@@ -40,9 +40,29 @@ enum multi_exp_method {
   * Requires that T implements .dbl() (and, if USE_MIXED_ADDITION is defined,
   * .to_special(), .mixed_add(), and batch_to_special()).
   */
- multi_exp_method_BDLO12
+ multi_exp_method_BDLO12,
+ /**
+  * BDLO12 with the buckets in affine coordinates. The additions into the
+  * buckets are scheduled in batches that touch each bucket at most once and
+  * share one batched inversion, so that an addition costs about 6 field
+  * multiplications instead of the 11 of a mixed addition; terms that would
+  * add twice to a bucket of a batch are left to a later batch.
+  * Falls back to multi_exp_method_BDLO12 for small inputs (see
+  * multi_exp_affine_min_window).
+  * Requires a short Weierstrass curve with a = 0 in Jacobian coordinates,
+  * such as alt_bn128 and bls12_381, whose bases should be in special form:
+  * other bases are added in Jacobian coordinates.
+  */
+ multi_exp_method_BDLO12_affine
 };
 
+/**
+ * The smallest window, and the most bucket additions per batched inversion,
+ * of multi_exp_method_BDLO12_affine.
+ */
+const std::size_t multi_exp_affine_min_window = 10;
+const std::size_t multi_exp_affine_max_batch = 2048;
+
 /**
  * Computes the sum
  * \sum_i scalar_start[i] * vec_start[i]
@@ -57,6 +77,28 @@ T multi_exp(typename std::vector<T>::const_iterator vec_start,
             typename std::vector<FieldT>::const_iterator scalar_end,
             const std::size_t chunks);
 
+/**
+ * As above, with the bases in an array, such as the points of a
+ * binary_file_view (see common/binary_file_view.hpp).
+ */
+template<typename T, typename FieldT, multi_exp_method Method>
+T multi_exp(const T *vec_start,
+            const T *vec_end,
+            typename std::vector<FieldT>::const_iterator scalar_start,
+            typename std::vector<FieldT>::const_iterator scalar_end,
+            const std::size_t chunks);
+
+/**
+ * As above, over count bases and count scalars held in arrays, so that points
+ * in an arena, a mapped file or memory owned by another language need not be
+ * copied into vectors first.
+ */
+template<typename T, typename FieldT, multi_exp_method Method>
+T multi_exp(const T *bases,
+            const FieldT *scalars,
+            const std::size_t count,
+            const std::size_t chunks);
+
 
 /**
  * A variant of multi_exp that takes advantage of the method mixed_add (instead
@@ -71,6 +113,12 @@ T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_star
                                 typename std::vector<FieldT>::const_iterator scalar_end,
                                 const std::size_t chunks);
 
+template<typename T, typename FieldT, multi_exp_method Method>
+T multi_exp_with_mixed_addition(const T *bases,
+                                const FieldT *scalars,
+                                const std::size_t count,
+                                const std::size_t chunks);
+
 /**
  * A convenience function for calculating a pure inner product, where the
  * more complicated methods are not required.
@@ -81,6 +129,44 @@ T inner_product(typename std::vector<T>::const_iterator a_start,
                 typename std::vector<T>::const_iterator b_start,
                 typename std::vector<T>::const_iterator b_end);
 
+template <typename T>
+T inner_product(const T *a, const T *b, const std::size_t count);
+
+/**
+ * An incremental form of multi_exp_method_BDLO12, for inputs that are not in
+ * memory all at once: terms are pushed in chunks, e.g. bases read from disk
+ * and scalars from a witness generator as they are produced, and finalize()
+ * returns the sum of all the terms pushed so far.
+ *
+ * The buckets of every window are kept between pushes, so memory is
+ * (FieldT::ceil_size_in_bits() / c + 1) * 2^c elements of T whatever the
+ * number of terms, with c chosen from the expected number of terms as in
+ * multi_exp and at most max_window. Terms with scalar zero are skipped and
+ * terms with scalar one are added directly. When compiled with MULTICORE,
+ * the windows of a push are processed in parallel. As with BDLO12, bases must
+ * be in special form when compiled with USE_MIXED_ADDITION.
+ */
+template<typename T, typename FieldT>
+class multi_exp_accumulator {
+private:
+    std::size_t c;
+    std::size_t num_windows;
+    std::vector<T> buckets;
+    T trivial_sum;
+    std::size_t num_terms;
+public:
+    static const std::size_t max_window = 16;
+
+    explicit multi_exp_accumulator(const std::size_t expected_count);
+
+    void push(const T *bases, const FieldT *scalars, const std::size_t count);
+    void push(const std::vector<T> &bases, const std::vector<FieldT> &scalars);
+
+    T finalize() const;
+    std::size_t size() const { return num_terms; }
+    std::size_t window() const { return c; }
+};
+
 /**
  * A window table stores window sizes for different instance sizes for fixed-base multi-scalar multiplications.
  */
@@ -120,6 +206,12 @@ std::vector<T> batch_exp_with_coeff(const std::size_t scalar_size,
                                     const FieldT &coeff,
                                     const std::vector<FieldT> &v);
 
+/**
+ * Converts every element of vec to special form, in slices of
+ * batch_slice_size elements (see field_utils.hpp) run with parallel_for.
+ * Each slice is converted in place on its task's thread, with
+ * T::batch_to_special_all_non_zeros(T*, count).
+ */
 template<typename T>
 void batch_to_special(std::vector<T> &vec);
 
@@ -16,8 +16,10 @@
 #include <type_traits>
 
 #include <libff/algebra/field_utils/bigint.hpp>
+#include <libff/algebra/field_utils/field_utils.hpp>
 #include <libff/algebra/scalar_multiplication/multiexp.hpp>
 #include <libff/algebra/scalar_multiplication/wnaf.hpp>
+#include <libff/common/parallel.hpp>
 #include <libff/common/profiling.hpp>
 #include <libff/common/utils.hpp>
 
@@ -25,6 +27,25 @@ namespace libff {
 
 using std::size_t;
 
+/* The c bits of exponent from bit k*c, which may span two limbs. */
+template<mp_size_t n>
+size_t multi_exp_window_digit(const bigint<n> &exponent, const size_t k, const size_t c)
+{
+    const size_t limb = (k*c) / GMP_NUMB_BITS;
+    const size_t shift = (k*c) % GMP_NUMB_BITS;
+    if (limb >= (size_t)n)
+    {
+        return 0;
+    }
+
+    mp_limb_t digit = exponent.data[limb] >> shift;
+    if (shift + c > GMP_NUMB_BITS && limb + 1 < (size_t)n)
+    {
+        digit |= exponent.data[limb + 1] << (GMP_NUMB_BITS - shift);
+    }
+    return digit & ((((mp_limb_t)1) << c) - 1);
+}
+
 template<mp_size_t n>
 class ordered_exponent {
 // to use std::push_heap and friends later
@@ -113,20 +134,22 @@ public:
  * is what's actually happening here, it's just that, for any given value of
  * Method, only one of the templates will be valid, and thus the correct
  * implementation will be used.
+ * BaseIt and ScalarIt are the iterator types of the bases and the scalars:
+ * vector iterators or pointers.
  */
 
-template<typename T, typename FieldT, multi_exp_method Method,
+template<typename T, typename FieldT, multi_exp_method Method, typename BaseIt, typename ScalarIt,
     typename std::enable_if<(Method == multi_exp_method_naive), int>::type = 0>
 T multi_exp_inner(
-    typename std::vector<T>::const_iterator vec_start,
-    typename std::vector<T>::const_iterator vec_end,
-    typename std::vector<FieldT>::const_iterator scalar_start,
-    typename std::vector<FieldT>::const_iterator scalar_end)
+    BaseIt vec_start,
+    BaseIt vec_end,
+    ScalarIt scalar_start,
+    ScalarIt scalar_end)
 {
     T result(T::zero());
 
-    typename std::vector<T>::const_iterator vec_it;
-    typename std::vector<FieldT>::const_iterator scalar_it;
+    BaseIt vec_it;
+    ScalarIt scalar_it;
 
     for (vec_it = vec_start, scalar_it = scalar_start; vec_it != vec_end; ++vec_it, ++scalar_it)
     {
@@ -138,18 +161,18 @@ T multi_exp_inner(
     return result;
 }
 
-template<typename T, typename FieldT, multi_exp_method Method,
+template<typename T, typename FieldT, multi_exp_method Method, typename BaseIt, typename ScalarIt,
     typename std::enable_if<(Method == multi_exp_method_naive_plain), int>::type = 0>
 T multi_exp_inner(
-    typename std::vector<T>::const_iterator vec_start,
-    typename std::vector<T>::const_iterator vec_end,
-    typename std::vector<FieldT>::const_iterator scalar_start,
-    typename std::vector<FieldT>::const_iterator scalar_end)
+    BaseIt vec_start,
+    BaseIt vec_end,
+    ScalarIt scalar_start,
+    ScalarIt scalar_end)
 {
     T result(T::zero());
 
-    typename std::vector<T>::const_iterator vec_it;
-    typename std::vector<FieldT>::const_iterator scalar_it;
+    BaseIt vec_it;
+    ScalarIt scalar_it;
 
     for (vec_it = vec_start, scalar_it = scalar_start; vec_it != vec_end; ++vec_it, ++scalar_it)
     {
@@ -160,13 +183,13 @@ T multi_exp_inner(
     return result;
 }
 
-template<typename T, typename FieldT, multi_exp_method Method,
+template<typename T, typename FieldT, multi_exp_method Method, typename BaseIt, typename ScalarIt,
     typename std::enable_if<(Method == multi_exp_method_BDLO12), int>::type = 0>
 T multi_exp_inner(
-    typename std::vector<T>::const_iterator bases,
-    typename std::vector<T>::const_iterator bases_end,
-    typename std::vector<FieldT>::const_iterator exponents,
-    typename std::vector<FieldT>::const_iterator exponents_end)
+    BaseIt bases,
+    BaseIt bases_end,
+    ScalarIt exponents,
+    ScalarIt exponents_end)
 {
     UNUSED(exponents_end);
     size_t length = bases_end - bases;
@@ -279,13 +302,225 @@ T multi_exp_inner(
     return result;
 }
 
-template<typename T, typename FieldT, multi_exp_method Method,
+template<typename T, typename FieldT, multi_exp_method Method, typename BaseIt, typename ScalarIt,
+    typename std::enable_if<(Method == multi_exp_method_BDLO12_affine), int>::type = 0>
+T multi_exp_inner(
+    BaseIt bases,
+    BaseIt bases_end,
+    ScalarIt exponents,
+    ScalarIt exponents_end)
+{
+    typedef typename std::decay<decltype(T::X)>::type CoordT;
+
+    size_t length = bases_end - bases;
+
+    // as in multi_exp_method_BDLO12
+    size_t log2_length = log2(length);
+    size_t c = log2_length - (log2_length / 3 - 2);
+    if (c < multi_exp_affine_min_window)
+    {
+        return multi_exp_inner<T, FieldT, multi_exp_method_BDLO12>(bases, bases_end, exponents, exponents_end);
+    }
+    // a batch fills about an eighth of the buckets, so few terms collide
+    const size_t max_batch = std::min(multi_exp_affine_max_batch, (size_t)1 << (c - 3));
+
+    const mp_size_t exp_num_limbs =
+        std::remove_reference<decltype(*exponents)>::type::num_limbs;
+    std::vector<bigint<exp_num_limbs> > bn_exponents(length);
+    std::vector<bool> affine(length);
+    size_t num_bits = 0;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        bn_exponents[i] = exponents[i].as_bigint();
+        num_bits = std::max(num_bits, bn_exponents[i].num_bits());
+        affine[i] = bases[i].is_special();
+    }
+
+    size_t num_groups = (num_bits + c - 1) / c;
+
+    const CoordT one = CoordT::one();
+    T result = T::zero();
+
+    std::vector<CoordT> bucket_x(1 << c), bucket_y(1 << c);
+    std::vector<bool> bucket_nonzero(1 << c);
+    // the batch in which each bucket was last scheduled, counting from 1
+    std::vector<size_t> bucket_batch(1 << c);
+    // buckets for what is not added in affine coordinates, allocated if needed
+    std::vector<T> jacobian_buckets;
+    size_t batch_id = 0;
+    size_t collisions = 0;
+
+    std::vector<std::pair<size_t, size_t> > pending, deferred, batch;
+    std::vector<CoordT> denominators;
+    batch.reserve(max_batch);
+    denominators.reserve(max_batch);
+
+    const auto add_jacobian = [&](const size_t id, const size_t i) {
+        if (jacobian_buckets.empty())
+        {
+            jacobian_buckets.assign(1 << c, T::zero());
+        }
+        jacobian_buckets[id] = jacobian_buckets[id] + bases[i];
+    };
+
+    // the additions of a batch are independent, so share one inversion, on this thread
+    std::vector<CoordT> denominator_prods(max_batch);
+    const auto flush = [&]() {
+        batch_invert<CoordT>(denominators.data(), denominator_prods.data(), denominators.size());
+        for (size_t j = 0; j < batch.size(); ++j)
+        {
+            const size_t id = batch[j].first;
+            const T &P = bases[batch[j].second];
+            const CoordT &x1 = bucket_x[id];
+            const CoordT &y1 = bucket_y[id];
+
+            // doublings are scheduled with denominator 2 y1 (see below)
+            CoordT numerator;
+            if (x1 == P.X)
+            {
+                const CoordT xx = x1.squared();
+                numerator = xx + xx + xx;
+            }
+            else
+            {
+                numerator = P.Y - y1;
+            }
+            const CoordT lambda = numerator * denominators[j];
+            const CoordT x3 = lambda.squared() - x1 - P.X;
+            bucket_y[id] = lambda * (x1 - x3) - y1;
+            bucket_x[id] = x3;
+        }
+        batch.clear();
+        denominators.clear();
+        collisions = 0;
+        ++batch_id;
+    };
+
+    for (size_t k = num_groups - 1; k <= num_groups; k--)
+    {
+        for (size_t i = 0; i < c; i++)
+        {
+            result = result.dbl();
+        }
+
+        std::fill(bucket_nonzero.begin(), bucket_nonzero.end(), false);
+        if (!jacobian_buckets.empty())
+        {
+            std::fill(jacobian_buckets.begin(), jacobian_buckets.end(), T::zero());
+        }
+
+        pending.clear();
+        for (size_t i = 0; i < length; i++)
+        {
+            const size_t id = multi_exp_window_digit(bn_exponents[i], k, c);
+            if (id == 0 || bases[i].is_zero())
+            {
+                continue;
+            }
+            if (!affine[i])
+            {
+                add_jacobian(id, i);
+                continue;
+            }
+            pending.emplace_back(id, i);
+        }
+
+        while (!pending.empty())
+        {
+            ++batch_id;
+            size_t scheduled = 0;
+            deferred.clear();
+
+            for (const auto &term : pending)
+            {
+                const size_t id = term.first;
+                const T &P = bases[term.second];
+
+                if (bucket_batch[id] == batch_id)
+                {
+                    // the batch is not full, but the terms keep colliding with it
+                    deferred.emplace_back(term);
+                    if (++collisions == max_batch)
+                    {
+                        flush();
+                    }
+                    continue;
+                }
+
+                if (!bucket_nonzero[id])
+                {
+                    bucket_x[id] = P.X;
+                    bucket_y[id] = P.Y;
+                    bucket_nonzero[id] = true;
+                    continue;
+                }
+
+                if (bucket_x[id] == P.X)
+                {
+                    if (bucket_y[id] != P.Y || bucket_y[id].is_zero())
+                    {
+                        // P = -bucket
+                        bucket_nonzero[id] = false;
+                        continue;
+                    }
+                    denominators.emplace_back(bucket_y[id] + bucket_y[id]);
+                }
+                else
+                {
+                    denominators.emplace_back(P.X - bucket_x[id]);
+                }
+                batch.emplace_back(term);
+                bucket_batch[id] = batch_id;
+                ++scheduled;
+
+                if (batch.size() == max_batch)
+                {
+                    flush();
+                }
+            }
+            if (!batch.empty())
+            {
+                flush();
+            }
+
+            // when the terms collide on few buckets, batches stay small; add the rest in Jacobian coordinates
+            if (4 * scheduled < pending.size())
+            {
+                for (const auto &term : deferred)
+                {
+                    add_jacobian(term.first, term.second);
+                }
+                deferred.clear();
+            }
+            pending.swap(deferred);
+        }
+
+        T running_sum = T::zero();
+        for (size_t id = (1u << c) - 1; id > 0; id--)
+        {
+            if (bucket_nonzero[id])
+            {
+                running_sum = running_sum.mixed_add(T(bucket_x[id], bucket_y[id], one));
+            }
+            if (!jacobian_buckets.empty())
+            {
+                running_sum = running_sum + jacobian_buckets[id];
+            }
+            result = result + running_sum;
+        }
+    }
+
+    return result;
+}
+
+template<typename T, typename FieldT, multi_exp_method Method, typename BaseIt, typename ScalarIt,
     typename std::enable_if<(Method == multi_exp_method_bos_coster), int>::type = 0>
 T multi_exp_inner(
-    typename std::vector<T>::const_iterator vec_start,
-    typename std::vector<T>::const_iterator vec_end,
-    typename std::vector<FieldT>::const_iterator scalar_start,
-    typename std::vector<FieldT>::const_iterator scalar_end)
+    BaseIt vec_start,
+    BaseIt vec_end,
+    ScalarIt scalar_start,
+    ScalarIt scalar_end)
 {
     const mp_size_t n = std::remove_reference<decltype(*scalar_start)>::type::num_limbs;
 
@@ -306,8 +541,8 @@ T multi_exp_inner(
     std::vector<T> g;
     g.reserve(odd_vec_len);
 
-    typename std::vector<T>::const_iterator vec_it;
-    typename std::vector<FieldT>::const_iterator scalar_it;
+    BaseIt vec_it;
+    ScalarIt scalar_it;
     size_t i;
     for (i=0, vec_it = vec_start, scalar_it = scalar_start; vec_it != vec_end; ++vec_it, ++scalar_it, ++i)
     {
@@ -397,12 +632,12 @@ T multi_exp_inner(
     return opt_result;
 }
 
-template<typename T, typename FieldT, multi_exp_method Method>
-T multi_exp(typename std::vector<T>::const_iterator vec_start,
-            typename std::vector<T>::const_iterator vec_end,
-            typename std::vector<FieldT>::const_iterator scalar_start,
-            typename std::vector<FieldT>::const_iterator scalar_end,
-            const size_t chunks)
+template<typename T, typename FieldT, multi_exp_method Method, typename BaseIt, typename ScalarIt>
+T multi_exp_chunks(BaseIt vec_start,
+                   BaseIt vec_end,
+                   ScalarIt scalar_start,
+                   ScalarIt scalar_end,
+                   const size_t chunks)
 {
     const size_t total = vec_end - vec_start;
     if ((total < chunks) || (chunks == 1))
@@ -416,17 +651,13 @@ T multi_exp(typename std::vector<T>::const_iterator vec_start,
 
     std::vector<T> partial(chunks, T::zero());
 
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-    for (size_t i = 0; i < chunks; ++i)
-    {
+    parallel_for(chunks, [&](const size_t i) {
         partial[i] = multi_exp_inner<T, FieldT, Method>(
              vec_start + i*one,
              (i == chunks-1 ? vec_end : vec_start + (i+1)*one),
              scalar_start + i*one,
              (i == chunks-1 ? scalar_end : scalar_start + (i+1)*one));
-    }
+    });
 
     T final = T::zero();
 
@@ -439,11 +670,40 @@ T multi_exp(typename std::vector<T>::const_iterator vec_start,
 }
 
 template<typename T, typename FieldT, multi_exp_method Method>
-T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_start,
-                                typename std::vector<T>::const_iterator vec_end,
-                                typename std::vector<FieldT>::const_iterator scalar_start,
-                                typename std::vector<FieldT>::const_iterator scalar_end,
-                                const size_t chunks)
+T multi_exp(typename std::vector<T>::const_iterator vec_start,
+            typename std::vector<T>::const_iterator vec_end,
+            typename std::vector<FieldT>::const_iterator scalar_start,
+            typename std::vector<FieldT>::const_iterator scalar_end,
+            const size_t chunks)
+{
+    return multi_exp_chunks<T, FieldT, Method>(vec_start, vec_end, scalar_start, scalar_end, chunks);
+}
+
+template<typename T, typename FieldT, multi_exp_method Method>
+T multi_exp(const T *vec_start,
+            const T *vec_end,
+            typename std::vector<FieldT>::const_iterator scalar_start,
+            typename std::vector<FieldT>::const_iterator scalar_end,
+            const size_t chunks)
+{
+    return multi_exp_chunks<T, FieldT, Method>(vec_start, vec_end, scalar_start, scalar_end, chunks);
+}
+
+template<typename T, typename FieldT, multi_exp_method Method>
+T multi_exp(const T *bases,
+            const FieldT *scalars,
+            const size_t count,
+            const size_t chunks)
+{
+    return multi_exp_chunks<T, FieldT, Method>(bases, bases + count, scalars, scalars + count, chunks);
+}
+
+template<typename T, typename FieldT, multi_exp_method Method, typename BaseIt, typename ScalarIt>
+T multi_exp_with_mixed_addition_range(BaseIt vec_start,
+                                      BaseIt vec_end,
+                                      ScalarIt scalar_start,
+                                      ScalarIt scalar_end,
+                                      const size_t chunks)
 {
 #ifndef NDEBUG
     assert(std::distance(vec_start, vec_end) == std::distance(scalar_start, scalar_end));
@@ -501,6 +761,25 @@ T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_star
     return acc + multi_exp<T, FieldT, Method>(g.begin(), g.end(), p.begin(), p.end(), chunks);
 }
 
+template<typename T, typename FieldT, multi_exp_method Method>
+T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_start,
+                                typename std::vector<T>::const_iterator vec_end,
+                                typename std::vector<FieldT>::const_iterator scalar_start,
+                                typename std::vector<FieldT>::const_iterator scalar_end,
+                                const size_t chunks)
+{
+    return multi_exp_with_mixed_addition_range<T, FieldT, Method>(vec_start, vec_end, scalar_start, scalar_end, chunks);
+}
+
+template<typename T, typename FieldT, multi_exp_method Method>
+T multi_exp_with_mixed_addition(const T *bases,
+                                const FieldT *scalars,
+                                const size_t count,
+                                const size_t chunks)
+{
+    return multi_exp_with_mixed_addition_range<T, FieldT, Method>(bases, bases + count, scalars, scalars + count, chunks);
+}
+
 template <typename T>
 T inner_product(typename std::vector<T>::const_iterator a_start,
                 typename std::vector<T>::const_iterator a_end,
@@ -512,6 +791,113 @@ T inner_product(typename std::vector<T>::const_iterator a_start,
         b_start, b_end, 1);
 }
 
+template <typename T>
+T inner_product(const T *a, const T *b, const size_t count)
+{
+    return multi_exp<T, T, multi_exp_method_naive_plain>(a, b, count, 1);
+}
+
+template<typename T, typename FieldT>
+const size_t multi_exp_accumulator<T, FieldT>::max_window;
+
+template<typename T, typename FieldT>
+multi_exp_accumulator<T, FieldT>::multi_exp_accumulator(const size_t expected_count) :
+    trivial_sum(T::zero()), num_terms(0)
+{
+    // as in multi_exp_method_BDLO12
+    const size_t log2_length = log2(expected_count);
+    c = std::min(log2_length + 2 - log2_length / 3, max_window);
+
+    num_windows = (FieldT::ceil_size_in_bits() + c - 1) / c;
+    buckets.assign(num_windows << c, T::zero());
+}
+
+template<typename T, typename FieldT>
+void multi_exp_accumulator<T, FieldT>::push(const T *bases, const FieldT *scalars, const size_t count)
+{
+    const FieldT zero = FieldT::zero();
+    const FieldT one = FieldT::one();
+    const mp_size_t n = FieldT::num_limbs;
+
+    std::vector<const T*> terms;
+    std::vector<bigint<n> > exponents;
+    terms.reserve(count);
+    exponents.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (scalars[i] == zero)
+        {
+            continue;
+        }
+        else if (scalars[i] == one)
+        {
+#ifdef USE_MIXED_ADDITION
+            trivial_sum = trivial_sum.mixed_add(bases[i]);
+#else
+            trivial_sum = trivial_sum + bases[i];
+#endif
+        }
+        else
+        {
+            terms.emplace_back(&bases[i]);
+            exponents.emplace_back(scalars[i].as_bigint());
+        }
+    }
+    num_terms += count;
+
+    // each window owns its buckets, so windows can be filled in parallel
+    parallel_for(num_windows, [&](const size_t k) {
+        T *window_buckets = &buckets[k << c];
+        for (size_t i = 0; i < terms.size(); ++i)
+        {
+            const size_t id = multi_exp_window_digit(exponents[i], k, c);
+
+            if (id == 0)
+            {
+                continue;
+            }
+
+#ifdef USE_MIXED_ADDITION
+            window_buckets[id] = window_buckets[id].mixed_add(*terms[i]);
+#else
+            window_buckets[id] = window_buckets[id] + *terms[i];
+#endif
+        }
+    });
+}
+
+template<typename T, typename FieldT>
+void multi_exp_accumulator<T, FieldT>::push(const std::vector<T> &bases, const std::vector<FieldT> &scalars)
+{
+    assert(bases.size() == scalars.size());
+    push(bases.data(), scalars.data(), bases.size());
+}
+
+template<typename T, typename FieldT>
+T multi_exp_accumulator<T, FieldT>::finalize() const
+{
+    T result = T::zero();
+
+    for (size_t k = num_windows - 1; k < num_windows; --k)
+    {
+        for (size_t i = 0; i < c; ++i)
+        {
+            result = result.dbl();
+        }
+
+        // \sum_id id * bucket[id] as a sum of suffix sums
+        const T *window_buckets = &buckets[k << c];
+        T running_sum = T::zero();
+        for (size_t id = (1u << c) - 1; id > 0; --id)
+        {
+            running_sum = running_sum + window_buckets[id];
+            result = result + running_sum;
+        }
+    }
+
+    return result + trivial_sum;
+}
+
 template<typename T>
 size_t get_exp_window_size(const size_t num_scalars)
 {
@@ -629,19 +1015,22 @@ std::vector<T> batch_exp(const size_t scalar_size,
     }
     std::vector<T> res(v.size(), table[0][0]);
 
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-    for (size_t i = 0; i < v.size(); ++i)
-    {
-        res[i] = windowed_exp(scalar_size, window, table, v[i]);
-
-        if (!inhibit_profiling_info && (i % 10000 == 0))
+    // one task per slice rather than per element
+    const size_t slice_size = batch_slice_size(v.size());
+    const size_t num_slices = (v.size() + slice_size - 1) / slice_size;
+    parallel_for(num_slices, [&](const size_t s) {
+        const size_t end = std::min(v.size(), (s + 1) * slice_size);
+        for (size_t i = s * slice_size; i < end; ++i)
         {
-            printf(".");
-            fflush(stdout);
+            res[i] = windowed_exp(scalar_size, window, table, v[i]);
+
+            if (!inhibit_profiling_info && (i % 10000 == 0))
+            {
+                printf(".");
+                fflush(stdout);
+            }
         }
-    }
+    });
 
     if (!inhibit_profiling_info)
     {
@@ -664,19 +1053,22 @@ std::vector<T> batch_exp_with_coeff(const size_t scalar_size,
     }
     std::vector<T> res(v.size(), table[0][0]);
 
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-    for (size_t i = 0; i < v.size(); ++i)
-    {
-        res[i] = windowed_exp(scalar_size, window, table, coeff * v[i]);
-
-        if (!inhibit_profiling_info && (i % 10000 == 0))
+    // one task per slice rather than per element
+    const size_t slice_size = batch_slice_size(v.size());
+    const size_t num_slices = (v.size() + slice_size - 1) / slice_size;
+    parallel_for(num_slices, [&](const size_t s) {
+        const size_t end = std::min(v.size(), (s + 1) * slice_size);
+        for (size_t i = s * slice_size; i < end; ++i)
         {
-            printf(".");
-            fflush(stdout);
+            res[i] = windowed_exp(scalar_size, window, table, coeff * v[i]);
+
+            if (!inhibit_profiling_info && (i % 10000 == 0))
+            {
+                printf(".");
+                fflush(stdout);
+            }
         }
-    }
+    });
 
     if (!inhibit_profiling_info)
     {
@@ -691,32 +1083,39 @@ void batch_to_special(std::vector<T> &vec)
 {
     enter_block("Batch-convert elements to special form");
 
-    std::vector<T> non_zero_vec;
-    for (size_t i = 0; i < vec.size(); ++i)
-    {
-        if (!vec[i].is_zero())
-        {
-            non_zero_vec.emplace_back(vec[i]);
-        }
-    }
-
-    T::batch_to_special_all_non_zeros(non_zero_vec);
-    auto it = non_zero_vec.begin();
     T zero_special = T::zero();
     zero_special.to_special();
 
-    for (size_t i = 0; i < vec.size(); ++i)
-    {
-        if (!vec[i].is_zero())
+    // slices are converted independently and in place, each with one inversion on its own thread
+    const size_t slice_size = batch_slice_size(vec.size());
+    const size_t num_slices = (vec.size() + slice_size - 1) / slice_size;
+
+    parallel_for(num_slices, [&](const size_t s) {
+        T *slice = vec.data() + s * slice_size;
+        const size_t count = std::min(slice_size, vec.size() - s * slice_size);
+
+        // zeros stand in as one, which converts without a division by zero
+        std::vector<bool> is_zero(count);
+        for (size_t i = 0; i < count; ++i)
         {
-            vec[i] = *it;
-            ++it;
+            is_zero[i] = slice[i].is_zero();
+            if (is_zero[i])
+            {
+                slice[i] = T::one();
+            }
         }
-        else
+
+        T::batch_to_special_all_non_zeros(slice, count);
+
+        for (size_t i = 0; i < count; ++i)
         {
-            vec[i] = zero_special;
+            if (is_zero[i])
+            {
+                slice[i] = zero_special;
+            }
         }
-    }
+    });
+
     leave_block("Batch-convert elements to special form");
 }
 
@@ -8,6 +8,7 @@
  *             and contributors (see AUTHORS).
  * @copyright  MIT license (see LICENSE file)
  *****************************************************************************/
+#include <algorithm>
 #include <cstdio>
 #include <vector>
 
@@ -53,9 +54,7 @@ test_instances_t<FieldT> generate_scalars(size_t count, size_t size)
     test_instances_t<FieldT> result(count);
 
     for (size_t i = 0; i < count; i++) {
-        for (size_t j = 0; j < size; j++) {
-            result[i].push_back(SHA512_rng<FieldT>(i * size + j));
-        }
+        result[i] = SHA512_rng_vector<FieldT>(0, i * size, size);
     }
 
     return result;
@@ -81,6 +80,29 @@ run_result_t<GroupT> profile_multiexp(
     return run_result_t<GroupT>(time_delta, answers);
 }
 
+template<typename GroupT, typename FieldT>
+run_result_t<GroupT> profile_multiexp_accumulator(
+    test_instances_t<GroupT> group_elements,
+    test_instances_t<FieldT> scalars,
+    size_t chunk)
+{
+    long long start_time = get_nsec_time();
+
+    std::vector<GroupT> answers;
+    for (size_t i = 0; i < group_elements.size(); i++) {
+        const size_t size = group_elements[i].size();
+        multi_exp_accumulator<GroupT, FieldT> acc(size);
+        for (size_t j = 0; j < size; j += chunk) {
+            acc.push(&group_elements[i][j], &scalars[i][j], std::min(chunk, size - j));
+        }
+        answers.push_back(acc.finalize());
+    }
+
+    long long time_delta = get_nsec_time() - start_time;
+
+    return run_result_t<GroupT>(time_delta, answers);
+}
+
 template<typename GroupT, typename FieldT>
 void print_performance_csv(
     size_t expn_start,
@@ -110,6 +132,24 @@ void print_performance_csv(
             fprintf(stderr, "Answers NOT MATCHING (bos coster != djb)\n");
         }
 
+        run_result_t<GroupT> result_affine =
+            profile_multiexp<GroupT, FieldT, multi_exp_method_BDLO12_affine>(
+                group_elements, scalars);
+        printf("\t%lld", result_affine.first); fflush(stdout);
+
+        if (compare_answers && (result_djb.second != result_affine.second)) {
+            fprintf(stderr, "Answers NOT MATCHING (djb != djb affine)\n");
+        }
+
+        run_result_t<GroupT> result_accumulator =
+            profile_multiexp_accumulator<GroupT, FieldT>(
+                group_elements, scalars, 1 << 10);
+        printf("\t%lld", result_accumulator.first); fflush(stdout);
+
+        if (compare_answers && (result_djb.second != result_accumulator.second)) {
+            fprintf(stderr, "Answers NOT MATCHING (djb != accumulator)\n");
+        }
+
         if (expn <= expn_end_naive) {
             run_result_t<GroupT> result_naive =
                 profile_multiexp<GroupT, FieldT, multi_exp_method_naive>(
@@ -9,20 +9,60 @@
 #ifndef WNAF_HPP_
 #define WNAF_HPP_
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include <libff/algebra/field_utils/bigint.hpp>
 
 namespace libff {
 
+/**
+ * Largest window size with int8_t digits: wNAF digits are odd and less than
+ * 2^window_size in absolute value, and the table of odd multiples has
+ * 2^(window_size-1) entries.
+ */
+const std::size_t wnaf_max_window = 7;
+
+/** Upper bound on the number of wNAF digits of a bigint<n>, for any window size. */
+template<mp_size_t n>
+constexpr std::size_t wnaf_max_digits()
+{
+    return n * GMP_NUMB_BITS + 1;
+}
+
 /**
  * Find the wNAF representation of the given scalar relative to the given window size.
  */
 template<mp_size_t n>
 std::vector<long> find_wnaf(const std::size_t window_size, const bigint<n> &scalar);
 
+/**
+ * Writes the wNAF digits of scalar, least significant first, to digits, which
+ * has room for wnaf_max_digits<n>(). Returns the number of digits written, the
+ * last of which is non-zero. The window size is at most wnaf_max_window.
+ */
+template<mp_size_t n>
+std::size_t find_wnaf(const std::size_t window_size, const bigint<n> &scalar, int8_t *digits);
+
+/**
+ * Converts count non-zero elements, at most 2^(wnaf_max_window-1), to special
+ * form in place. The generic version goes through
+ * T::batch_to_special_all_non_zeros; groups may specialize it to avoid the heap.
+ */
+template<typename T>
+void batch_to_special_table(T *table, const std::size_t count);
+
 /**
  * In additive notation, use wNAF exponentiation (with the given window size) to compute scalar * base.
+ * The table of odd multiples of base is converted to special form (see
+ * batch_to_special_table) for mixed additions, unless one of them is zero.
+ */
+template<std::size_t window_size, typename T, mp_size_t n>
+T fixed_window_wnaf_exp(const T &base, const bigint<n> &scalar);
+
+/**
+ * As above, for a window size known at run time.
  */
 template<typename T, mp_size_t n>
 T fixed_window_wnaf_exp(const std::size_t window_size, const T &base, const bigint<n> &scalar);
@@ -11,6 +11,10 @@
 #ifndef WNAF_TCC_
 #define WNAF_TCC_
 
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
 #include <gmp.h>
 
 namespace libff {
@@ -22,14 +26,33 @@ std::vector<long> find_wnaf(const size_t window_size, const bigint<n> &scalar)
 {
     const size_t length = scalar.max_bits(); // upper bound
     std::vector<long> res(length+1);
-    bigint<n> c = scalar;
-    long j = 0;
-    while (!c.is_zero())
+
+    int8_t digits[wnaf_max_digits<n>()];
+    const size_t num_digits = find_wnaf(window_size, scalar, digits);
+    for (size_t j = 0; j < num_digits; ++j)
+    {
+        res[j] = digits[j];
+    }
+
+    return res;
+}
+
+template<mp_size_t n>
+size_t find_wnaf(const size_t window_size, const bigint<n> &scalar, int8_t *digits)
+{
+    assert(window_size >= 1 && window_size <= wnaf_max_window);
+
+    /* an extra limb for the carry of c - u with u < 0 when the top bit of scalar is set */
+    mp_limb_t c[n + 1];
+    mpn_copyi(c, scalar.data, n);
+    c[n] = 0;
+    size_t j = 0;
+    while (!mpn_zero_p(c, n + 1))
     {
         long u;
-        if ((c.data[0] & 1) == 1)
+        if ((c[0] & 1) == 1)
         {
-            u = c.data[0] % (1u << (window_size+1));
+            u = c[0] % (1u << (window_size+1));
             if (u > (1 << window_size))
             {
                 u = u - (1 << (window_size+1));
@@ -37,58 +60,79 @@ std::vector<long> find_wnaf(const size_t window_size, const bigint<n> &scalar)
 
             if (u > 0)
             {
-                mpn_sub_1(c.data, c.data, n, u);
+                mpn_sub_1(c, c, n + 1, u);
             }
             else
             {
-                mpn_add_1(c.data, c.data, n, -u);
+                mpn_add_1(c, c, n + 1, -u);
             }
         }
         else
         {
             u = 0;
         }
-        res[j] = u;
+        digits[j] = static_cast<int8_t>(u);
         ++j;
 
-        mpn_rshift(c.data, c.data, n, 1); // c = c/2
+        mpn_rshift(c, c, n + 1, 1); // c = c/2
     }
 
-    return res;
+    return j;
 }
 
-template<typename T, mp_size_t n>
-T fixed_window_wnaf_exp(const size_t window_size, const T &base, const bigint<n> &scalar)
+template<typename T>
+void batch_to_special_table(T *table, const size_t count)
+{
+    T::batch_to_special_all_non_zeros(table, count);
+}
+
+template<size_t window_size, typename T, mp_size_t n>
+T fixed_window_wnaf_exp(const T &base, const bigint<n> &scalar)
 {
-    std::vector<long> naf = find_wnaf(window_size, scalar);
-    std::vector<T> table(1ul<<(window_size-1));
-    T tmp = base;
-    T dbl = base.dbl();
-    for (size_t i = 0; i < 1ul<<(window_size-1); ++i)
+    static_assert(window_size >= 1 && window_size <= wnaf_max_window, "window size out of range");
+    constexpr size_t table_size = size_t(1) << (window_size - 1);
+
+    /* table[i] = (2i + 1) * base; a zero among them means base has a small
+       order (off the prime-order subgroup) and rules out special form */
+    T table[table_size];
+    table[0] = base;
+    bool all_non_zero = !base.is_zero();
+    if (table_size > 1)
     {
-        table[i] = tmp;
-        tmp = tmp + dbl;
+        const T dbl = base.dbl();
+        for (size_t i = 1; i < table_size; ++i)
+        {
+            table[i] = table[i-1] + dbl;
+            all_non_zero &= !table[i].is_zero();
+        }
     }
+    if (all_non_zero)
+    {
+        batch_to_special_table(table, table_size);
+    }
+
+    int8_t naf[wnaf_max_digits<n>()];
+    const size_t num_digits = find_wnaf(window_size, scalar, naf);
 
     T res = T::zero();
-    bool found_nonzero = false;
-    for (long i = naf.size()-1; i >= 0; --i)
+    for (long i = static_cast<long>(num_digits) - 1; i >= 0; --i)
     {
-        if (found_nonzero)
+        if (i + 1 != static_cast<long>(num_digits))
         {
             res = res.dbl();
         }
 
-        if (naf[i] != 0)
+        const int d = naf[i];
+        if (d != 0)
         {
-            found_nonzero = true;
-            if (naf[i] > 0)
+            const T &multiple = table[(d < 0 ? -d : d) / 2];
+            if (all_non_zero)
             {
-                res = res + table[naf[i]/2];
+                res = res.mixed_add(d < 0 ? -multiple : multiple);
             }
             else
             {
-                res = res - table[(-naf[i])/2];
+                res = (d < 0 ? res - multiple : res + multiple);
             }
         }
     }
@@ -96,6 +140,23 @@ T fixed_window_wnaf_exp(const size_t window_size, const T &base, const bigint<n>
     return res;
 }
 
+template<typename T, mp_size_t n>
+T fixed_window_wnaf_exp(const size_t window_size, const T &base, const bigint<n> &scalar)
+{
+    switch (window_size)
+    {
+    case 1: return fixed_window_wnaf_exp<1>(base, scalar);
+    case 2: return fixed_window_wnaf_exp<2>(base, scalar);
+    case 3: return fixed_window_wnaf_exp<3>(base, scalar);
+    case 4: return fixed_window_wnaf_exp<4>(base, scalar);
+    case 5: return fixed_window_wnaf_exp<5>(base, scalar);
+    case 6: return fixed_window_wnaf_exp<6>(base, scalar);
+    case 7: return fixed_window_wnaf_exp<7>(base, scalar);
+    default:
+        throw std::invalid_argument("fixed_window_wnaf_exp: window size out of range");
+    }
+}
+
 template<typename T, mp_size_t n>
 T opt_window_wnaf_exp(const T &base, const bigint<n> &scalar, const size_t scalar_bits)
 {
@@ -0,0 +1,77 @@
+/** @file
+ *****************************************************************************
+ Declaration of binary_file_view, a read-only view of the elements of a
+ file in the binary format of binary_serialization.hpp.
+
+ The file is mapped shared and read-only, so its pages are loaded on first
+ access and are shared by every process that maps the same file: a proving
+ key read by many provers on one host is held in memory once. The elements
+ are used in place, so the view can be passed as the bases of multi_exp:
+
+     binary_file_view<alt_bn128_G1> bases("pk_A.bin");
+     multi_exp<alt_bn128_G1, alt_bn128_Fr, multi_exp_method_BDLO12>(
+         bases.begin(), bases.end(), scalars.begin(), scalars.end(), 1);
+
+ This needs the file to be in the native layout (Montgomery encoding,
+ projective points; see binary_native_data). By default, opening the view
+ reads the whole file once to check that every coordinate is reduced, as
+ read_binary does; non-reduced values would otherwise flow into the field
+ arithmetic and give wrong results. A caller that trusts the file, e.g. one
+ it wrote itself, can skip this pass and keep the pages loaded on demand.
+ As with read_binary, points are not checked to be on the curve or in the
+ subgroup.
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#ifndef BINARY_FILE_VIEW_HPP_
+#define BINARY_FILE_VIEW_HPP_
+
+#include <cstddef>
+#include <string>
+
+#include <libff/common/binary_serialization.hpp>
+
+namespace libff {
+
+template<typename T>
+class binary_file_view {
+private:
+    void *map;
+    std::size_t map_size;
+    const T *elements;
+    std::size_t count;
+
+    void unmap();
+public:
+    typedef T value_type;
+    typedef const T* const_iterator;
+
+    /* Throws std::runtime_error if the file cannot be mapped, is not a
+       native-layout file of T or, if validate is set, holds a record that is
+       not valid (see validate_binary_records). */
+    explicit binary_file_view(const std::string &path, const bool validate = true);
+    binary_file_view(const binary_file_view &other) = delete;
+    binary_file_view(binary_file_view &&other);
+    ~binary_file_view();
+
+    binary_file_view& operator=(const binary_file_view &other) = delete;
+    binary_file_view& operator=(binary_file_view &&other);
+
+    const T* data() const { return elements; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T* begin() const { return elements; }
+    const T* end() const { return elements + count; }
+    const T& operator[](const std::size_t i) const { return elements[i]; }
+
+    /* Asks the kernel to read ahead the whole file, e.g. before a multi_exp over all of it. */
+    void prefetch() const;
+};
+
+} // namespace libff
+
+#include <libff/common/binary_file_view.tcc>
+
+#endif // BINARY_FILE_VIEW_HPP_
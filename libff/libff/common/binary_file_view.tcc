@@ -0,0 +1,126 @@
+/** @file
+ *****************************************************************************
+ Implementation of binary_file_view.
+
+ See binary_file_view.hpp .
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#ifndef BINARY_FILE_VIEW_TCC_
+#define BINARY_FILE_VIEW_TCC_
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace libff {
+
+template<typename T>
+binary_file_view<T>::binary_file_view(const std::string &path, const bool validate) :
+    map(nullptr), map_size(0), elements(nullptr), count(0)
+{
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::runtime_error("binary_file_view: cannot open " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        const int err = errno;
+        close(fd);
+        throw std::runtime_error("binary_file_view: cannot stat " + path + ": " + std::strerror(err));
+    }
+    if (st.st_size < (off_t)binary_header::size)
+    {
+        close(fd);
+        throw std::runtime_error("binary_file_view: " + path + " is too short");
+    }
+
+    map_size = st.st_size;
+    map = mmap(nullptr, map_size, PROT_READ, MAP_SHARED, fd, 0);
+    const int err = errno;
+    /* the mapping holds its own reference to the file */
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        map = nullptr;
+        throw std::runtime_error("binary_file_view: cannot map " + path + ": " + std::strerror(err));
+    }
+
+    elements = binary_native_data<T>(static_cast<const unsigned char*>(map), map_size, count, validate);
+    if (elements == nullptr)
+    {
+        unmap();
+        throw std::runtime_error("binary_file_view: " + path + " is not a valid native-layout file of this type");
+    }
+}
+
+template<typename T>
+binary_file_view<T>::binary_file_view(binary_file_view<T> &&other) :
+    map(other.map), map_size(other.map_size), elements(other.elements), count(other.count)
+{
+    other.map = nullptr;
+    other.map_size = 0;
+    other.elements = nullptr;
+    other.count = 0;
+}
+
+template<typename T>
+binary_file_view<T>::~binary_file_view()
+{
+    unmap();
+}
+
+template<typename T>
+binary_file_view<T>& binary_file_view<T>::operator=(binary_file_view<T> &&other)
+{
+    if (this != &other)
+    {
+        unmap();
+        map = other.map;
+        map_size = other.map_size;
+        elements = other.elements;
+        count = other.count;
+        other.map = nullptr;
+        other.map_size = 0;
+        other.elements = nullptr;
+        other.count = 0;
+    }
+    return *this;
+}
+
+template<typename T>
+void binary_file_view<T>::unmap()
+{
+    if (map != nullptr)
+    {
+        munmap(map, map_size);
+    }
+    map = nullptr;
+    map_size = 0;
+    elements = nullptr;
+    count = 0;
+}
+
+template<typename T>
+void binary_file_view<T>::prefetch() const
+{
+    if (map != nullptr)
+    {
+        /* only a hint: failure leaves the pages to be faulted in on access */
+        madvise(map, map_size, MADV_WILLNEED);
+    }
+}
+
+} // namespace libff
+
+#endif // BINARY_FILE_VIEW_TCC_
@@ -0,0 +1,154 @@
+/** @file
+ *****************************************************************************
+ Declaration of a binary, fixed-stride serialization format.
+
+ Unlike the stream operators of serialization.hpp, this format needs no
+ parsing: a buffer is a 64-byte header followed by count records of
+ stride bytes each, so records can be read at any index directly from a
+ memory-mapped file. All integers, including the 64-bit limbs of field
+ elements, are little-endian.
+
+ The header (binary_header) holds a magic number, the format version, the
+ kind of element stored, its encoding, its stride, the low limb of the base
+ field modulus (so that buffers of one curve are not read as another) and
+ the element count.
+
+ Field elements are stored either in Montgomery form, as held in memory, or
+ in canonical form, with extension field coefficients in order (c0, c1, ...).
+ Points are stored as projective (X, Y, Z), as held in memory, or as affine
+ (X, Y) with the point at infinity encoded as all zeroes. In Montgomery form,
+ field elements and projective points have the same layout as the libff
+ objects on little-endian 64-bit hosts, and binary_native_data returns them
+ in place, without any copy.
+
+ Readers check that every coordinate is reduced, but not that points are on
+ the curve or in the subgroup; untrusted input should be checked with
+ is_well_formed and a subgroup check. binary_native_data checks the
+ coordinates too, unless the caller trusts the buffer and opts out.
+
+ Types are added to the format by specialising binary_traits; see
+ binary_point_traits for elliptic curve points and
+ alt_bn128_binary_serialization.hpp for an example.
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#ifndef BINARY_SERIALIZATION_HPP_
+#define BINARY_SERIALIZATION_HPP_
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include <libff/algebra/fields/prime_base/fp.hpp>
+#include <libff/algebra/fields/prime_extension/fp12_2over3over2.hpp>
+#include <libff/algebra/fields/prime_extension/fp2.hpp>
+#include <libff/algebra/fields/prime_extension/fp6_3over2.hpp>
+
+namespace libff {
+
+const uint16_t binary_format_version = 1;
+
+enum binary_encoding : uint8_t {
+    binary_montgomery = 0,
+    binary_canonical = 1
+};
+
+enum binary_point_form : uint8_t {
+    binary_projective = 0,
+    binary_affine = 1
+};
+
+struct binary_format {
+    binary_encoding encoding = binary_montgomery;
+    binary_point_form form = binary_projective;
+};
+
+/**
+ * The 64 bytes preceding the records: the magic "LFFB" at offset 0, then
+ * version (u16) at 4, kind (u16) at 6, encoding (u8) at 8, form (u8) at 9,
+ * stride (u64) at 16, modulus (u64) at 24 and count (u64) at 32; all other
+ * bytes are zero.
+ */
+struct binary_header {
+    static const std::size_t size = 64;
+
+    uint16_t version;
+    uint16_t kind;
+    binary_format format;
+    uint32_t stride;
+    uint64_t modulus;
+    uint64_t count;
+};
+
+/**
+ * Specialised for each type T in the format, providing
+ *
+ *   static const uint16_t kind;
+ *   static uint64_t modulus_tag();  the low limb of the base field modulus
+ *   static std::size_t stride(const binary_format &fmt);
+ *   static bool is_native(const binary_format &fmt);  records are T objects
+ *   static void write(unsigned char *dst, const T &x, const binary_format &fmt);
+ *   static bool read(const unsigned char *src, T &x, const binary_format &fmt);
+ */
+template<typename T>
+struct binary_traits;
+
+template<mp_size_t n, const bigint<n>& modulus>
+struct binary_traits<Fp_model<n, modulus> >;
+template<mp_size_t n, const bigint<n>& modulus>
+struct binary_traits<Fp2_model<n, modulus> >;
+template<mp_size_t n, const bigint<n>& modulus>
+struct binary_traits<Fp6_3over2_model<n, modulus> >;
+template<mp_size_t n, const bigint<n>& modulus>
+struct binary_traits<Fp12_2over3over2_model<n, modulus> >;
+
+/* binary_traits for points with coordinates X, Y, Z in CoordT */
+template<typename GroupT, typename CoordT, uint16_t Kind>
+struct binary_point_traits;
+
+/* The number of bytes taken by count records, with the header. */
+template<typename T>
+std::size_t binary_size(const std::size_t count, const binary_format &fmt = binary_format());
+
+/* Writes the header and count records to dst, of binary_size(count, fmt) bytes. */
+template<typename T>
+void write_binary(unsigned char *dst, const T *src, const std::size_t count,
+                  const binary_format &fmt = binary_format());
+template<typename T>
+void write_binary(std::ostream &out, const std::vector<T> &v,
+                  const binary_format &fmt = binary_format());
+
+/* Reads and checks the header of a buffer of len bytes holding records of T. */
+template<typename T>
+bool read_binary_header(const unsigned char *buf, const std::size_t len, binary_header &header);
+
+/* The record at index idx of a buffer whose header has been read. */
+template<typename T>
+bool read_binary_record(const unsigned char *buf, const binary_header &header,
+                        const std::size_t idx, T &x);
+
+/* Whether every record of a buffer whose header has been read is valid, as read_binary_record checks. */
+template<typename T>
+bool validate_binary_records(const unsigned char *buf, const binary_header &header);
+
+template<typename T>
+bool read_binary(const unsigned char *buf, const std::size_t len, std::vector<T> &v);
+template<typename T>
+bool read_binary(std::istream &in, std::vector<T> &v);
+
+/* The records of buf in place, if they have the layout of T objects (see the
+   file comment), buf is suitably aligned and, if validate is set, every
+   record is valid (see validate_binary_records); nullptr otherwise. Without
+   validate, non-reduced coordinates in buf give wrong results. */
+template<typename T>
+const T* binary_native_data(const unsigned char *buf, const std::size_t len, std::size_t &count,
+                            const bool validate = true);
+
+} // namespace libff
+
+#include <libff/common/binary_serialization.tcc>
+
+#endif // BINARY_SERIALIZATION_HPP_
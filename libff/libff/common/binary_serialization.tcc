@@ -0,0 +1,437 @@
+/** @file
+ *****************************************************************************
+ Implementation of the binary serialization format.
+
+ See binary_serialization.hpp .
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#ifndef BINARY_SERIALIZATION_TCC_
+#define BINARY_SERIALIZATION_TCC_
+
+#include <algorithm>
+#include <cstring>
+
+#include <libff/common/utils.hpp>
+
+namespace libff {
+
+static const unsigned char binary_magic[4] = { 'L', 'F', 'F', 'B' };
+
+inline void binary_write_u64(unsigned char *dst, const uint64_t x)
+{
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        dst[i] = (unsigned char)(x >> (8 * i));
+    }
+}
+
+inline uint64_t binary_read_u64(const unsigned char *src)
+{
+    uint64_t x = 0;
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        x |= ((uint64_t)src[i]) << (8 * i);
+    }
+    return x;
+}
+
+/* Records have the in-memory layout of libff objects only on little-endian
+   hosts with 64-bit limbs. */
+inline bool binary_host_is_native()
+{
+    return GMP_NUMB_BITS == 64 && is_little_endian();
+}
+
+template<mp_size_t n>
+void binary_write_bigint(unsigned char *dst, const bigint<n> &x)
+{
+    for (mp_size_t i = 0; i < n; ++i)
+    {
+        binary_write_u64(dst + 8 * i, x.data[i]);
+    }
+}
+
+template<mp_size_t n>
+void binary_read_bigint(const unsigned char *src, bigint<n> &x)
+{
+    for (mp_size_t i = 0; i < n; ++i)
+    {
+        x.data[i] = binary_read_u64(src + 8 * i);
+    }
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+struct binary_traits<Fp_model<n, modulus> > {
+    typedef Fp_model<n, modulus> FieldT;
+
+    static const uint16_t kind = 0x101;
+
+    static uint64_t modulus_tag() { return modulus.data[0]; }
+    static std::size_t stride(const binary_format &) { return 8 * n; }
+    static bool is_native(const binary_format &fmt)
+    {
+        return fmt.encoding == binary_montgomery && sizeof(FieldT) == 8 * n;
+    }
+
+    static void write(unsigned char *dst, const FieldT &x, const binary_format &fmt)
+    {
+        binary_write_bigint(dst, fmt.encoding == binary_montgomery ? x.mont_repr : x.as_bigint());
+    }
+
+    static bool read(const unsigned char *src, FieldT &x, const binary_format &fmt)
+    {
+        bigint<n> r;
+        binary_read_bigint(src, r);
+        /* the top limb almost always decides */
+        if (r.data[n-1] >= modulus.data[n-1] && mpn_cmp(r.data, modulus.data, n) >= 0)
+        {
+            return false;
+        }
+
+        if (fmt.encoding == binary_montgomery)
+        {
+            x.mont_repr = r;
+        }
+        else
+        {
+            x = FieldT(r);
+        }
+        return true;
+    }
+};
+
+template<mp_size_t n, const bigint<n>& modulus>
+struct binary_traits<Fp2_model<n, modulus> > {
+    typedef Fp2_model<n, modulus> FieldT;
+    typedef binary_traits<Fp_model<n, modulus> > coeff;
+
+    static const uint16_t kind = 0x102;
+
+    static uint64_t modulus_tag() { return modulus.data[0]; }
+    static std::size_t stride(const binary_format &fmt) { return 2 * coeff::stride(fmt); }
+    static bool is_native(const binary_format &fmt)
+    {
+        return coeff::is_native(fmt) && sizeof(FieldT) == 2 * sizeof(typename FieldT::my_Fp);
+    }
+
+    static void write(unsigned char *dst, const FieldT &x, const binary_format &fmt)
+    {
+        coeff::write(dst, x.c0, fmt);
+        coeff::write(dst + coeff::stride(fmt), x.c1, fmt);
+    }
+
+    static bool read(const unsigned char *src, FieldT &x, const binary_format &fmt)
+    {
+        return (coeff::read(src, x.c0, fmt) &&
+                coeff::read(src + coeff::stride(fmt), x.c1, fmt));
+    }
+};
+
+template<mp_size_t n, const bigint<n>& modulus>
+struct binary_traits<Fp6_3over2_model<n, modulus> > {
+    typedef Fp6_3over2_model<n, modulus> FieldT;
+    typedef binary_traits<Fp2_model<n, modulus> > coeff;
+
+    static const uint16_t kind = 0x106;
+
+    static uint64_t modulus_tag() { return modulus.data[0]; }
+    static std::size_t stride(const binary_format &fmt) { return 3 * coeff::stride(fmt); }
+    static bool is_native(const binary_format &fmt)
+    {
+        return coeff::is_native(fmt) && sizeof(FieldT) == 3 * sizeof(typename FieldT::my_Fp2);
+    }
+
+    static void write(unsigned char *dst, const FieldT &x, const binary_format &fmt)
+    {
+        coeff::write(dst, x.c0, fmt);
+        coeff::write(dst + coeff::stride(fmt), x.c1, fmt);
+        coeff::write(dst + 2 * coeff::stride(fmt), x.c2, fmt);
+    }
+
+    static bool read(const unsigned char *src, FieldT &x, const binary_format &fmt)
+    {
+        return (coeff::read(src, x.c0, fmt) &&
+                coeff::read(src + coeff::stride(fmt), x.c1, fmt) &&
+                coeff::read(src + 2 * coeff::stride(fmt), x.c2, fmt));
+    }
+};
+
+template<mp_size_t n, const bigint<n>& modulus>
+struct binary_traits<Fp12_2over3over2_model<n, modulus> > {
+    typedef Fp12_2over3over2_model<n, modulus> FieldT;
+    typedef binary_traits<Fp6_3over2_model<n, modulus> > coeff;
+
+    static const uint16_t kind = 0x10c;
+
+    static uint64_t modulus_tag() { return modulus.data[0]; }
+    static std::size_t stride(const binary_format &fmt) { return 2 * coeff::stride(fmt); }
+    static bool is_native(const binary_format &fmt)
+    {
+        return coeff::is_native(fmt) && sizeof(FieldT) == 2 * sizeof(typename FieldT::my_Fp6);
+    }
+
+    static void write(unsigned char *dst, const FieldT &x, const binary_format &fmt)
+    {
+        coeff::write(dst, x.c0, fmt);
+        coeff::write(dst + coeff::stride(fmt), x.c1, fmt);
+    }
+
+    static bool read(const unsigned char *src, FieldT &x, const binary_format &fmt)
+    {
+        return (coeff::read(src, x.c0, fmt) &&
+                coeff::read(src + coeff::stride(fmt), x.c1, fmt));
+    }
+};
+
+template<typename GroupT, typename CoordT, uint16_t Kind>
+struct binary_point_traits {
+    typedef binary_traits<CoordT> coord;
+
+    static const uint16_t kind = Kind;
+
+    static uint64_t modulus_tag() { return coord::modulus_tag(); }
+    static std::size_t stride(const binary_format &fmt)
+    {
+        return (fmt.form == binary_affine ? 2 : 3) * coord::stride(fmt);
+    }
+    static bool is_native(const binary_format &fmt)
+    {
+        return (fmt.form == binary_projective && coord::is_native(fmt) &&
+                sizeof(GroupT) == 3 * sizeof(CoordT));
+    }
+
+    static void write(unsigned char *dst, const GroupT &P, const binary_format &fmt)
+    {
+        const std::size_t s = coord::stride(fmt);
+        if (fmt.form == binary_projective)
+        {
+            coord::write(dst, P.X, fmt);
+            coord::write(dst + s, P.Y, fmt);
+            coord::write(dst + 2 * s, P.Z, fmt);
+        }
+        else if (P.is_zero())
+        {
+            std::memset(dst, 0, 2 * s);
+        }
+        else
+        {
+            GroupT affine = P;
+            affine.to_affine_coordinates();
+            coord::write(dst, affine.X, fmt);
+            coord::write(dst + s, affine.Y, fmt);
+        }
+    }
+
+    static bool read(const unsigned char *src, GroupT &P, const binary_format &fmt)
+    {
+        const std::size_t s = coord::stride(fmt);
+        if (fmt.form == binary_projective)
+        {
+            return (coord::read(src, P.X, fmt) &&
+                    coord::read(src + s, P.Y, fmt) &&
+                    coord::read(src + 2 * s, P.Z, fmt));
+        }
+
+        if (!coord::read(src, P.X, fmt) || !coord::read(src + s, P.Y, fmt))
+        {
+            return false;
+        }
+        if (P.X.is_zero() && P.Y.is_zero())
+        {
+            P = GroupT::zero();
+        }
+        else
+        {
+            P.Z = CoordT::one();
+        }
+        return true;
+    }
+};
+
+template<typename T>
+std::size_t binary_size(const std::size_t count, const binary_format &fmt)
+{
+    return binary_header::size + count * binary_traits<T>::stride(fmt);
+}
+
+template<typename T>
+void write_binary(unsigned char *dst, const T *src, const std::size_t count,
+                  const binary_format &fmt)
+{
+    typedef binary_traits<T> traits;
+    const std::size_t stride = traits::stride(fmt);
+
+    std::memset(dst, 0, binary_header::size);
+    std::memcpy(dst, binary_magic, sizeof(binary_magic));
+    dst[4] = (unsigned char)binary_format_version;
+    dst[5] = (unsigned char)(binary_format_version >> 8);
+    dst[6] = (unsigned char)traits::kind;
+    dst[7] = (unsigned char)(traits::kind >> 8);
+    dst[8] = fmt.encoding;
+    dst[9] = fmt.form;
+    binary_write_u64(dst + 16, stride);
+    binary_write_u64(dst + 24, traits::modulus_tag());
+    binary_write_u64(dst + 32, count);
+
+    dst += binary_header::size;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        traits::write(dst + i * stride, src[i], fmt);
+    }
+}
+
+template<typename T>
+void write_binary(std::ostream &out, const std::vector<T> &v, const binary_format &fmt)
+{
+    std::vector<unsigned char> buf(binary_size<T>(v.size(), fmt));
+    write_binary(buf.data(), v.data(), v.size(), fmt);
+    out.write((const char*)buf.data(), buf.size());
+}
+
+/* Parses and checks the binary_header::size bytes at buf, except for the record count. */
+template<typename T>
+bool binary_parse_header(const unsigned char *buf, binary_header &header)
+{
+    typedef binary_traits<T> traits;
+
+    if (std::memcmp(buf, binary_magic, sizeof(binary_magic)) != 0)
+    {
+        return false;
+    }
+
+    header.version = buf[4] | (buf[5] << 8);
+    header.kind = buf[6] | (buf[7] << 8);
+    header.format.encoding = (binary_encoding)buf[8];
+    header.format.form = (binary_point_form)buf[9];
+    const uint64_t stride = binary_read_u64(buf + 16);
+    header.modulus = binary_read_u64(buf + 24);
+    header.count = binary_read_u64(buf + 32);
+
+    if (header.version != binary_format_version || header.kind != traits::kind ||
+        header.modulus != traits::modulus_tag() ||
+        header.format.encoding > binary_canonical || header.format.form > binary_affine ||
+        stride != traits::stride(header.format))
+    {
+        return false;
+    }
+    header.stride = (uint32_t)stride;
+    return true;
+}
+
+template<typename T>
+bool read_binary_header(const unsigned char *buf, const std::size_t len, binary_header &header)
+{
+    if (len < binary_header::size || !binary_parse_header<T>(buf, header))
+    {
+        return false;
+    }
+
+    /* count * stride must fit in the rest of the buffer, without overflowing */
+    return header.count <= (len - binary_header::size) / header.stride;
+}
+
+template<typename T>
+bool read_binary_record(const unsigned char *buf, const binary_header &header,
+                        const std::size_t idx, T &x)
+{
+    return binary_traits<T>::read(buf + binary_header::size + idx * header.stride, x, header.format);
+}
+
+template<typename T>
+bool validate_binary_records(const unsigned char *buf, const binary_header &header)
+{
+    T x;
+    for (std::size_t i = 0; i < header.count; ++i)
+    {
+        if (!read_binary_record(buf, header, i, x))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+bool read_binary(const unsigned char *buf, const std::size_t len, std::vector<T> &v)
+{
+    binary_header header;
+    if (!read_binary_header<T>(buf, len, header))
+    {
+        return false;
+    }
+
+    v.resize(header.count);
+    for (std::size_t i = 0; i < header.count; ++i)
+    {
+        if (!read_binary_record(buf, header, i, v[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* The largest chunk of records read from a stream at once */
+const std::size_t binary_stream_chunk_size = 1 << 20;
+
+template<typename T>
+bool read_binary(std::istream &in, std::vector<T> &v)
+{
+    unsigned char header_buf[binary_header::size];
+    binary_header header;
+    if (!in.read((char*)header_buf, sizeof(header_buf)) ||
+        !binary_parse_header<T>(header_buf, header) ||
+        header.count > (SIZE_MAX - binary_header::size) / header.stride)
+    {
+        return false;
+    }
+
+    /* The count is not checked against the length of the stream, so records
+       are read in chunks: memory grows with the data actually read. */
+    const std::size_t chunk_count = std::max<std::size_t>(1, binary_stream_chunk_size / header.stride);
+    std::vector<unsigned char> chunk;
+    v.clear();
+    for (std::size_t begin = 0; begin < header.count; begin += chunk_count)
+    {
+        const std::size_t n = std::min<std::size_t>(chunk_count, header.count - begin);
+        chunk.resize(n * header.stride);
+        if (!in.read((char*)chunk.data(), chunk.size()))
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            T x;
+            if (!binary_traits<T>::read(chunk.data() + i * header.stride, x, header.format))
+            {
+                return false;
+            }
+            v.emplace_back(x);
+        }
+    }
+    return true;
+}
+
+template<typename T>
+const T* binary_native_data(const unsigned char *buf, const std::size_t len, std::size_t &count,
+                            const bool validate)
+{
+    binary_header header;
+    if (!binary_host_is_native() || !read_binary_header<T>(buf, len, header) ||
+        !binary_traits<T>::is_native(header.format) || header.stride != sizeof(T) ||
+        ((uintptr_t)(buf + binary_header::size)) % alignof(T) != 0 ||
+        (validate && !validate_binary_records<T>(buf, header)))
+    {
+        return nullptr;
+    }
+
+    count = header.count;
+    return reinterpret_cast<const T*>(buf + binary_header::size);
+}
+
+} // namespace libff
+
+#endif // BINARY_SERIALIZATION_TCC_
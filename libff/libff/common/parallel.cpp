@@ -0,0 +1,95 @@
+/** @file
+ *****************************************************************************
+ Implementation of the executor used to run parallel loops.
+
+ See parallel.hpp .
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <libff/common/parallel.hpp>
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+namespace libff {
+
+using std::size_t;
+
+parallel_executor default_parallel_executor()
+{
+    parallel_executor executor;
+#ifdef MULTICORE
+    executor.concurrency = omp_get_max_threads();
+    executor.run = [](const size_t num_tasks, const std::function<void(size_t)> &task) {
+#pragma omp parallel for schedule(dynamic)
+        for (size_t i = 0; i < num_tasks; ++i)
+        {
+            task(i);
+        }
+    };
+#else
+    executor.concurrency = 1;
+    executor.run = [](const size_t num_tasks, const std::function<void(size_t)> &task) {
+        for (size_t i = 0; i < num_tasks; ++i)
+        {
+            task(i);
+        }
+    };
+#endif
+    return executor;
+}
+
+static parallel_executor &current_parallel_executor()
+{
+    static parallel_executor executor = default_parallel_executor();
+    return executor;
+}
+
+void set_parallel_executor(const parallel_executor &executor)
+{
+    current_parallel_executor() = executor;
+}
+
+const parallel_executor& get_parallel_executor()
+{
+    return current_parallel_executor();
+}
+
+size_t parallel_concurrency()
+{
+    return current_parallel_executor().concurrency;
+}
+
+/* set on the threads that are running a task of parallel_for */
+static thread_local bool in_parallel_task = false;
+
+/* sets in_parallel_task for its lifetime, also when the task throws */
+struct parallel_task_scope {
+    const bool was_in_parallel_task;
+    parallel_task_scope() : was_in_parallel_task(in_parallel_task) { in_parallel_task = true; }
+    ~parallel_task_scope() { in_parallel_task = was_in_parallel_task; }
+};
+
+void parallel_for(const size_t num_tasks, const std::function<void(size_t)> &task)
+{
+    if (num_tasks == 1 || in_parallel_task)
+    {
+        /* a parallel_for inside a task runs inline, so run is never re-entered */
+        for (size_t i = 0; i < num_tasks; ++i)
+        {
+            task(i);
+        }
+    }
+    else if (num_tasks > 1)
+    {
+        current_parallel_executor().run(num_tasks, [&task](const size_t i) {
+            const parallel_task_scope scope;
+            task(i);
+        });
+    }
+}
+
+} // namespace libff
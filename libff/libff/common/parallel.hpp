@@ -0,0 +1,51 @@
+/** @file
+ *****************************************************************************
+ Declaration of the executor used to run parallel loops.
+
+ Parallel loops in the library (parallel_for) go through one global executor.
+ By default it is OpenMP when compiled with MULTICORE and serial otherwise;
+ an application that has its own thread pool installs it with
+ set_parallel_executor, so that the library neither starts threads of its
+ own nor oversubscribes the machine.
+
+ A parallel_for called from inside a task runs inline on that task's thread,
+ so run is never called re-entrantly and a fixed-size pool whose workers all
+ wait on inner loops cannot deadlock.
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#ifndef PARALLEL_HPP_
+#define PARALLEL_HPP_
+
+#include <cstddef>
+#include <functional>
+
+namespace libff {
+
+/**
+ * run(num_tasks, task) calls task(0), ..., task(num_tasks - 1), in any
+ * order and possibly concurrently, and returns once all calls have returned.
+ * parallel_for never calls run from inside one of its tasks.
+ * concurrency is the number of tasks it runs at once, which callers use to
+ * decide how finely to split their work.
+ */
+struct parallel_executor {
+    std::size_t concurrency;
+    std::function<void(std::size_t, const std::function<void(std::size_t)>&)> run;
+};
+
+/* OpenMP with MULTICORE, otherwise a loop on the calling thread. */
+parallel_executor default_parallel_executor();
+
+/* Not thread-safe: install the executor before any parallel work starts. */
+void set_parallel_executor(const parallel_executor &executor);
+const parallel_executor& get_parallel_executor();
+
+std::size_t parallel_concurrency();
+void parallel_for(const std::size_t num_tasks, const std::function<void(std::size_t)> &task);
+
+} // namespace libff
+
+#endif // PARALLEL_HPP_
@@ -1,6 +1,14 @@
 /** @file
  *****************************************************************************
  Declaration of functions for generating randomness.
+
+ SHA512_rng maps an index to a field element by hashing the index together
+ with a retry counter and rejecting digests that are not below the modulus.
+ The seeded variants prepend a 64-bit seed to the hashed message, and
+ SHA512_rng_vector samples a whole range of indices at once: the hashes are
+ computed sha512_lanes at a time with sha512_multi_buffer and the range is
+ split over parallel_for. Every element depends only on (seed, index), so
+ the output does not depend on the executor or the number of threads.
  *****************************************************************************
  * @author     This file is part of libff, developed by SCIPR Lab
  *             and contributors (see AUTHORS).
@@ -10,12 +18,24 @@
 #define RNG_HPP_
 
 #include <cstdint>
+#include <vector>
 
 namespace libff {
 
+/** Field element from SHA-512(idx || iter). */
 template<typename FieldT>
 FieldT SHA512_rng(const uint64_t idx);
 
+/** Field element from SHA-512(seed || idx || iter). */
+template<typename FieldT>
+FieldT SHA512_rng(const uint64_t seed, const uint64_t idx);
+
+/** result[i] = SHA512_rng<FieldT>(seed, first_idx + i) for i < count. */
+template<typename FieldT>
+std::vector<FieldT> SHA512_rng_vector(const uint64_t seed,
+                                      const uint64_t first_idx,
+                                      const std::size_t count);
+
 } // namespace libff
 
 #include <libff/common/rng.tcc>
@@ -11,64 +11,190 @@
 #ifndef RNG_TCC_
 #define RNG_TCC_
 
+#include <algorithm>
+#include <cstring>
 #include <gmp.h>
-#include <openssl/sha.h>
+#include <sodium/crypto_hash_sha512.h>
 
 #include <libff/algebra/field_utils/bigint.hpp>
+#include <libff/common/parallel.hpp>
 #include <libff/common/rng.hpp>
+#include <libff/common/sha512_multi_buffer.hpp>
 #include <libff/common/utils.hpp>
 
 namespace libff {
 
 using std::size_t;
 
+/* Number of elements sampled by one parallel_for task of SHA512_rng_vector. */
+const size_t SHA512_rng_slice_size = 1ul << 12;
+
+/* All bits up to and including the MSB of the modulus. */
 template<typename FieldT>
-FieldT SHA512_rng(const uint64_t idx)
+bigint<FieldT::num_limbs> SHA512_rng_mask()
+{
+    bigint<FieldT::num_limbs> mask;
+    const size_t num_bits = FieldT::mod.num_bits();
+    for (size_t i = 0; i < FieldT::num_limbs; ++i)
+    {
+        if (num_bits >= GMP_NUMB_BITS * (i + 1))
+        {
+            mask.data[i] = ~mp_limb_t(0);
+        }
+        else if (num_bits > GMP_NUMB_BITS * i)
+        {
+            mask.data[i] = (mp_limb_t(1) << (num_bits - GMP_NUMB_BITS * i)) - 1;
+        }
+    }
+    return mask;
+}
+
+/* Masks the digest down to the bit length of the modulus and accepts it if
+   the result is below the modulus (rejection sampling). */
+template<typename FieldT>
+bool SHA512_rng_accept(const unsigned char *hash,
+                       const bigint<FieldT::num_limbs> &mask,
+                       bigint<FieldT::num_limbs> &rval)
+{
+    std::memcpy(rval.data, hash, sizeof(rval.data));
+    for (size_t i = 0; i < FieldT::num_limbs; ++i)
+    {
+        rval.data[i] &= mask.data[i];
+    }
+    return mpn_cmp(rval.data, FieldT::mod.data, FieldT::num_limbs) < 0;
+}
+
+template<typename FieldT>
+void SHA512_rng_check_assumptions()
 {
     assert(GMP_NUMB_BITS == 64); // current Python code cannot handle larger values, so testing here for some assumptions.
     assert(is_little_endian());
 
-    assert(FieldT::ceil_size_in_bits() <= SHA512_DIGEST_LENGTH * 8);
+    assert(FieldT::ceil_size_in_bits() <= crypto_hash_sha512_BYTES * 8);
+}
+
+template<typename FieldT>
+FieldT SHA512_rng(const uint64_t idx)
+{
+    SHA512_rng_check_assumptions<FieldT>();
 
+    const bigint<FieldT::num_limbs> mask = SHA512_rng_mask<FieldT>();
     bigint<FieldT::num_limbs> rval;
     uint64_t iter = 0;
+    unsigned char hash[crypto_hash_sha512_BYTES];
     do
     {
-        mp_limb_t hash[((SHA512_DIGEST_LENGTH*8) + GMP_NUMB_BITS - 1)/GMP_NUMB_BITS];
+        crypto_hash_sha512_state sha512;
+        crypto_hash_sha512_init(&sha512);
+        crypto_hash_sha512_update(&sha512, (const unsigned char*)&idx, sizeof(idx));
+        crypto_hash_sha512_update(&sha512, (const unsigned char*)&iter, sizeof(iter));
+        crypto_hash_sha512_final(&sha512, hash);
+
+        ++iter;
+    }
+    while (!SHA512_rng_accept<FieldT>(hash, mask, rval));
 
-        SHA512_CTX sha512;
-        SHA512_Init(&sha512);
-        SHA512_Update(&sha512, &idx, sizeof(idx));
-        SHA512_Update(&sha512, &iter, sizeof(iter));
-        SHA512_Final((unsigned char*)hash, &sha512);
+    return FieldT(rval);
+}
 
-        for (mp_size_t i = 0; i < FieldT::num_limbs; ++i)
-        {
-            rval.data[i] = hash[i];
-        }
+template<typename FieldT>
+FieldT SHA512_rng(const uint64_t seed, const uint64_t idx)
+{
+    SHA512_rng_check_assumptions<FieldT>();
 
-        /* clear all bits higher than MSB of modulus */
-        size_t bitno = GMP_NUMB_BITS * FieldT::num_limbs - 1;
+    const bigint<FieldT::num_limbs> mask = SHA512_rng_mask<FieldT>();
+    bigint<FieldT::num_limbs> rval;
+    uint64_t message[3] = { seed, idx, 0 };
+    unsigned char hash[crypto_hash_sha512_BYTES];
+    do
+    {
+        crypto_hash_sha512(hash, (const unsigned char*)message, sizeof(message));
+        ++message[2];
+    }
+    while (!SHA512_rng_accept<FieldT>(hash, mask, rval));
 
-        /* mod is non-zero so the loop will always terminate */
-        while (FieldT::mod.test_bit(bitno) == false)
-        {
-            const std::size_t part = bitno/GMP_NUMB_BITS;
-            const std::size_t bit = bitno - (GMP_NUMB_BITS*part);
+    return FieldT(rval);
+}
 
-            static const mp_limb_t one = 1;
-            rval.data[part] &= ~(one<<bit);
+template<typename FieldT>
+std::vector<FieldT> SHA512_rng_vector(const uint64_t seed,
+                                      const uint64_t first_idx,
+                                      const size_t count)
+{
+    SHA512_rng_check_assumptions<FieldT>();
 
-            bitno--;
-        }
+    const bigint<FieldT::num_limbs> mask = SHA512_rng_mask<FieldT>();
+    std::vector<FieldT> result(count);
 
-        ++iter;
-    }
+    const size_t num_slices = (count + SHA512_rng_slice_size - 1) / SHA512_rng_slice_size;
+    parallel_for(num_slices, [&](const size_t slice)
+    {
+        const size_t begin = slice * SHA512_rng_slice_size;
+        const size_t end = std::min(count, begin + SHA512_rng_slice_size);
+
+        /* Every lane holds the message seed || idx || iter of one pending
+           element; a rejected element stays in its lane with iter + 1 and
+           an accepted one makes room for the next element of the slice. */
+        uint64_t message[sha512_lanes][3];
+        unsigned char hash[sha512_lanes][crypto_hash_sha512_BYTES];
+        const unsigned char *messages[sha512_lanes];
+        unsigned char *digests[sha512_lanes];
+        size_t lane_element[sha512_lanes];
+        bool lane_active[sha512_lanes];
+
+        size_t next = begin;
+        size_t num_active = 0;
+        for (size_t l = 0; l < sha512_lanes; ++l)
+        {
+            messages[l] = (const unsigned char*)message[l];
+            digests[l] = hash[l];
+            message[l][0] = seed;
+            message[l][1] = first_idx + next;
+            message[l][2] = 0;
+            lane_element[l] = next;
+            lane_active[l] = (next < end);
+            if (lane_active[l])
+            {
+                ++next;
+                ++num_active;
+            }
+        }
 
-    /* if r.data is still >= modulus -- repeat (rejection sampling) */
-    while (mpn_cmp(rval.data, FieldT::mod.data, FieldT::num_limbs) >= 0);
+        bigint<FieldT::num_limbs> rval;
+        while (num_active > 0)
+        {
+            sha512_multi_buffer(messages, sizeof(message[0]), digests);
+
+            for (size_t l = 0; l < sha512_lanes; ++l)
+            {
+                if (!lane_active[l])
+                {
+                    continue;
+                }
+
+                if (!SHA512_rng_accept<FieldT>(hash[l], mask, rval))
+                {
+                    ++message[l][2];
+                    continue;
+                }
+
+                result[lane_element[l]] = FieldT(rval);
+                if (next < end)
+                {
+                    message[l][1] = first_idx + next;
+                    message[l][2] = 0;
+                    lane_element[l] = next++;
+                }
+                else
+                {
+                    lane_active[l] = false;
+                    --num_active;
+                }
+            }
+        }
+    });
 
-    return FieldT(rval);
+    return result;
 }
 
 } // namespace libff
@@ -0,0 +1,161 @@
+/** @file
+ *****************************************************************************
+ Implementation of a multi-buffer SHA-512 for short messages (FIPS 180-4).
+
+ See sha512_multi_buffer.hpp .
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include <libff/common/sha512_multi_buffer.hpp>
+
+namespace libff {
+
+using std::size_t;
+
+static const uint64_t sha512_initial_state[8] = {
+    0x6a09e667f3bcc908ull, 0xbb67ae8584caa73bull, 0x3c6ef372fe94f82bull, 0xa54ff53a5f1d36f1ull,
+    0x510e527fade682d1ull, 0x9b05688c2b3e6c1full, 0x1f83d9abfb41bd6bull, 0x5be0cd19137e2179ull,
+};
+
+static const uint64_t sha512_round_constants[80] = {
+    0x428a2f98d728ae22ull, 0x7137449123ef65cdull, 0xb5c0fbcfec4d3b2full, 0xe9b5dba58189dbbcull,
+    0x3956c25bf348b538ull, 0x59f111f1b605d019ull, 0x923f82a4af194f9bull, 0xab1c5ed5da6d8118ull,
+    0xd807aa98a3030242ull, 0x12835b0145706fbeull, 0x243185be4ee4b28cull, 0x550c7dc3d5ffb4e2ull,
+    0x72be5d74f27b896full, 0x80deb1fe3b1696b1ull, 0x9bdc06a725c71235ull, 0xc19bf174cf692694ull,
+    0xe49b69c19ef14ad2ull, 0xefbe4786384f25e3ull, 0x0fc19dc68b8cd5b5ull, 0x240ca1cc77ac9c65ull,
+    0x2de92c6f592b0275ull, 0x4a7484aa6ea6e483ull, 0x5cb0a9dcbd41fbd4ull, 0x76f988da831153b5ull,
+    0x983e5152ee66dfabull, 0xa831c66d2db43210ull, 0xb00327c898fb213full, 0xbf597fc7beef0ee4ull,
+    0xc6e00bf33da88fc2ull, 0xd5a79147930aa725ull, 0x06ca6351e003826full, 0x142929670a0e6e70ull,
+    0x27b70a8546d22ffcull, 0x2e1b21385c26c926ull, 0x4d2c6dfc5ac42aedull, 0x53380d139d95b3dfull,
+    0x650a73548baf63deull, 0x766a0abb3c77b2a8ull, 0x81c2c92e47edaee6ull, 0x92722c851482353bull,
+    0xa2bfe8a14cf10364ull, 0xa81a664bbc423001ull, 0xc24b8b70d0f89791ull, 0xc76c51a30654be30ull,
+    0xd192e819d6ef5218ull, 0xd69906245565a910ull, 0xf40e35855771202aull, 0x106aa07032bbd1b8ull,
+    0x19a4c116b8d2d0c8ull, 0x1e376c085141ab53ull, 0x2748774cdf8eeb99ull, 0x34b0bcb5e19b48a8ull,
+    0x391c0cb3c5c95a63ull, 0x4ed8aa4ae3418acbull, 0x5b9cca4f7763e373ull, 0x682e6ff3d6b2b8a3ull,
+    0x748f82ee5defb2fcull, 0x78a5636f43172f60ull, 0x84c87814a1f0ab72ull, 0x8cc702081a6439ecull,
+    0x90befffa23631e28ull, 0xa4506cebde82bde9ull, 0xbef9a3f7b2c67915ull, 0xc67178f2e372532bull,
+    0xca273eceea26619cull, 0xd186b8c721c0c207ull, 0xeada7dd6cde0eb1eull, 0xf57d4f7fee6ed178ull,
+    0x06f067aa72176fbaull, 0x0a637dc5a2c898a6ull, 0x113f9804bef90daeull, 0x1b710b35131c471bull,
+    0x28db77f523047d84ull, 0x32caab7b40c72493ull, 0x3c9ebe0a15c9bebcull, 0x431d67c49c100d4cull,
+    0x4cc5d4becb3e42b6ull, 0x597f299cfc657e2aull, 0x5fcb6fab3ad6faecull, 0x6c44198c4a475817ull,
+};
+
+static inline uint64_t rotr(const uint64_t x, const unsigned n)
+{
+    return (x >> n) | (x << (64 - n));
+}
+
+/* One round on every lane: d += T1 and h = T1 + T2, with the roles of the
+   working variables given by the arguments. */
+static inline void sha512_round(const uint64_t *a, const uint64_t *b, const uint64_t *c, uint64_t *d,
+                                const uint64_t *e, const uint64_t *f, const uint64_t *g, uint64_t *h,
+                                const uint64_t k, const uint64_t *w)
+{
+    for (size_t l = 0; l < sha512_lanes; ++l)
+    {
+        const uint64_t S1 = rotr(e[l], 14) ^ rotr(e[l], 18) ^ rotr(e[l], 41);
+        const uint64_t ch = (e[l] & f[l]) ^ (~e[l] & g[l]);
+        const uint64_t t1 = h[l] + S1 + ch + k + w[l];
+        const uint64_t S0 = rotr(a[l], 28) ^ rotr(a[l], 34) ^ rotr(a[l], 39);
+        const uint64_t maj = (a[l] & b[l]) ^ (a[l] & c[l]) ^ (b[l] & c[l]);
+
+        d[l] += t1;
+        h[l] = t1 + S0 + maj;
+    }
+}
+
+/* Word t >= 16 of the message schedule of every lane, over word t - 16 in
+   the ring buffer w of the last 16 words. */
+static inline void sha512_schedule(uint64_t w[16][sha512_lanes], const size_t t)
+{
+    for (size_t l = 0; l < sha512_lanes; ++l)
+    {
+        const uint64_t w15 = w[(t - 15) % 16][l];
+        const uint64_t w2 = w[(t - 2) % 16][l];
+        const uint64_t s0 = rotr(w15, 1) ^ rotr(w15, 8) ^ (w15 >> 7);
+        const uint64_t s1 = rotr(w2, 19) ^ rotr(w2, 61) ^ (w2 >> 6);
+        w[t % 16][l] += s0 + w[(t - 7) % 16][l] + s1;
+    }
+}
+
+void sha512_multi_buffer(const unsigned char *const messages[sha512_lanes],
+                         const size_t len,
+                         unsigned char *const digests[sha512_lanes])
+{
+    assert(len <= sha512_single_block_max_len);
+
+    /* w[t][l] is word t of the message schedule of lane l, kept for the last 16 rounds */
+    uint64_t w[16][sha512_lanes];
+    for (size_t l = 0; l < sha512_lanes; ++l)
+    {
+        /* the message, 0x80, zeros, and the length in bits as a 128-bit big-endian integer */
+        unsigned char block[128] = { 0 };
+        std::memcpy(block, messages[l], len);
+        block[len] = 0x80;
+        block[126] = static_cast<unsigned char>((8 * len) >> 8);
+        block[127] = static_cast<unsigned char>(8 * len);
+
+        for (size_t t = 0; t < 16; ++t)
+        {
+            uint64_t word = 0;
+            for (size_t j = 0; j < 8; ++j)
+            {
+                word = (word << 8) | block[8 * t + j];
+            }
+            w[t][l] = word;
+        }
+    }
+
+    uint64_t v[8][sha512_lanes];
+    for (size_t i = 0; i < 8; ++i)
+    {
+        for (size_t l = 0; l < sha512_lanes; ++l)
+        {
+            v[i][l] = sha512_initial_state[i];
+        }
+    }
+
+    /* eight rounds at a time, with the working variables a, ..., h renamed
+       instead of moved: round t uses v[(8 - t % 8) % 8] as a, and so on */
+    for (size_t t = 0; t < 80; t += 8)
+    {
+        if (t >= 16)
+        {
+            for (size_t i = 0; i < 8; ++i)
+            {
+                sha512_schedule(w, t + i);
+            }
+        }
+
+        const uint64_t *k = sha512_round_constants + t;
+        uint64_t (*wt)[sha512_lanes] = w + t % 16;
+        sha512_round(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], k[0], wt[0]);
+        sha512_round(v[7], v[0], v[1], v[2], v[3], v[4], v[5], v[6], k[1], wt[1]);
+        sha512_round(v[6], v[7], v[0], v[1], v[2], v[3], v[4], v[5], k[2], wt[2]);
+        sha512_round(v[5], v[6], v[7], v[0], v[1], v[2], v[3], v[4], k[3], wt[3]);
+        sha512_round(v[4], v[5], v[6], v[7], v[0], v[1], v[2], v[3], k[4], wt[4]);
+        sha512_round(v[3], v[4], v[5], v[6], v[7], v[0], v[1], v[2], k[5], wt[5]);
+        sha512_round(v[2], v[3], v[4], v[5], v[6], v[7], v[0], v[1], k[6], wt[6]);
+        sha512_round(v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[0], k[7], wt[7]);
+    }
+
+    for (size_t l = 0; l < sha512_lanes; ++l)
+    {
+        for (size_t i = 0; i < 8; ++i)
+        {
+            const uint64_t word = v[i][l] + sha512_initial_state[i];
+            for (size_t j = 0; j < 8; ++j)
+            {
+                digests[l][8 * i + j] = static_cast<unsigned char>(word >> (56 - 8 * j));
+            }
+        }
+    }
+}
+
+} // namespace libff
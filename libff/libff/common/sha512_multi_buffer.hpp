@@ -0,0 +1,37 @@
+/** @file
+ *****************************************************************************
+ Declaration of a multi-buffer SHA-512 for short messages.
+
+ The SHA512_rng samplers hash many short messages of the same length. Here
+ sha512_lanes of them are hashed in lock step, one SHA-512 block each, with
+ the state of every round held as one array per working variable, so that
+ the compiler keeps the lanes side by side in vector registers.
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#ifndef SHA512_MULTI_BUFFER_HPP_
+#define SHA512_MULTI_BUFFER_HPP_
+
+#include <cstddef>
+
+namespace libff {
+
+/** Number of messages hashed by one call to sha512_multi_buffer. */
+const std::size_t sha512_lanes = 4;
+
+/** Longest message that fits in a single SHA-512 block with its padding. */
+const std::size_t sha512_single_block_max_len = 111;
+
+/**
+ * digests[i] = SHA-512(messages[i]) for i < sha512_lanes, where every message
+ * is len <= sha512_single_block_max_len bytes long and every digest 64 bytes.
+ */
+void sha512_multi_buffer(const unsigned char *const messages[sha512_lanes],
+                         const std::size_t len,
+                         unsigned char *const digests[sha512_lanes]);
+
+} // namespace libff
+
+#endif // SHA512_MULTI_BUFFER_HPP_
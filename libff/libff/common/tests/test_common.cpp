@@ -7,11 +7,18 @@
  * @copyright  MIT license (see LICENSE file)
  *****************************************************************************/
 
+#include <atomic>
 #include <cstdint>
 #include <gtest/gtest.h>
+#include <thread>
+#include <sodium/crypto_hash_sha512.h>
 
+#include "libff/common/parallel.hpp"
+#include "libff/common/rng.hpp"
+#include "libff/common/sha512_multi_buffer.hpp"
 #include "libff/common/utils.hpp"
 #include "libff/algebra/fields/binary/gf32.hpp"
+#include "libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp"
 #include "libff/algebra/curves/edwards/edwards_pp.hpp"
 #include "libff/algebra/curves/mnt/mnt6/mnt6_pp.hpp"
 
@@ -85,3 +92,137 @@ TEST(UtilsTest, CurveVectorSizeTest)
 
     EXPECT_EQ(curve_size_in_bits(vec2), 4475);
 }
+
+TEST(SHA512Test, MultiBufferMatchesLibsodium)
+{
+    unsigned char input[sha512_lanes][sha512_single_block_max_len];
+    for (size_t l = 0; l < sha512_lanes; ++l)
+    {
+        for (size_t i = 0; i < sha512_single_block_max_len; ++i)
+        {
+            input[l][i] = (unsigned char)(31 * l + 7 * i + 1);
+        }
+    }
+
+    const unsigned char *messages[sha512_lanes];
+    unsigned char hash[sha512_lanes][crypto_hash_sha512_BYTES];
+    unsigned char *digests[sha512_lanes];
+    for (size_t l = 0; l < sha512_lanes; ++l)
+    {
+        messages[l] = input[l];
+        digests[l] = hash[l];
+    }
+
+    for (size_t len = 0; len <= sha512_single_block_max_len; ++len)
+    {
+        sha512_multi_buffer(messages, len, digests);
+        for (size_t l = 0; l < sha512_lanes; ++l)
+        {
+            unsigned char expected[crypto_hash_sha512_BYTES];
+            crypto_hash_sha512(expected, input[l], len);
+            EXPECT_EQ(memcmp(hash[l], expected, crypto_hash_sha512_BYTES), 0) << "len " << len << ", lane " << l;
+        }
+    }
+}
+
+TEST(SHA512RngTest, KnownAnswers)
+{
+    /* Outputs of the OpenSSL based implementation this one replaced. */
+    init_alt_bn128_params();
+    EXPECT_EQ(SHA512_rng<alt_bn128_Fr>(0).as_bigint(), bigint<alt_bn128_r_limbs>("5901664031594756870901022840938571430092748518409938027808594609694559595531"));
+    EXPECT_EQ(SHA512_rng<alt_bn128_Fr>(1).as_bigint(), bigint<alt_bn128_r_limbs>("2623993134767973899289026264413087532500524413624878814009764222325597261423"));
+    EXPECT_EQ(SHA512_rng<alt_bn128_Fr>(12345).as_bigint(), bigint<alt_bn128_r_limbs>("8029516250699101682804929367888226227213781317478636682379435598959432103910"));
+    EXPECT_EQ(SHA512_rng<alt_bn128_Fq>(7).as_bigint(), bigint<alt_bn128_q_limbs>("17649087800562696877348783588431102909263456041751169867330057717444634239422"));
+}
+
+/* Runs each task on its own thread, in reverse order, to check that slices do not depend on each other. */
+parallel_executor thread_per_task_executor()
+{
+    parallel_executor executor;
+    executor.concurrency = 4;
+    executor.run = [](const size_t num_tasks, const std::function<void(size_t)> &task) {
+        std::vector<std::thread> threads;
+        for (size_t i = num_tasks; i-- > 0; )
+        {
+            threads.emplace_back(task, i);
+        }
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+    };
+    return executor;
+}
+
+TEST(SHA512RngTest, VectorMatchesScalar)
+{
+    init_alt_bn128_params();
+    const uint64_t seed = 0x0123456789abcdefULL;
+    const uint64_t first_idx = 1000;
+
+    /* An odd count that spans several slices and leaves idle lanes at the end. */
+    const std::size_t count = 2 * SHA512_rng_slice_size + 5;
+
+    std::vector<alt_bn128_Fq> reference;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        reference.emplace_back(SHA512_rng<alt_bn128_Fq>(seed, first_idx + i));
+    }
+
+    for (const parallel_executor &executor : { default_parallel_executor(), thread_per_task_executor() })
+    {
+        set_parallel_executor(executor);
+        EXPECT_EQ(SHA512_rng_vector<alt_bn128_Fq>(seed, first_idx, count), reference);
+        EXPECT_TRUE(SHA512_rng_vector<alt_bn128_Fq>(seed, first_idx, 0).empty());
+    }
+    set_parallel_executor(default_parallel_executor());
+
+    EXPECT_NE(SHA512_rng<alt_bn128_Fq>(seed, first_idx), SHA512_rng<alt_bn128_Fq>(seed + 1, first_idx));
+}
+
+TEST(ParallelTest, NestedParallelForRunsInline)
+{
+    /* a thread-per-task executor that records whether run is entered from one of its tasks */
+    std::atomic<size_t> running(0);
+    std::atomic<bool> reentered(false);
+    parallel_executor executor;
+    executor.concurrency = 4;
+    executor.run = [&](const size_t num_tasks, const std::function<void(size_t)> &task) {
+        if (running.load() > 0)
+        {
+            reentered = true;
+        }
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < num_tasks; ++i)
+        {
+            threads.emplace_back([&, i]() {
+                ++running;
+                task(i);
+                --running;
+            });
+        }
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+    };
+
+    set_parallel_executor(executor);
+    std::vector<std::atomic<size_t> > calls(4 * 3);
+    parallel_for(4, [&](const size_t i) {
+        parallel_for(3, [&](const size_t j) {
+            ++calls[3 * i + j];
+        });
+    });
+    /* the inner loops are done, so a new outer loop goes to the executor again */
+    parallel_for(2, [&](const size_t i) {
+        ++calls[i];
+    });
+    set_parallel_executor(default_parallel_executor());
+
+    EXPECT_FALSE(reentered);
+    for (size_t k = 0; k < calls.size(); ++k)
+    {
+        EXPECT_EQ(calls[k], (k < 2 ? 2u : 1u));
+    }
+}
@@ -0,0 +1,395 @@
+//! Benchmarks for the BN254 syscalls.
+//!
+//! Usage: zig build bench -Doptimize=ReleaseFast -- [--time-ms N] [--filter S] [--json PATH]
+//!
+//! Every case is timed one call at a time, so besides the mean (ns/op) we also
+//! report p50/p99 latency. On x86_64 the time stamp counter is read around each
+//! call as well; note that it ticks at the reference frequency, not the current
+//! core frequency. With `--json` the results are written out so that runs of two
+//! versions can be diffed.
+//!
+//! Cases of the same operation and input length are also compared with each
+//! other: the spread is the ratio of the slowest to the fastest p50 among them.
+//! Build with `-Dfixed_schedule` to see it for the input-independent schedule.
+
+const std = @import("std");
+const builtin = @import("builtin");
+const ff = @import("ff");
+const build_options = @import("build_options");
+
+pub const Op = enum {
+    add,
+    mul,
+    pairing,
+    compress_g1,
+    decompress_g1,
+    compress_g2,
+    decompress_g2,
+
+    pub fn symbol(op: Op) []const u8 {
+        return switch (op) {
+            .add => "bn254_add_syscall",
+            .mul => "bn254_mul_syscall",
+            .pairing => "bn254_pairing_syscall",
+            .compress_g1 => "bn254_compress_g1_syscall",
+            .decompress_g1 => "bn254_decompress_g1_syscall",
+            .compress_g2 => "bn254_compress_g2_syscall",
+            .decompress_g2 => "bn254_decompress_g2_syscall",
+        };
+    }
+
+    pub fn call(op: Op, input: []const u8, out: *[128]u8) c_int {
+        return switch (op) {
+            .add => ff.bn254_add_syscall(input.ptr, out),
+            .mul => ff.bn254_mul_syscall(input.ptr, out),
+            .pairing => ff.bn254_pairing_syscall(input.ptr, input.len, out),
+            .compress_g1 => ff.bn254_compress_g1_syscall(input.ptr, out),
+            .decompress_g1 => ff.bn254_decompress_g1_syscall(input.ptr, out),
+            .compress_g2 => ff.bn254_compress_g2_syscall(input.ptr, out),
+            .decompress_g2 => ff.bn254_decompress_g2_syscall(input.ptr, out),
+        };
+    }
+};
+
+const Case = struct {
+    name: []const u8,
+    op: Op,
+    input: []const u8,
+    /// Return code the syscall must produce, checked before timing.
+    status: c_int = 0,
+};
+
+const Result = struct {
+    name: []const u8,
+    op: []const u8,
+    input_len: usize,
+    iterations: usize,
+    ns_per_op: f64,
+    cycles_per_op: ?f64,
+    min_ns: u64,
+    p50_ns: u64,
+    p99_ns: u64,
+    max_ns: u64,
+};
+
+/// Fastest and slowest case among those of one operation and input length.
+const Spread = struct {
+    op: []const u8,
+    input_len: usize,
+    best: []const u8,
+    best_p50_ns: u64,
+    worst: []const u8,
+    worst_p50_ns: u64,
+
+    fn ratio(spread: Spread) f64 {
+        return @as(f64, @floatFromInt(spread.worst_p50_ns)) / @as(f64, @floatFromInt(@max(spread.best_p50_ns, 1)));
+    }
+};
+
+const Report = struct {
+    version: u32 = 1,
+    arch: []const u8 = @tagName(builtin.cpu.arch),
+    os: []const u8 = @tagName(builtin.os.tag),
+    optimize: []const u8 = @tagName(builtin.mode),
+    fixed_schedule: bool = build_options.fixed_schedule,
+    time_ms: u64,
+    results: []const Result,
+    spreads: []const Spread,
+};
+
+/// Folds a successful result into the spread of its operation and input length.
+fn addToSpreads(spreads: *std.ArrayList(Spread), result: Result) !void {
+    for (spreads.items) |*spread| {
+        if (!std.mem.eql(u8, spread.op, result.op) or spread.input_len != result.input_len) continue;
+        if (result.p50_ns < spread.best_p50_ns) {
+            spread.best = result.name;
+            spread.best_p50_ns = result.p50_ns;
+        }
+        if (result.p50_ns > spread.worst_p50_ns) {
+            spread.worst = result.name;
+            spread.worst_p50_ns = result.p50_ns;
+        }
+        return;
+    }
+    try spreads.append(.{
+        .op = result.op,
+        .input_len = result.input_len,
+        .best = result.name,
+        .best_p50_ns = result.p50_ns,
+        .worst = result.name,
+        .worst_p50_ns = result.p50_ns,
+    });
+}
+
+// [agave] https://github.com/anza-xyz/agave/blob/v1.18.6/sdk/program/src/alt_bn128/mod.rs#L401
+const add_input = "18b18acfb4c2c30276db5411368e7185b311dd124691610c5d3b74034e093dc9063c909c4720840cb5134cb9f59fa749755796819658d32efc0d288198f3726607c2b7f58a84bd6145f00c9c2bc0bb1a187f20ff2c92963a88019e7c6a014eed06614e20c147e940f2d70da3f74c9a17df361706a4485c742bd6788478fa17d7";
+const mul_point = "2bd3e6d0f3b142924f5ca7b49ce5b9d54c4703d7ae5648e61d02268b1a0a9fb721611ce0a6af85915e2f1d70300909ce2e49dfad4a4619c8390cae66cefdb204";
+
+// Two-pair pairing checks that hold (EIP-197 test vectors), concatenated they
+// have the shape of a Groth16 verification: e(A, B) e(alpha, beta) e(vk_x, gamma) e(C, delta).
+pub const pairing_input_a = "1c76476f4def4bb94541d57ebba1193381ffa7aa76ada664dd31c16024c43f593034dd2920f673e204fee2811c678745fc819b55d3e9d294e45c9b03a76aef41209dd15ebff5d46c4bd888e51a93cf99a7329636c63514396b4a452003a35bf704bf11ca01483bfa8b34b43561848d28905960114c8ac04049af4b6315a416782bb8324af6cfc93537a2ad1a445cfd0ca2a71acd7ac41fadbf933c2a51be344d120a2a4cf30c1bf9845f20c6fe39e07ea2cce61f0c9bb048165fe5e4de877550111e129f1cf1097710d41c4ac70fcdfa5ba2023c6ff1cbeac322de49d1b6df7c2032c61a830e3c17286de9462bf242fca2883585b93870a73853face6a6bf411198e9393920d483a7260bfb731fb5d25f1aa493335a9e71297e485b7aef312c21800deef121f1e76426a00665e5c4479674322d4f75edadd46debd5cd992f6ed090689d0585ff075ec9e99ad690c3395bc4b313370b38ef355acdadcd122975b12c85ea5db8c6deb4aab71808dcb408fe3d1e7690c43d37b4ce6cc0166fa7daa";
+pub const pairing_input_b = "2eca0c7238bf16e83e7a1e6c5d49540685ff51380f309842a98561558019fc0203d3260361bb8451de5ff5ecd17f010ff22f5c31cdf184e9020b06fa5997db841213d2149b006137fcfb23036606f848d638d576a120ca981b5b1a5f9300b3ee2276cf730cf493cd95d64677bbb75fc42db72513a4c1e387b476d056f80aa75f21ee6226d31426322afcda621464d0611d226783262e21bb3bc86b537e986237096df1f82dff337dd5972e32a8ad43e28a78a96a823ef1cd4debe12b6552ea5f06967a1237ebfeca9aaae0d6d0bab8e28c198c5a339ef8a2407e31cdac516db922160fa257a5fd5b280642ff47b65eca77e626cb685c84fa6d3b6882a283ddd1198e9393920d483a7260bfb731fb5d25f1aa493335a9e71297e485b7aef312c21800deef121f1e76426a00665e5c4479674322d4f75edadd46debd5cd992f6ed090689d0585ff075ec9e99ad690c3395bc4b313370b38ef355acdadcd122975b12c85ea5db8c6deb4aab71808dcb408fe3d1e7690c43d37b4ce6cc0166fa7daa";
+// (1, 2) paired with a point on the twist that is not in the order-r subgroup.
+const pairing_input_bad_g2 = "000000000000000000000000000000000000000000000000000000000000000100000000000000000000000000000000000000000000000000000000000000020000000000000000000000000000000000000000000000000000000000000001000000000000000000000000000000000000000000000000000000000000000028a7a81c6bf2a75dc9f0125bb581747e9e6b33fc3b2710a2309cef97a3163c6523712136978ed49faf2120ca4f7f71cfd4e7b46ffa0ea89edbc94ddc59238e9f";
+
+const scalars = [_]struct { name: []const u8, hex: []const u8 }{
+    .{ .name = "254-bit", .hex = "183227397098d014dc2822db40c0ac2ecbc0b548b438e5469e10460b6c3e7ea3" },
+    .{ .name = "r-1", .hex = "30644e72e131a029b85045b68181585d2833e84879b9709143e1f593f0000000" },
+    .{ .name = "2^256-1", .hex = "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff" },
+    .{ .name = "2^128", .hex = "0000000000000000000000000000000100000000000000000000000000000000" },
+    .{ .name = "9", .hex = "0000000000000000000000000000000000000000000000000000000000000009" },
+    .{ .name = "1", .hex = "0000000000000000000000000000000000000000000000000000000000000001" },
+    .{ .name = "0", .hex = "0000000000000000000000000000000000000000000000000000000000000000" },
+};
+
+const pair_counts = [_]usize{ 1, 2, 3, 4, 6, 8, 12, 16 };
+
+pub const field_modulus: u256 = 0x30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd47;
+
+pub fn fromHex(allocator: std.mem.Allocator, hex: []const u8) ![]u8 {
+    const bytes = try allocator.alloc(u8, hex.len / 2);
+    return std.fmt.hexToBytes(bytes, hex);
+}
+
+fn negateG1(allocator: std.mem.Allocator, point: []const u8) ![]u8 {
+    const out = try allocator.dupe(u8, point[0..64]);
+    const y = std.mem.readInt(u256, out[32..64], .big);
+    std.mem.writeInt(u256, out[32..64], if (y == 0) 0 else field_modulus - y, .big);
+    return out;
+}
+
+/// `count` pairs taken round-robin from `pairs`.
+fn repeatPairs(allocator: std.mem.Allocator, pairs: []const u8, count: usize) ![]u8 {
+    const out = try allocator.alloc(u8, count * 192);
+    const available = pairs.len / 192;
+    for (0..count) |i| {
+        const j = i % available;
+        @memcpy(out[i * 192 ..][0..192], pairs[j * 192 ..][0..192]);
+    }
+    return out;
+}
+
+fn buildCorpus(allocator: std.mem.Allocator) ![]const Case {
+    var cases = std.ArrayList(Case).init(allocator);
+
+    const zeros = try allocator.alloc(u8, 192);
+    @memset(zeros, 0);
+
+    // add
+    const add = try fromHex(allocator, add_input);
+    const p = add[0..64];
+    const neg_p = try negateG1(allocator, p);
+    try cases.append(.{ .name = "add/generic", .op = .add, .input = add });
+    try cases.append(.{ .name = "add/doubling", .op = .add, .input = try std.mem.concat(allocator, u8, &.{ p, p }) });
+    try cases.append(.{ .name = "add/P+(-P)", .op = .add, .input = try std.mem.concat(allocator, u8, &.{ p, neg_p }) });
+    try cases.append(.{ .name = "add/P+O", .op = .add, .input = try std.mem.concat(allocator, u8, &.{ p, zeros[0..64] }) });
+    try cases.append(.{ .name = "add/O+O", .op = .add, .input = zeros[0..128] });
+
+    // mul
+    const point = try fromHex(allocator, mul_point);
+    for (scalars) |scalar| {
+        const input = try std.mem.concat(allocator, u8, &.{ point, try fromHex(allocator, scalar.hex) });
+        const name = try std.fmt.allocPrint(allocator, "mul/{s}", .{scalar.name});
+        try cases.append(.{ .name = name, .op = .mul, .input = input });
+    }
+    try cases.append(.{
+        .name = "mul/O*254-bit",
+        .op = .mul,
+        .input = try std.mem.concat(allocator, u8, &.{ zeros[0..64], try fromHex(allocator, scalars[0].hex) }),
+    });
+
+    // pairing
+    const pairs = try std.mem.concat(allocator, u8, &.{
+        try fromHex(allocator, pairing_input_a),
+        try fromHex(allocator, pairing_input_b),
+    });
+    try cases.append(.{ .name = "pairing/groth16", .op = .pairing, .input = pairs });
+    try cases.append(.{ .name = "pairing/0", .op = .pairing, .input = zeros[0..0] });
+    for (pair_counts) |count| {
+        const name = try std.fmt.allocPrint(allocator, "pairing/{d}", .{count});
+        try cases.append(.{ .name = name, .op = .pairing, .input = try repeatPairs(allocator, pairs, count) });
+    }
+    try cases.append(.{
+        .name = "pairing/G1=O",
+        .op = .pairing,
+        .input = try std.mem.concat(allocator, u8, &.{ zeros[0..64], pairs[64..192] }),
+    });
+    try cases.append(.{
+        .name = "pairing/G2 not in subgroup",
+        .op = .pairing,
+        .input = try fromHex(allocator, pairing_input_bad_g2),
+        .status = -1,
+    });
+
+    // compression, on the points of the Groth16 input and on the identity
+    var g1_compressed: [32]u8 = undefined;
+    var g2_compressed: [64]u8 = undefined;
+    if (ff.bn254_compress_g1_syscall(pairs.ptr, &g1_compressed) != 0) return error.Unexpected;
+    if (ff.bn254_compress_g2_syscall(pairs.ptr + 64, &g2_compressed) != 0) return error.Unexpected;
+    try cases.append(.{ .name = "compress_g1/generic", .op = .compress_g1, .input = pairs[0..64] });
+    try cases.append(.{ .name = "compress_g1/O", .op = .compress_g1, .input = zeros[0..64] });
+    try cases.append(.{ .name = "decompress_g1/generic", .op = .decompress_g1, .input = try allocator.dupe(u8, &g1_compressed) });
+    try cases.append(.{ .name = "decompress_g1/O", .op = .decompress_g1, .input = zeros[0..32] });
+    try cases.append(.{ .name = "compress_g2/generic", .op = .compress_g2, .input = pairs[64..192] });
+    try cases.append(.{ .name = "compress_g2/O", .op = .compress_g2, .input = zeros[0..128] });
+    try cases.append(.{ .name = "decompress_g2/generic", .op = .decompress_g2, .input = try allocator.dupe(u8, &g2_compressed) });
+    try cases.append(.{ .name = "decompress_g2/O", .op = .decompress_g2, .input = zeros[0..64] });
+
+    return cases.toOwnedSlice();
+}
+
+pub inline fn readCycles() ?u64 {
+    switch (builtin.cpu.arch) {
+        .x86_64 => {
+            var lo: u32 = undefined;
+            var hi: u32 = undefined;
+            asm volatile ("rdtsc"
+                : [lo] "={eax}" (lo),
+                  [hi] "={edx}" (hi),
+            );
+            return (@as(u64, hi) << 32) | lo;
+        },
+        else => return null,
+    }
+}
+
+fn run(allocator: std.mem.Allocator, case: Case, time_ms: u64) !Result {
+    var out: [128]u8 = undefined;
+    var timer = try std.time.Timer.start();
+
+    // Warm up and estimate the cost of one call, so that every case gets
+    // roughly the same time budget.
+    const warmup_ns = @max(time_ms * std.time.ns_per_ms / 10, 1);
+    var warmup_calls: u64 = 0;
+    while (warmup_calls < 3 or timer.read() < warmup_ns) : (warmup_calls += 1) {
+        const status = case.op.call(case.input, &out);
+        if (status != case.status) {
+            std.debug.print("{s}: returned {d}, expected {d}\n", .{ case.name, status, case.status });
+            return error.UnexpectedStatus;
+        }
+    }
+    const estimate = @max(timer.read() / warmup_calls, 1);
+    const iterations = std.math.clamp(time_ms * std.time.ns_per_ms / estimate, 10, 1_000_000);
+
+    const samples = try allocator.alloc(u64, iterations);
+    defer allocator.free(samples);
+    var total_ns: u64 = 0;
+    var total_cycles: u64 = 0;
+    for (samples) |*sample| {
+        const c0 = readCycles();
+        const t0 = timer.read();
+        const status = case.op.call(case.input, &out);
+        const t1 = timer.read();
+        const c1 = readCycles();
+        std.mem.doNotOptimizeAway(status);
+
+        sample.* = t1 - t0;
+        total_ns += sample.*;
+        if (c0) |c| total_cycles += c1.? -% c;
+    }
+    std.mem.sort(u64, samples, {}, std.sort.asc(u64));
+
+    const n: f64 = @floatFromInt(iterations);
+    return .{
+        .name = case.name,
+        .op = case.op.symbol(),
+        .input_len = case.input.len,
+        .iterations = iterations,
+        .ns_per_op = @as(f64, @floatFromInt(total_ns)) / n,
+        .cycles_per_op = if (readCycles() != null) @as(f64, @floatFromInt(total_cycles)) / n else null,
+        .min_ns = samples[0],
+        .p50_ns = samples[(iterations - 1) / 2],
+        // nearest rank
+        .p99_ns = samples[(iterations * 99 + 99) / 100 - 1],
+        .max_ns = samples[iterations - 1],
+    };
+}
+
+fn usage() noreturn {
+    std.debug.print("usage: bench [--time-ms N] [--filter SUBSTRING] [--json PATH]\n", .{});
+    std.process.exit(1);
+}
+
+pub fn main() !void {
+    var arena_state = std.heap.ArenaAllocator.init(std.heap.page_allocator);
+    defer arena_state.deinit();
+    const arena = arena_state.allocator();
+
+    var time_ms: u64 = 500;
+    var filter: ?[]const u8 = null;
+    var json_path: ?[]const u8 = null;
+
+    const args = try std.process.argsAlloc(arena);
+    var i: usize = 1;
+    while (i < args.len) : (i += 1) {
+        const arg = args[i];
+        if (i + 1 == args.len) usage();
+        if (std.mem.eql(u8, arg, "--time-ms")) {
+            i += 1;
+            time_ms = std.fmt.parseInt(u64, args[i], 10) catch usage();
+        } else if (std.mem.eql(u8, arg, "--filter")) {
+            i += 1;
+            filter = args[i];
+        } else if (std.mem.eql(u8, arg, "--json")) {
+            i += 1;
+            json_path = args[i];
+        } else usage();
+    }
+
+    if (builtin.mode == .Debug) {
+        std.debug.print("warning: benchmarking a Debug build, pass -Doptimize=ReleaseFast\n", .{});
+    }
+
+    const corpus = try buildCorpus(arena);
+    var results = std.ArrayList(Result).init(arena);
+    var spreads = std.ArrayList(Spread).init(arena);
+
+    const stdout = std.io.getStdOut().writer();
+    try stdout.print("{s:<28} {s:>6} {s:>9} {s:>14} {s:>14} {s:>12} {s:>12}\n", .{
+        "case", "bytes", "iters", "ns/op", "cycles/op", "p50 ns", "p99 ns",
+    });
+    for (corpus) |case| {
+        if (filter) |f| {
+            if (std.mem.indexOf(u8, case.name, f) == null) continue;
+        }
+        const result = try run(arena, case, time_ms);
+        try results.append(result);
+        if (case.status == 0) try addToSpreads(&spreads, result);
+
+        try stdout.print("{s:<28} {d:>6} {d:>9} {d:>14.1} ", .{
+            result.name, result.input_len, result.iterations, result.ns_per_op,
+        });
+        if (result.cycles_per_op) |cycles| {
+            try stdout.print("{d:>14.1} ", .{cycles});
+        } else {
+            try stdout.print("{s:>14} ", .{"-"});
+        }
+        try stdout.print("{d:>12} {d:>12}\n", .{ result.p50_ns, result.p99_ns });
+    }
+
+    try stdout.print("\nspread of p50 between cases of the same length (fixed_schedule = {}):\n", .{
+        build_options.fixed_schedule,
+    });
+    for (spreads.items) |spread| {
+        if (std.mem.eql(u8, spread.best, spread.worst)) continue;
+        try stdout.print("{s:<28} {d:>6} {s:>24} {d:>12} {s:>24} {d:>12} {d:>8.2}x\n", .{
+            spread.op,           spread.input_len,
+            spread.best,         spread.best_p50_ns,
+            spread.worst,        spread.worst_p50_ns,
+            spread.ratio(),
+        });
+    }
+
+    if (json_path) |path| {
+        const file = try std.fs.cwd().createFile(path, .{});
+        defer file.close();
+        var buffered = std.io.bufferedWriter(file.writer());
+        try std.json.stringify(
+            Report{ .time_ms = time_ms, .results = results.items, .spreads = spreads.items },
+            .{ .whitespace = .indent_2 },
+            buffered.writer(),
+        );
+        try buffered.writer().writeByte('\n');
+        try buffered.flush();
+    }
+}
@@ -8,6 +8,14 @@ extern "C" {
 #include <libff/algebra/curves/alt_bn128/alt_bn128_init.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_pairing.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_g1.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_g2.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_init.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_pairing.hpp>
+#include <libff/algebra/curves/curve_utils.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+
+#include <sodium/crypto_hash_sha512.h>
 
 #define BN254_FIELD_FOOTPRINT 32
 
@@ -17,6 +25,18 @@ static bool initialized = false;
 #define FLAG_NEG ((uint8_t)(1 << 7))
 #define FLAG_MASK 0x3F
 
+/*
+ * With BN254_FIXED_SCHEDULE defined, inputs that would otherwise take a
+ * shortcut do the same work as any other input: points at infinity are
+ * validated, multiplied and paired as if they were the generator (and the
+ * result dropped), and scalar multiplication uses a fixed-window ladder whose
+ * schedule does not depend on the scalar. The time of a syscall is then bounded
+ * by, and close to, that of its worst-case input of the same length.
+ */
+#ifdef BN254_FIXED_SCHEDULE
+#define BN254_FIXED_WINDOW 4
+#endif
+
 static libff::alt_bn128_Fq *bytes_to_Fq(uint8_t const input[32],
                                         libff::alt_bn128_Fq *X, int *is_inf,
                                         int *is_neg) {
@@ -82,6 +102,11 @@ static libff::alt_bn128_G1 *bytes_to_G1(uint8_t const input[64],
     return NULL;
   }
   if (p->is_zero()) {
+#ifdef BN254_FIXED_SCHEDULE
+    if (!libff::alt_bn128_G1::one().is_well_formed()) {
+      return NULL;
+    }
+#endif
     return p;
   }
 
@@ -129,26 +154,37 @@ static libff::alt_bn128_G2 *bytes_to_G2_internal(uint8_t const input[128],
   return out;
 }
 
+static bool G2_is_valid(libff::alt_bn128_G2 const *p) {
+  if (!p->is_well_formed()) {
+    return false;
+  }
+
+  // libff doesn't do a subgroup membership check in its `is_well_formed` function
+  // See https://eprint.iacr.org/2022/348, Sec 3.1 for Alg.
+  // [r]P == 0 <==> [x+1]P + ψ([x]P) + ψ²([x]P) = ψ³([2x]P)
+  // TODO: this is an extremely!! slow check, do the cool frob method instead
+  auto r = libff::alt_bn128_modulus_r * *p; 
+  return r.is_zero();
+}
+
 static libff::alt_bn128_G2 *bytes_to_G2(uint8_t const input[128],
                                         libff::alt_bn128_G2 *p) {
   if (!bytes_to_G2_internal(input, p)) {
     return NULL;
   }
   if (p->is_zero()) {
+#ifdef BN254_FIXED_SCHEDULE
+    const libff::alt_bn128_G2 g = libff::alt_bn128_G2::one();
+    if (!G2_is_valid(&g)) {
+      return NULL;
+    }
+#endif
     return p;
   }
 
-  if (!p->is_well_formed()) {
+  if (!G2_is_valid(p)) {
     return NULL;
   }
-
-  // libff doesn't do a subgroup membership check in its `is_well_formed` function
-  // See https://eprint.iacr.org/2022/348, Sec 3.1 for Alg.
-  // [r]P == 0 <==> [x+1]P + ψ([x]P) + ψ²([x]P) = ψ³([2x]P)
-  // TODO: this is an extremely!! slow check, do the cool frob method instead
-  auto r = libff::alt_bn128_modulus_r * *p; 
-  if (!r.is_zero()) return NULL;
-
   return p;
 }
 
@@ -215,7 +251,18 @@ int bn254_mul_syscall(uint8_t const *__restrict input,
   for (uint64_t i = 0; i < BN254_BIGINT_FOOTPRINT; ++i)
     t[BN254_BIGINT_FOOTPRINT - 1U - i] = input[64 + i];
 
+#ifdef BN254_FIXED_SCHEDULE
+  const bool is_zero = A.is_zero();
+  auto result = libff::fixed_window_scalar_mul<libff::alt_bn128_G1,
+                                               libff::alt_bn128_r_limbs,
+                                               BN254_FIXED_WINDOW>(
+      is_zero ? libff::alt_bn128_G1::one() : A, s);
+  if (is_zero) {
+    result = libff::alt_bn128_G1::zero();
+  }
+#else
   auto result = s * A;
+#endif
   G1_to_bytes(result, out);
   return 0;
 }
@@ -230,9 +277,14 @@ int bn254_pairing_syscall(uint8_t const *__restrict input, uintptr_t input_len,
 
   auto element_length = input_len / 192;
 
-  // TODO: use more parallel miller loop
-
-  libff::alt_bn128_GT tmp = libff::alt_bn128_GT::one();
+#ifdef BN254_FIXED_SCHEDULE
+  // In fixed-schedule mode every pair runs through the Miller loop. A skipped
+  // pair uses a G1 precomp with PX = PY = 0: its line values then lie in Fq6,
+  // which the final exponentiation sends to one.
+  std::vector<libff::alt_bn128_ate_G1_precomp> prec_P;
+  std::vector<libff::alt_bn128_ate_G2_precomp> prec_Q;
+  prec_P.reserve(element_length);
+  prec_Q.reserve(element_length);
   for (uint64_t i = 0; i < element_length; i++) {
     libff::alt_bn128_G1 A;
     libff::alt_bn128_G2 B;
@@ -244,16 +296,45 @@ int bn254_pairing_syscall(uint8_t const *__restrict input, uintptr_t input_len,
       return -1;
     }
 
-    // Skip any pair where either A or B are points at infinity.
-    if (A.is_zero() || B.is_zero())
-      continue;
+    const bool skip = A.is_zero() || B.is_zero();
+    auto prec_A = libff::alt_bn128_ate_precompute_G1(
+        skip ? libff::alt_bn128_G1::one() : A);
+    if (skip) {
+      prec_A.PX = libff::alt_bn128_Fq::zero();
+      prec_A.PY = libff::alt_bn128_Fq::zero();
+    }
+    prec_P.emplace_back(prec_A);
+    prec_Q.emplace_back(libff::alt_bn128_ate_precompute_G2(
+        skip ? libff::alt_bn128_G2::one() : B));
+  }
+
+  auto f = libff::alt_bn128_ate_multi_miller_loop(prec_P, prec_Q);
+  const bool is_one =
+      libff::alt_bn128_final_exponentiation(f) == libff::alt_bn128_GT::one();
+#else
+  std::vector<std::pair<libff::alt_bn128_G1, libff::alt_bn128_G2>> pairs;
+  pairs.reserve(element_length);
+  for (uint64_t i = 0; i < element_length; i++) {
+    libff::alt_bn128_G1 A;
+    libff::alt_bn128_G2 B;
+
+    if (!bytes_to_G1(&input[192 * i], &A)) {
+      return -1;
+    }
+    if (!bytes_to_G2(&input[192 * i + 64], &B)) {
+      return -1;
+    }
 
-    tmp *= libff::alt_bn128_ate_pairing(A, B);
+    // Pairs where either A or B are points at infinity are skipped by the
+    // product check.
+    pairs.emplace_back(A, B);
   }
 
-  auto result = libff::alt_bn128_final_exponentiation(tmp);
+  const bool is_one = libff::alt_bn128_pairing_product_is_one(pairs);
+#endif
+
   memset(out, 0, 32);
-  out[31] = result == libff::alt_bn128_GT::one();
+  out[31] = is_one;
   return 0;
 }
 
@@ -290,20 +371,6 @@ int bn254_compress_g1_syscall(uint8_t const *__restrict input,
   return 0;
 }
 
-libff::alt_bn128_Fq *fast_sqrt(const libff::alt_bn128_Fq &a, libff::alt_bn128_Fq *out) {
-
-  auto a1 = a ^ libff::alt_bn128_Fq::t_minus_1_over_2;
-  auto a0 = a1.squared() * a;
-
-  auto p_minus_one = libff::bigint<4UL>("15537367993719455909907449462855742678907882278146377936676643359958227611562");
-  if (a0 == p_minus_one) {
-    return NULL;
-  }
-
-  *out = a1 * a;
-  return out;
-}
-
 int bn254_decompress_g1_syscall(uint8_t const *__restrict input,
                                 uint8_t *__restrict out) {
   if (!initialized) {
@@ -338,7 +405,7 @@ int bn254_decompress_g1_syscall(uint8_t const *__restrict input,
   libff::alt_bn128_Fq X2(X);
   X2.square();
   libff::alt_bn128_Fq X3_plus_b = X * X2 + libff::alt_bn128_coeff_b;
-  auto root = X3_plus_b.sqrt();
+  auto root = libff::alt_bn128_Fq_sqrt(X3_plus_b);
   if (root == std::nullopt) {
     return -1;
   }
@@ -440,3 +507,633 @@ int bn254_decompress_g2_syscall(uint8_t const *__restrict input,
   Fq_to_bytes(&Y.c0, out + 64 + 32);
   return 0;
 }
+
+int bn254_multi_exp(uint8_t const *__restrict points,
+                    uint8_t const *__restrict scalars, uintptr_t num_points,
+                    uint8_t *__restrict out) {
+  if (!initialized) {
+    libff::init_alt_bn128_params();
+    initialized = true;
+  }
+  libff::inhibit_profiling_info = true;
+
+  std::vector<libff::alt_bn128_G1> bases(num_points);
+  std::vector<libff::alt_bn128_Fr> exponents(num_points);
+  for (uint64_t i = 0; i < num_points; i++) {
+    if (!bytes_to_G1(points + BN254_G1_FOOTPRINT * i, &bases[i]))
+      return -1;
+
+    /* Convert big-endian to little-endian while copying */
+    libff::bigint<libff::alt_bn128_r_limbs> s;
+    static_assert(sizeof(s.data) == BN254_BIGINT_FOOTPRINT);
+    uint8_t *t = (uint8_t *)(s.data);
+    for (uint64_t j = 0; j < BN254_BIGINT_FOOTPRINT; ++j)
+      t[BN254_BIGINT_FOOTPRINT - 1U - j] = scalars[BN254_BIGINT_FOOTPRINT * i + j];
+
+    // As in bn254_mul_syscall, any 256-bit scalar is accepted; G1 has prime
+    // order r, so reducing it first gives the same point.
+    if (s.cmp(libff::alt_bn128_modulus_r) >= 0) {
+      mp_limb_t q;
+      mpn_tdiv_qr(&q, s.data, 0, s.data, libff::alt_bn128_r_limbs,
+                  libff::alt_bn128_modulus_r.data, libff::alt_bn128_r_limbs);
+    }
+    exponents[i] = libff::alt_bn128_Fr(s);
+  }
+
+  auto result = libff::multi_exp<libff::alt_bn128_G1, libff::alt_bn128_Fr,
+                                 libff::multi_exp_method_BDLO12>(
+      bases.data(), exponents.data(), num_points, 1);
+  G1_to_bytes(result, out);
+  return 0;
+}
+
+/*
+ * Groth16 batch verification
+ *
+ * A proof (A, B, C) for public inputs x_1..x_n is valid when
+ *
+ *   e(A, B) == e(alpha, beta) e(vk_x, gamma) e(C, delta),
+ *   vk_x = IC_0 + \sum_j x_j IC_j.
+ *
+ * k proofs are folded with 128-bit scalars r_i into the single check
+ *
+ *   \prod_i e(r_i A_i, B_i) e(-(\sum_i r_i) alpha, beta)
+ *       e(-\sum_i r_i vk_x_i, gamma) e(-\sum_i r_i C_i, delta) == 1,
+ *
+ * where \sum_i r_i vk_x_i = (\sum_i r_i) IC_0 + \sum_j (\sum_i r_i x_ij) IC_j,
+ * so k proofs cost k+3 pairs in one shared Miller loop (see
+ * alt_bn128_pairing_product_is_one) and one final exponentiation. The scalars
+ * are SHA512(transcript || i) truncated to 128 bits, with i as 8 little-endian
+ * bytes and the transcript being the SHA-512 of a domain tag and all the
+ * inputs, so the result does not depend on a random source or on the host,
+ * and an invalid batch passes with probability at most 2^-128.
+ */
+
+#define BN254_GROTH16_VK_FOOTPRINT                                             \
+  (BN254_G1_FOOTPRINT + 3 * BN254_G2_FOOTPRINT)
+#define BN254_GROTH16_PROOF_FOOTPRINT                                          \
+  (2 * BN254_G1_FOOTPRINT + BN254_G2_FOOTPRINT)
+
+static const mp_size_t groth16_scalar_limbs = 128 / GMP_NUMB_BITS;
+static const char groth16_batch_domain_tag[] = "bn254-groth16-verify-batch-v1";
+
+static bool bytes_to_Fr(uint8_t const input[32], libff::alt_bn128_Fr *x) {
+  libff::bigint<libff::alt_bn128_r_limbs> bi;
+  static_assert(sizeof(bi.data) == BN254_BIGINT_FOOTPRINT);
+
+  /* Convert big-endian to little-endian while copying */
+  uint8_t *t = (uint8_t *)(bi.data);
+  for (uint64_t i = 0; i < BN254_BIGINT_FOOTPRINT; ++i)
+    t[BN254_BIGINT_FOOTPRINT - 1U - i] = input[i];
+
+  if (bi.cmp(libff::alt_bn128_modulus_r) >= 0) {
+    return false;
+  }
+
+  *x = libff::alt_bn128_Fr(bi);
+  return true;
+}
+
+int bn254_groth16_verify_batch(uint8_t const *__restrict vk, uintptr_t vk_len,
+                               uint8_t const *__restrict proofs,
+                               uint8_t const *__restrict public_inputs,
+                               uintptr_t num_proofs, uint8_t *__restrict out) {
+  if (!initialized) {
+    libff::init_alt_bn128_params();
+    initialized = true;
+  }
+  libff::inhibit_profiling_info = true;
+
+  if (vk_len < BN254_GROTH16_VK_FOOTPRINT + BN254_G1_FOOTPRINT ||
+      (vk_len - BN254_GROTH16_VK_FOOTPRINT) % BN254_G1_FOOTPRINT != 0) {
+    return -1;
+  }
+  const uint64_t num_ic = (vk_len - BN254_GROTH16_VK_FOOTPRINT) / BN254_G1_FOOTPRINT;
+  const uint64_t num_inputs = num_ic - 1;
+
+  // Validate the verifying key.
+  libff::alt_bn128_G1 alpha;
+  libff::alt_bn128_G2 beta, gamma, delta;
+  if (!bytes_to_G1(vk, &alpha) ||
+      !bytes_to_G2(vk + BN254_G1_FOOTPRINT, &beta) ||
+      !bytes_to_G2(vk + BN254_G1_FOOTPRINT + BN254_G2_FOOTPRINT, &gamma) ||
+      !bytes_to_G2(vk + BN254_G1_FOOTPRINT + 2 * BN254_G2_FOOTPRINT, &delta)) {
+    return -1;
+  }
+  std::vector<libff::alt_bn128_G1> ic(num_ic);
+  for (uint64_t j = 0; j < num_ic; j++) {
+    if (!bytes_to_G1(vk + BN254_GROTH16_VK_FOOTPRINT + BN254_G1_FOOTPRINT * j,
+                     &ic[j])) {
+      return -1;
+    }
+  }
+
+  memset(out, 0, 32);
+  if (num_proofs == 0) {
+    out[31] = 1;
+    return 0;
+  }
+
+  // Derive the folding scalars from everything the check depends on.
+  unsigned char transcript[crypto_hash_sha512_BYTES];
+  {
+    crypto_hash_sha512_state sha512;
+    crypto_hash_sha512_init(&sha512);
+    crypto_hash_sha512_update(&sha512,
+                              (const unsigned char *)groth16_batch_domain_tag,
+                              sizeof(groth16_batch_domain_tag) - 1);
+    crypto_hash_sha512_update(&sha512, vk, vk_len);
+    crypto_hash_sha512_update(&sha512, proofs,
+                              BN254_GROTH16_PROOF_FOOTPRINT * num_proofs);
+    crypto_hash_sha512_update(&sha512, public_inputs,
+                              BN254_BIGINT_FOOTPRINT * num_inputs * num_proofs);
+    crypto_hash_sha512_final(&sha512, transcript);
+  }
+
+  std::vector<libff::alt_bn128_G1> c(num_proofs);
+  std::vector<libff::alt_bn128_Fr> r(num_proofs);
+  std::vector<libff::alt_bn128_Fr> ic_scalars(num_ic, libff::alt_bn128_Fr::zero());
+  std::vector<std::pair<libff::alt_bn128_G1, libff::alt_bn128_G2>> pairs;
+  pairs.reserve(num_proofs + 3);
+
+  for (uint64_t i = 0; i < num_proofs; i++) {
+    uint8_t const *proof = proofs + BN254_GROTH16_PROOF_FOOTPRINT * i;
+    uint8_t const *inputs = public_inputs + BN254_BIGINT_FOOTPRINT * num_inputs * i;
+
+    libff::alt_bn128_G1 A;
+    libff::alt_bn128_G2 B;
+    if (!bytes_to_G1(proof, &A) ||
+        !bytes_to_G2(proof + BN254_G1_FOOTPRINT, &B) ||
+        !bytes_to_G1(proof + BN254_G1_FOOTPRINT + BN254_G2_FOOTPRINT, &c[i])) {
+      return -1;
+    }
+
+    unsigned char hash[crypto_hash_sha512_BYTES];
+    crypto_hash_sha512_state sha512;
+    crypto_hash_sha512_init(&sha512);
+    crypto_hash_sha512_update(&sha512, transcript, sizeof(transcript));
+    uint8_t i_bytes[8];
+    for (uint64_t b = 0; b < sizeof(i_bytes); b++) {
+      i_bytes[b] = (uint8_t)(i >> (8 * b));
+    }
+    crypto_hash_sha512_update(&sha512, i_bytes, sizeof(i_bytes));
+    crypto_hash_sha512_final(&sha512, hash);
+
+    libff::bigint<groth16_scalar_limbs> r_bits;
+    memcpy(r_bits.data, hash, sizeof(r_bits.data));
+    libff::bigint<libff::alt_bn128_r_limbs> r_wide;
+    memcpy(r_wide.data, r_bits.data, sizeof(r_bits.data));
+    r[i] = libff::alt_bn128_Fr(r_wide);
+
+    ic_scalars[0] += r[i];
+    for (uint64_t j = 0; j < num_inputs; j++) {
+      libff::alt_bn128_Fr x;
+      if (!bytes_to_Fr(inputs + BN254_BIGINT_FOOTPRINT * j, &x)) {
+        return -1;
+      }
+      ic_scalars[j + 1] += r[i] * x;
+    }
+
+    // Pairs where either A or B are points at infinity are skipped below.
+    pairs.emplace_back(r_bits * A, B);
+  }
+
+  const libff::alt_bn128_G1 vk_x =
+      libff::multi_exp<libff::alt_bn128_G1, libff::alt_bn128_Fr,
+                       libff::multi_exp_method_BDLO12>(
+          ic.begin(), ic.end(), ic_scalars.begin(), ic_scalars.end(), 1);
+  const libff::alt_bn128_G1 C =
+      libff::multi_exp<libff::alt_bn128_G1, libff::alt_bn128_Fr,
+                       libff::multi_exp_method_BDLO12>(
+          c.begin(), c.end(), r.begin(), r.end(), 1);
+
+  pairs.emplace_back(-(ic_scalars[0] * alpha), beta);
+  pairs.emplace_back(-vk_x, gamma);
+  pairs.emplace_back(-C, delta);
+
+  out[31] = libff::alt_bn128_pairing_product_is_one(pairs);
+  return 0;
+}
+
+/*
+ * BLS12-381
+ *
+ * Points use the Zcash serialization: big-endian 48-byte field elements,
+ * Fq2 elements as c1 || c0, and the three most significant bits of the first
+ * byte as flags (compressed, infinity, lexicographically largest y).
+ */
+
+#define BLS12_381_FIELD_FOOTPRINT 48
+
+#define BLS_FLAG_COMPRESSED ((uint8_t)(1 << 7))
+#define BLS_FLAG_INF ((uint8_t)(1 << 6))
+#define BLS_FLAG_SIGN ((uint8_t)(1 << 5))
+#define BLS_FLAG_MASK 0x1F
+
+static bool bls12_381_initialized = false;
+
+static void bls12_381_init() {
+  if (!bls12_381_initialized) {
+    libff::init_bls12_381_params();
+    bls12_381_initialized = true;
+  }
+}
+
+static libff::bls12_381_Fq *bls_bytes_to_Fq(uint8_t const input[48],
+                                            libff::bls12_381_Fq *X) {
+  libff::bigint<libff::bls12_381_q_limbs> bi;
+  static_assert(sizeof(bi.data) == BLS12_381_FIELD_FOOTPRINT);
+
+  /* Convert big-endian to little-endian while copying */
+  uint8_t *t = (uint8_t *)(bi.data);
+  for (uint64_t i = 0; i < BLS12_381_FIELD_FOOTPRINT; ++i)
+    t[BLS12_381_FIELD_FOOTPRINT - 1U - i] = input[i];
+
+  // Check that it's a valid field element.
+  if (bi.cmp(libff::bls12_381_modulus_q) >= 0) {
+    return NULL;
+  }
+
+  *X = libff::bls12_381_Fq(bi);
+  return X;
+}
+
+static void bls_Fq_to_bytes(libff::bls12_381_Fq const *X, uint8_t *out) {
+  libff::bigint<libff::bls12_381_q_limbs> bi = X->as_bigint();
+  /* Convert little-endian to big-endian while copying */
+  const uint8_t *t = (const uint8_t *)bi.data;
+  for (uint64_t i = 0; i < BLS12_381_FIELD_FOOTPRINT; ++i)
+    out[i] = t[BLS12_381_FIELD_FOOTPRINT - 1U - i];
+}
+
+static libff::bls12_381_Fq2 *bls_bytes_to_Fq2(uint8_t const input[96],
+                                              libff::bls12_381_Fq2 *X) {
+  if (!bls_bytes_to_Fq(input, &X->c1)) {
+    return NULL;
+  }
+  if (!bls_bytes_to_Fq(input + BLS12_381_FIELD_FOOTPRINT, &X->c0)) {
+    return NULL;
+  }
+  return X;
+}
+
+static void bls_Fq2_to_bytes(libff::bls12_381_Fq2 const *X, uint8_t *out) {
+  bls_Fq_to_bytes(&X->c1, out);
+  bls_Fq_to_bytes(&X->c0, out + BLS12_381_FIELD_FOOTPRINT);
+}
+
+static bool bls_Fq_is_neg(libff::bls12_381_Fq const &x) {
+  return x.as_bigint().cmp(libff::bls12_381_Fq::euler) > 0;
+}
+
+static bool bls_Fq2_is_neg(libff::bls12_381_Fq2 const &x) {
+  if (x.c1.is_zero()) {
+    return bls_Fq_is_neg(x.c0);
+  }
+  return bls_Fq_is_neg(x.c1);
+}
+
+/*
+ * Reads the flags of a `len` byte encoding into `flags`, and returns the
+ * encoding with them cleared in `buf`. The point at infinity must have every
+ * other bit zero.
+ */
+static bool bls_read_flags(uint8_t const *input, uint64_t len, bool compressed,
+                           uint8_t *buf, uint8_t *flags) {
+  *flags = input[0] & ~BLS_FLAG_MASK;
+  if (!!(*flags & BLS_FLAG_COMPRESSED) != compressed) {
+    return false;
+  }
+  if (!compressed && (*flags & BLS_FLAG_SIGN)) {
+    return false;
+  }
+
+  memcpy(buf, input, len);
+  buf[0] &= BLS_FLAG_MASK;
+
+  if (*flags & BLS_FLAG_INF) {
+    if (*flags & BLS_FLAG_SIGN) {
+      return false;
+    }
+    for (uint64_t i = 0; i < len; ++i) {
+      if (buf[i] != 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static libff::bls12_381_G1 *bls_bytes_to_G1(uint8_t const input[96],
+                                            libff::bls12_381_G1 *p) {
+  uint8_t buf[96];
+  uint8_t flags;
+  if (!bls_read_flags(input, 96, false, buf, &flags)) {
+    return NULL;
+  }
+  if (flags & BLS_FLAG_INF) {
+    *p = libff::bls12_381_G1::zero();
+    return p;
+  }
+
+  if (!bls_bytes_to_Fq(buf, &p->X) ||
+      !bls_bytes_to_Fq(buf + BLS12_381_FIELD_FOOTPRINT, &p->Y)) {
+    return NULL;
+  }
+  p->Z = libff::bls12_381_Fq::one();
+
+  if (!p->is_well_formed() || !p->is_in_safe_subgroup()) {
+    return NULL;
+  }
+  return p;
+}
+
+static libff::bls12_381_G2 *bls_bytes_to_G2(uint8_t const input[192],
+                                            libff::bls12_381_G2 *p) {
+  uint8_t buf[192];
+  uint8_t flags;
+  if (!bls_read_flags(input, 192, false, buf, &flags)) {
+    return NULL;
+  }
+  if (flags & BLS_FLAG_INF) {
+    *p = libff::bls12_381_G2::zero();
+    return p;
+  }
+
+  if (!bls_bytes_to_Fq2(buf, &p->X) || !bls_bytes_to_Fq2(buf + 96, &p->Y)) {
+    return NULL;
+  }
+  p->Z = libff::bls12_381_Fq2::one();
+
+  if (!p->is_well_formed() || !p->is_in_safe_subgroup()) {
+    return NULL;
+  }
+  return p;
+}
+
+static void bls_G1_to_bytes(libff::bls12_381_G1 g, uint8_t out[96]) {
+  if (g.is_zero()) {
+    memset(out, 0, 96UL);
+    out[0] = BLS_FLAG_INF;
+    return;
+  }
+
+  g.to_affine_coordinates();
+  bls_Fq_to_bytes(&g.X, out);
+  bls_Fq_to_bytes(&g.Y, out + BLS12_381_FIELD_FOOTPRINT);
+}
+
+static void bls_G2_to_bytes(libff::bls12_381_G2 g, uint8_t out[192]) {
+  if (g.is_zero()) {
+    memset(out, 0, 192UL);
+    out[0] = BLS_FLAG_INF;
+    return;
+  }
+
+  g.to_affine_coordinates();
+  bls_Fq2_to_bytes(&g.X, out);
+  bls_Fq2_to_bytes(&g.Y, out + 96);
+}
+
+static void bls_bytes_to_scalar(uint8_t const input[32],
+                                libff::bigint<libff::bls12_381_r_limbs> *s) {
+  static_assert(sizeof(s->data) == BLS12_381_SCALAR_FOOTPRINT);
+  /* Convert big-endian to little-endian while copying */
+  uint8_t *t = (uint8_t *)(s->data);
+  for (uint64_t i = 0; i < BLS12_381_SCALAR_FOOTPRINT; ++i)
+    t[BLS12_381_SCALAR_FOOTPRINT - 1U - i] = input[i];
+}
+
+int bls12_381_g1_add_syscall(uint8_t const *__restrict input,
+                             uint8_t *__restrict out) {
+  bls12_381_init();
+
+  libff::bls12_381_G1 X;
+  libff::bls12_381_G1 Y;
+  if (!bls_bytes_to_G1(input, &X))
+    return -1;
+  if (!bls_bytes_to_G1(input + BLS12_381_G1_FOOTPRINT, &Y))
+    return -1;
+
+  bls_G1_to_bytes(X + Y, out);
+  return 0;
+}
+
+int bls12_381_g2_add_syscall(uint8_t const *__restrict input,
+                             uint8_t *__restrict out) {
+  bls12_381_init();
+
+  libff::bls12_381_G2 X;
+  libff::bls12_381_G2 Y;
+  if (!bls_bytes_to_G2(input, &X))
+    return -1;
+  if (!bls_bytes_to_G2(input + BLS12_381_G2_FOOTPRINT, &Y))
+    return -1;
+
+  bls_G2_to_bytes(X + Y, out);
+  return 0;
+}
+
+int bls12_381_g1_mul_syscall(uint8_t const *__restrict input,
+                             uint8_t *__restrict out) {
+  bls12_381_init();
+
+  libff::bls12_381_G1 A;
+  if (!bls_bytes_to_G1(input, &A))
+    return -1;
+
+  libff::bigint<libff::bls12_381_r_limbs> s;
+  bls_bytes_to_scalar(input + BLS12_381_G1_FOOTPRINT, &s);
+
+  bls_G1_to_bytes(s * A, out);
+  return 0;
+}
+
+int bls12_381_g2_mul_syscall(uint8_t const *__restrict input,
+                             uint8_t *__restrict out) {
+  bls12_381_init();
+
+  libff::bls12_381_G2 A;
+  if (!bls_bytes_to_G2(input, &A))
+    return -1;
+
+  libff::bigint<libff::bls12_381_r_limbs> s;
+  bls_bytes_to_scalar(input + BLS12_381_G2_FOOTPRINT, &s);
+
+  bls_G2_to_bytes(s * A, out);
+  return 0;
+}
+
+int bls12_381_pairing_syscall(uint8_t const *__restrict input,
+                              uintptr_t input_len, uint8_t *__restrict out) {
+  bls12_381_init();
+  libff::inhibit_profiling_info = true;
+
+  const uint64_t element_length =
+      BLS12_381_G1_FOOTPRINT + BLS12_381_G2_FOOTPRINT;
+  const uint64_t n = input_len / element_length;
+
+  std::vector<libff::bls12_381_G1_precomp> prec_P;
+  std::vector<libff::bls12_381_G2> Q;
+  prec_P.reserve(n);
+  Q.reserve(n);
+
+  for (uint64_t i = 0; i < n; i++) {
+    libff::bls12_381_G1 A;
+    libff::bls12_381_G2 B;
+
+    if (!bls_bytes_to_G1(&input[element_length * i], &A)) {
+      return -1;
+    }
+    if (!bls_bytes_to_G2(&input[element_length * i + BLS12_381_G1_FOOTPRINT],
+                         &B)) {
+      return -1;
+    }
+
+    // Skip any pair where either A or B are points at infinity.
+    if (A.is_zero() || B.is_zero())
+      continue;
+
+    prec_P.emplace_back(libff::bls12_381_precompute_G1(A));
+    Q.emplace_back(B);
+  }
+
+  // Large batches share the inversions of affine G2 precomputation.
+  const auto prec_Q = libff::bls12_381_batch_precompute_G2(Q);
+  // One Miller loop over all the pairs, and a single final exponentiation.
+  auto f = libff::bls12_381_multi_miller_loop(prec_P, prec_Q);
+  auto result = libff::bls12_381_final_exponentiation(f);
+  memset(out, 0, 32);
+  out[31] = result == libff::bls12_381_GT::one();
+  return 0;
+}
+
+int bls12_381_compress_g1_syscall(uint8_t const *__restrict input,
+                                  uint8_t *__restrict out) {
+  bls12_381_init();
+
+  libff::bls12_381_G1 P;
+  if (!bls_bytes_to_G1(input, &P)) {
+    return -1;
+  }
+
+  if (P.is_zero()) {
+    memset(out, 0, 48);
+    out[0] = BLS_FLAG_COMPRESSED | BLS_FLAG_INF;
+    return 0;
+  }
+
+  memmove(out, input, 48);
+  out[0] |= BLS_FLAG_COMPRESSED;
+  if (bls_Fq_is_neg(P.Y)) {
+    out[0] |= BLS_FLAG_SIGN;
+  }
+  return 0;
+}
+
+int bls12_381_decompress_g1_syscall(uint8_t const *__restrict input,
+                                    uint8_t *__restrict out) {
+  bls12_381_init();
+
+  uint8_t buf[48];
+  uint8_t flags;
+  if (!bls_read_flags(input, 48, true, buf, &flags)) {
+    return -1;
+  }
+  if (flags & BLS_FLAG_INF) {
+    bls_G1_to_bytes(libff::bls12_381_G1::zero(), out);
+    return 0;
+  }
+
+  libff::bls12_381_Fq X;
+  if (!bls_bytes_to_Fq(buf, &X)) {
+    return -1;
+  }
+
+  /*
+    Recover Y coordinate from X
+    Y^2 = X^3 + 4
+  */
+  auto root = (X.squared() * X + libff::bls12_381_coeff_b).sqrt();
+  if (root == std::nullopt) {
+    return -1;
+  }
+  libff::bls12_381_Fq Y(*root);
+  if (bls_Fq_is_neg(Y) != !!(flags & BLS_FLAG_SIGN)) {
+    Y = -Y;
+  }
+
+  libff::bls12_381_G1 P(X, Y, libff::bls12_381_Fq::one());
+  if (!P.is_in_safe_subgroup()) {
+    return -1;
+  }
+
+  bls_Fq_to_bytes(&X, out);
+  bls_Fq_to_bytes(&Y, out + BLS12_381_FIELD_FOOTPRINT);
+  return 0;
+}
+
+int bls12_381_compress_g2_syscall(uint8_t const *__restrict input,
+                                  uint8_t *__restrict out) {
+  bls12_381_init();
+
+  libff::bls12_381_G2 P;
+  if (!bls_bytes_to_G2(input, &P)) {
+    return -1;
+  }
+
+  if (P.is_zero()) {
+    memset(out, 0, 96);
+    out[0] = BLS_FLAG_COMPRESSED | BLS_FLAG_INF;
+    return 0;
+  }
+
+  memmove(out, input, 96);
+  out[0] |= BLS_FLAG_COMPRESSED;
+  if (bls_Fq2_is_neg(P.Y)) {
+    out[0] |= BLS_FLAG_SIGN;
+  }
+  return 0;
+}
+
+int bls12_381_decompress_g2_syscall(uint8_t const *__restrict input,
+                                    uint8_t *__restrict out) {
+  bls12_381_init();
+
+  uint8_t buf[96];
+  uint8_t flags;
+  if (!bls_read_flags(input, 96, true, buf, &flags)) {
+    return -1;
+  }
+  if (flags & BLS_FLAG_INF) {
+    bls_G2_to_bytes(libff::bls12_381_G2::zero(), out);
+    return 0;
+  }
+
+  libff::bls12_381_Fq2 X;
+  if (!bls_bytes_to_Fq2(buf, &X)) {
+    return -1;
+  }
+
+  /*
+    Recover Y coordinate from X
+    Y^2 = X^3 + 4(u + 1)
+  */
+  auto root = (X.squared() * X + libff::bls12_381_twist_coeff_b).sqrt();
+  if (root == std::nullopt) {
+    return -1;
+  }
+  libff::bls12_381_Fq2 Y(*root);
+  if (bls_Fq2_is_neg(Y) != !!(flags & BLS_FLAG_SIGN)) {
+    Y = -Y;
+  }
+
+  libff::bls12_381_G2 P(X, Y, libff::bls12_381_Fq2::one());
+  if (!P.is_in_safe_subgroup()) {
+    return -1;
+  }
+
+  bls_Fq2_to_bytes(&X, out);
+  bls_Fq2_to_bytes(&Y, out + 96);
+  return 0;
+}
@@ -26,4 +26,52 @@ int bn254_decompress_g1_syscall(uint8_t const *__restrict input, uint8_t *__rest
 /* input == [128]u8, out == [64]u8 */
 int bn254_compress_g2_syscall(uint8_t const *__restrict input, uint8_t *__restrict out);
 /* input == [64]u8, out == [128]u8 */
-int bn254_decompress_g2_syscall(uint8_t const *__restrict input, uint8_t *__restrict out);
\ No newline at end of file
+int bn254_decompress_g2_syscall(uint8_t const *__restrict input, uint8_t *__restrict out);
+
+/* \sum_i scalar_i * point_i over G1. points == [64 * num_points]u8,
+   scalars == [32 * num_points]u8 big-endian, out == [64]u8 */
+int bn254_multi_exp(uint8_t const *__restrict points,
+                    uint8_t const *__restrict scalars, uintptr_t num_points,
+                    uint8_t *__restrict out);
+
+/* Verifies num_proofs Groth16 proofs against one verifying key at once.
+   vk == alpha (G1) || beta || gamma || delta (G2) || IC_0..IC_n (G1), so
+   vk_len == 448 + 64 * (n + 1); proofs == [256 * num_proofs]u8, each
+   A (G1) || B (G2) || C (G1); public_inputs == [32 * n * num_proofs]u8,
+   big-endian scalars below the group order. out == [32]u8, set as for
+   bn254_pairing_syscall. */
+int bn254_groth16_verify_batch(uint8_t const *__restrict vk, uintptr_t vk_len,
+                               uint8_t const *__restrict proofs,
+                               uint8_t const *__restrict public_inputs,
+                               uintptr_t num_proofs, uint8_t *__restrict out);
+
+#define BLS12_381_G1_FOOTPRINT (96UL)
+#define BLS12_381_G2_FOOTPRINT (192UL)
+#define BLS12_381_G1_COMPRESSED_FOOTPRINT (48UL)
+#define BLS12_381_G2_COMPRESSED_FOOTPRINT (96UL)
+#define BLS12_381_SCALAR_FOOTPRINT (32UL)
+
+/* BLS12-381 points use the Zcash encoding (big-endian, flag bits in the first
+   byte); every point read is checked to be on the curve and in the subgroup. */
+
+/* input == [192]u8, out == [96]u8 */
+int bls12_381_g1_add_syscall(uint8_t const *__restrict input, uint8_t *__restrict out);
+/* input == [384]u8, out == [192]u8 */
+int bls12_381_g2_add_syscall(uint8_t const *__restrict input, uint8_t *__restrict out);
+/* input == [128]u8 (point, big-endian scalar), out == [96]u8 */
+int bls12_381_g1_mul_syscall(uint8_t const *__restrict input, uint8_t *__restrict out);
+/* input == [224]u8 (point, big-endian scalar), out == [192]u8 */
+int bls12_381_g2_mul_syscall(uint8_t const *__restrict input, uint8_t *__restrict out);
+/* input_len % 288 == 0, out == [32]u8 */
+int bls12_381_pairing_syscall(uint8_t const *__restrict input, uintptr_t input_len,
+                              uint8_t *__restrict out);
+
+/* input == [96]u8, out == [48]u8 */
+int bls12_381_compress_g1_syscall(uint8_t const *__restrict input, uint8_t *__restrict out);
+/* input == [48]u8, out == [96]u8 */
+int bls12_381_decompress_g1_syscall(uint8_t const *__restrict input, uint8_t *__restrict out);
+
+/* input == [192]u8, out == [96]u8 */
+int bls12_381_compress_g2_syscall(uint8_t const *__restrict input, uint8_t *__restrict out);
+/* input == [96]u8, out == [192]u8 */
+int bls12_381_decompress_g2_syscall(uint8_t const *__restrict input, uint8_t *__restrict out);
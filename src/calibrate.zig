@@ -0,0 +1,415 @@
+//! Calibrates the BN254 syscall costs against the compute units charged for them.
+//!
+//! Usage: zig build calibrate -Doptimize=ReleaseFast -- [--max-pairs N] [--samples N] [--reps N] [--seed N] [--json PATH]
+//!
+//! Each operation is swept over the input property its cost should depend on:
+//!
+//!   * bn254_pairing_syscall over the number of pairs, 1..max-pairs,
+//!   * bn254_mul_syscall over the Hamming weight of the scalar,
+//!   * bn254_decompress_{g1,g2}_syscall over whether the x coordinate gives a
+//!     quadratic residue (a point) or not (an error).
+//!
+//! For every sweep we fit a linear (ns = b x) and an affine (ns = a + b x) model
+//! by least squares and list the inputs that are furthest above the affine fit.
+//! Every timed input is also divided by its compute-unit charge; the inputs with
+//! the largest ns/CU relative to the median over all inputs are the ones that are
+//! cheap for what they cost to run.
+
+const std = @import("std");
+const builtin = @import("builtin");
+const ff = @import("ff");
+const build_options = @import("build_options");
+const bench = @import("bench.zig");
+
+const Op = bench.Op;
+
+/// Compute-unit table the syscalls are charged from (agave compute budget defaults).
+const cu = struct {
+    const multiplication = 3_840;
+    const pairing_one_pair_first = 36_364;
+    const pairing_one_pair_other = 12_121;
+    const g1_decompress = 398;
+    const g2_decompress = 13_610;
+
+    fn charge(op: Op, x: f64) f64 {
+        return switch (op) {
+            .mul => multiplication,
+            .pairing => pairing_one_pair_first + pairing_one_pair_other * (x - 1),
+            .decompress_g1 => g1_decompress,
+            .decompress_g2 => g2_decompress,
+            else => unreachable,
+        };
+    }
+};
+
+const Point = struct {
+    label: []const u8,
+    x: f64,
+    ns: f64,
+    cu: f64,
+};
+
+const Fit = struct {
+    intercept: f64,
+    slope: f64,
+    r2: f64,
+
+    fn predict(fit: Fit, x: f64) f64 {
+        return fit.intercept + fit.slope * x;
+    }
+};
+
+const Outlier = struct {
+    label: []const u8,
+    x: f64,
+    ns: f64,
+    predicted_ns: f64,
+    /// ns / predicted_ns under the affine fit.
+    excess: f64,
+};
+
+const Sweep = struct {
+    op: []const u8,
+    variable: []const u8,
+    linear: Fit,
+    affine: Fit,
+    outliers: []const Outlier,
+    points: []const Point,
+};
+
+const Charged = struct {
+    op: []const u8,
+    label: []const u8,
+    ns: f64,
+    cu: f64,
+    /// (ns / cu) over the median ns / cu of all inputs.
+    relative_ns_per_cu: f64,
+};
+
+const Report = struct {
+    version: u32 = 1,
+    arch: []const u8 = @tagName(builtin.cpu.arch),
+    os: []const u8 = @tagName(builtin.os.tag),
+    optimize: []const u8 = @tagName(builtin.mode),
+    fixed_schedule: bool = build_options.fixed_schedule,
+    seed: u64,
+    median_ns_per_cu: f64,
+    sweeps: []const Sweep,
+    worst_charged: []const Charged,
+};
+
+const Options = struct {
+    max_pairs: usize = 16,
+    /// Distinct random inputs per swept value.
+    samples: usize = 4,
+    /// Timed calls per input, of which the median is kept.
+    reps: usize = 11,
+    seed: u64 = 0,
+    outliers: usize = 5,
+};
+
+/// Median time of `reps` calls, in nanoseconds.
+fn measure(allocator: std.mem.Allocator, op: Op, input: []const u8, reps: usize) !f64 {
+    var out: [128]u8 = undefined;
+    const samples = try allocator.alloc(u64, reps);
+    defer allocator.free(samples);
+
+    // one untimed call to warm the caches
+    std.mem.doNotOptimizeAway(op.call(input, &out));
+
+    var timer = try std.time.Timer.start();
+    for (samples) |*sample| {
+        const t0 = timer.read();
+        std.mem.doNotOptimizeAway(op.call(input, &out));
+        sample.* = timer.read() - t0;
+    }
+    std.mem.sort(u64, samples, {}, std.sort.asc(u64));
+    return @floatFromInt(samples[reps / 2]);
+}
+
+fn fitLinear(points: []const Point) Fit {
+    var sxx: f64 = 0;
+    var sxy: f64 = 0;
+    for (points) |p| {
+        sxx += p.x * p.x;
+        sxy += p.x * p.ns;
+    }
+    const slope = if (sxx == 0) 0 else sxy / sxx;
+    return .{ .intercept = 0, .slope = slope, .r2 = rSquared(points, .{ .intercept = 0, .slope = slope, .r2 = 0 }) };
+}
+
+fn fitAffine(points: []const Point) Fit {
+    const n: f64 = @floatFromInt(points.len);
+    var mx: f64 = 0;
+    var my: f64 = 0;
+    for (points) |p| {
+        mx += p.x / n;
+        my += p.ns / n;
+    }
+    var sxx: f64 = 0;
+    var sxy: f64 = 0;
+    for (points) |p| {
+        sxx += (p.x - mx) * (p.x - mx);
+        sxy += (p.x - mx) * (p.ns - my);
+    }
+    const slope = if (sxx == 0) 0 else sxy / sxx;
+    const fit: Fit = .{ .intercept = my - slope * mx, .slope = slope, .r2 = 0 };
+    return .{ .intercept = fit.intercept, .slope = fit.slope, .r2 = rSquared(points, fit) };
+}
+
+fn rSquared(points: []const Point, fit: Fit) f64 {
+    const n: f64 = @floatFromInt(points.len);
+    var my: f64 = 0;
+    for (points) |p| my += p.ns / n;
+    var ss_res: f64 = 0;
+    var ss_tot: f64 = 0;
+    for (points) |p| {
+        ss_res += (p.ns - fit.predict(p.x)) * (p.ns - fit.predict(p.x));
+        ss_tot += (p.ns - my) * (p.ns - my);
+    }
+    return if (ss_tot == 0) 1 else 1 - ss_res / ss_tot;
+}
+
+fn finishSweep(
+    allocator: std.mem.Allocator,
+    op: Op,
+    variable: []const u8,
+    points: []const Point,
+    options: Options,
+) !Sweep {
+    const affine = fitAffine(points);
+
+    const outliers = try allocator.alloc(Outlier, points.len);
+    for (points, outliers) |p, *o| {
+        const predicted = affine.predict(p.x);
+        o.* = .{ .label = p.label, .x = p.x, .ns = p.ns, .predicted_ns = predicted, .excess = p.ns / predicted };
+    }
+    std.mem.sort(Outlier, outliers, {}, struct {
+        fn greater(_: void, a: Outlier, b: Outlier) bool {
+            return a.excess > b.excess;
+        }
+    }.greater);
+
+    return .{
+        .op = op.symbol(),
+        .variable = variable,
+        .linear = fitLinear(points),
+        .affine = affine,
+        .outliers = outliers[0..@min(options.outliers, outliers.len)],
+        .points = points,
+    };
+}
+
+/// G1 points to pair with, random multiples of the corpus points.
+fn randomG1(allocator: std.mem.Allocator, rand: std.Random, base: []const u8) ![]u8 {
+    var input: [96]u8 = undefined;
+    @memcpy(input[0..64], base[0..64]);
+    std.mem.writeInt(u256, input[64..96], rand.int(u256), .big);
+    var out: [128]u8 = undefined;
+    if (ff.bn254_mul_syscall(&input, &out) != 0) return error.Unexpected;
+    return allocator.dupe(u8, out[0..64]);
+}
+
+fn sweepPairing(allocator: std.mem.Allocator, rand: std.Random, options: Options) !Sweep {
+    const corpus = try std.mem.concat(allocator, u8, &.{
+        try bench.fromHex(allocator, bench.pairing_input_a),
+        try bench.fromHex(allocator, bench.pairing_input_b),
+    });
+    const corpus_pairs = corpus.len / 192;
+
+    var points = std.ArrayList(Point).init(allocator);
+    for (1..options.max_pairs + 1) |count| {
+        for (0..options.samples) |sample| {
+            const input = try allocator.alloc(u8, count * 192);
+            for (0..count) |i| {
+                const pair = corpus[(i % corpus_pairs) * 192 ..][0..192];
+                @memcpy(input[i * 192 ..][0..64], try randomG1(allocator, rand, pair[0..64]));
+                @memcpy(input[i * 192 + 64 ..][0..128], pair[64..192]);
+            }
+            const x: f64 = @floatFromInt(count);
+            try points.append(.{
+                .label = try std.fmt.allocPrint(allocator, "{d} pairs #{d}", .{ count, sample }),
+                .x = x,
+                .ns = try measure(allocator, .pairing, input, options.reps),
+                .cu = cu.charge(.pairing, x),
+            });
+        }
+    }
+    return finishSweep(allocator, .pairing, "pairs", try points.toOwnedSlice(), options);
+}
+
+fn sweepMul(allocator: std.mem.Allocator, rand: std.Random, options: Options) !Sweep {
+    const corpus = try bench.fromHex(allocator, bench.pairing_input_a);
+
+    var points = std.ArrayList(Point).init(allocator);
+    var positions: [254]u8 = undefined;
+    for (&positions, 0..) |*p, i| p.* = @intCast(i);
+
+    var weight: usize = 0;
+    while (weight <= positions.len) : (weight += 8) {
+        for (0..options.samples) |sample| {
+            rand.shuffle(u8, &positions);
+            var scalar: u256 = 0;
+            for (positions[0..weight]) |bit| scalar |= @as(u256, 1) << bit;
+
+            var input: [96]u8 = undefined;
+            @memcpy(input[0..64], corpus[0..64]);
+            std.mem.writeInt(u256, input[64..96], scalar, .big);
+
+            const x: f64 = @floatFromInt(weight);
+            try points.append(.{
+                .label = try std.fmt.allocPrint(allocator, "weight {d} #{d}", .{ weight, sample }),
+                .x = x,
+                .ns = try measure(allocator, .mul, &input, options.reps),
+                .cu = cu.charge(.mul, x),
+            });
+        }
+    }
+    return finishSweep(allocator, .mul, "scalar hamming weight", try points.toOwnedSlice(), options);
+}
+
+/// Random x coordinates (each Fq component below the modulus), split by whether
+/// decompression finds a square root (x = 0) or rejects them (x = 1).
+fn sweepDecompress(allocator: std.mem.Allocator, rand: std.Random, op: Op, options: Options) !Sweep {
+    const len: usize = if (op == .decompress_g1) 32 else 64;
+
+    var points = std.ArrayList(Point).init(allocator);
+    var counts = [2]usize{ 0, 0 };
+    var out: [128]u8 = undefined;
+    var attempts: usize = 0;
+    while (counts[0] < 4 * options.samples or counts[1] < 4 * options.samples) : (attempts += 1) {
+        if (attempts > 1000 * options.samples) return error.Unexpected;
+
+        const input = try allocator.alloc(u8, len);
+        var i: usize = 0;
+        while (i < len) : (i += 32) {
+            std.mem.writeInt(u256, input[i..][0..32], rand.int(u256) % bench.field_modulus, .big);
+        }
+        const class: usize = if (op.call(input, &out) == 0) 0 else 1;
+        if (counts[class] == 4 * options.samples) continue;
+        counts[class] += 1;
+
+        const x: f64 = @floatFromInt(class);
+        try points.append(.{
+            .label = try std.fmt.allocPrint(allocator, "{s} #{d}", .{
+                if (class == 0) "residue" else "non-residue",
+                counts[class],
+            }),
+            .x = x,
+            .ns = try measure(allocator, op, input, options.reps),
+            .cu = cu.charge(op, x),
+        });
+    }
+    return finishSweep(allocator, op, "non-residue", try points.toOwnedSlice(), options);
+}
+
+fn worstCharged(allocator: std.mem.Allocator, sweeps: []const Sweep, count: usize) !struct { f64, []const Charged } {
+    var ratios = std.ArrayList(f64).init(allocator);
+    var charged = std.ArrayList(Charged).init(allocator);
+    for (sweeps) |sweep| {
+        for (sweep.points) |p| {
+            try ratios.append(p.ns / p.cu);
+            try charged.append(.{ .op = sweep.op, .label = p.label, .ns = p.ns, .cu = p.cu, .relative_ns_per_cu = 0 });
+        }
+    }
+    std.mem.sort(f64, ratios.items, {}, std.sort.asc(f64));
+    const median = ratios.items[ratios.items.len / 2];
+
+    for (charged.items) |*c| c.relative_ns_per_cu = c.ns / c.cu / median;
+    std.mem.sort(Charged, charged.items, {}, struct {
+        fn greater(_: void, a: Charged, b: Charged) bool {
+            return a.relative_ns_per_cu > b.relative_ns_per_cu;
+        }
+    }.greater);
+    return .{ median, charged.items[0..@min(count, charged.items.len)] };
+}
+
+fn usage() noreturn {
+    std.debug.print(
+        "usage: calibrate [--max-pairs N] [--samples N] [--reps N] [--seed N] [--json PATH]\n",
+        .{},
+    );
+    std.process.exit(1);
+}
+
+pub fn main() !void {
+    var arena_state = std.heap.ArenaAllocator.init(std.heap.page_allocator);
+    defer arena_state.deinit();
+    const arena = arena_state.allocator();
+
+    var options: Options = .{};
+    var json_path: ?[]const u8 = null;
+
+    const args = try std.process.argsAlloc(arena);
+    var i: usize = 1;
+    while (i < args.len) : (i += 2) {
+        if (i + 1 == args.len) usage();
+        const arg = args[i];
+        const value = args[i + 1];
+        if (std.mem.eql(u8, arg, "--json")) {
+            json_path = value;
+            continue;
+        }
+        const n = std.fmt.parseInt(usize, value, 10) catch usage();
+        if (std.mem.eql(u8, arg, "--max-pairs")) {
+            options.max_pairs = @max(n, 1);
+        } else if (std.mem.eql(u8, arg, "--samples")) {
+            options.samples = @max(n, 1);
+        } else if (std.mem.eql(u8, arg, "--reps")) {
+            options.reps = @max(n, 1);
+        } else if (std.mem.eql(u8, arg, "--seed")) {
+            options.seed = n;
+        } else usage();
+    }
+
+    if (builtin.mode == .Debug) {
+        std.debug.print("warning: calibrating a Debug build, pass -Doptimize=ReleaseFast\n", .{});
+    }
+
+    var prng = std.Random.DefaultPrng.init(options.seed);
+    const rand = prng.random();
+
+    const sweeps = [_]Sweep{
+        try sweepPairing(arena, rand, options),
+        try sweepMul(arena, rand, options),
+        try sweepDecompress(arena, rand, .decompress_g1, options),
+        try sweepDecompress(arena, rand, .decompress_g2, options),
+    };
+    const median_ns_per_cu, const worst = try worstCharged(arena, &sweeps, options.outliers);
+
+    const stdout = std.io.getStdOut().writer();
+    for (sweeps) |sweep| {
+        try stdout.print("{s} vs {s} ({d} inputs)\n", .{ sweep.op, sweep.variable, sweep.points.len });
+        try stdout.print("  linear: ns = {d:.1} x                 r2 = {d:.4}\n", .{ sweep.linear.slope, sweep.linear.r2 });
+        try stdout.print("  affine: ns = {d:.1} + {d:.1} x    r2 = {d:.4}\n", .{
+            sweep.affine.intercept, sweep.affine.slope, sweep.affine.r2,
+        });
+        for (sweep.outliers) |o| {
+            try stdout.print("  {s:<24} {d:>12.0} ns  {d:>6.3}x predicted\n", .{ o.label, o.ns, o.excess });
+        }
+    }
+    try stdout.print("\nmedian {d:.3} ns/CU; most expensive for their charge:\n", .{median_ns_per_cu});
+    for (worst) |c| {
+        try stdout.print("  {s:<28} {s:<24} {d:>12.0} ns {d:>8.0} CU  {d:>6.3}x median\n", .{
+            c.op, c.label, c.ns, c.cu, c.relative_ns_per_cu,
+        });
+    }
+
+    if (json_path) |path| {
+        const file = try std.fs.cwd().createFile(path, .{});
+        defer file.close();
+        var buffered = std.io.bufferedWriter(file.writer());
+        try std.json.stringify(
+            Report{
+                .seed = options.seed,
+                .median_ns_per_cu = median_ns_per_cu,
+                .sweeps = &sweeps,
+                .worst_charged = worst,
+            },
+            .{ .whitespace = .indent_2 },
+            buffered.writer(),
+        );
+        try buffered.writer().writeByte('\n');
+        try buffered.flush();
+    }
+}
@@ -137,6 +137,43 @@ test "mul" {
     }
 }
 
+test "multi_exp" {
+    // Points and scalars of the "mul" cases, the last scalar above the group order.
+    const inputs: []const []const u8 = &.{
+        "2bd3e6d0f3b142924f5ca7b49ce5b9d54c4703d7ae5648e61d02268b1a0a9fb721611ce0a6af85915e2f1d70300909ce2e49dfad4a4619c8390cae66cefdb20400000000000000000000000000000000000000000000000011138ce750fa15c2",
+        "070a8d6a982153cae4be29d434e8faef8a47b274a053f5a4ee2a6c9c13c31e5c031b8ce914eba3a9ffb989f9cdd5b0f01943074bf4f0f315690ec3cec6981afc30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd46",
+        "1a87b0584ce92f4593d161480614f2989035225609f08058ccfa3d0f940febe31a2f3c951f6dadcc7ee9007dff81504b0fcd6d7cf59996efdc33d92bf7f9f8f60000000000000000000000000000000000000000000000000000000000000009",
+        "17c139df0efee0f766bc0204762b774362e4ded88953a39ce849a8a7fa163fa901e0559bacb160664764a357af8a9fe70baa9258e0b959273ffc5718c6d4cc7cffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+    };
+
+    var points: [64 * inputs.len]u8 = undefined;
+    var scalars: [32 * inputs.len]u8 = undefined;
+    var expected: [64]u8 = .{0} ** 64;
+    for (inputs, 0..) |input, i| {
+        var buffer: [96]u8 = undefined;
+        _ = try std.fmt.hexToBytes(&buffer, input);
+        @memcpy(points[64 * i ..][0..64], buffer[0..64]);
+        @memcpy(scalars[32 * i ..][0..32], buffer[64..96]);
+
+        var sum_input: [128]u8 = undefined;
+        @memcpy(sum_input[0..64], &expected);
+        try std.testing.expectEqual(0, ff.bn254_mul_syscall(&buffer, sum_input[64..128]));
+        try std.testing.expectEqual(0, ff.bn254_add_syscall(&sum_input, &expected));
+    }
+
+    var result: [64]u8 = undefined;
+    try std.testing.expectEqual(0, ff.bn254_multi_exp(&points, &scalars, inputs.len, &result));
+    try std.testing.expectEqualSlices(u8, &expected, &result);
+
+    // No points sum to the point at infinity.
+    try std.testing.expectEqual(0, ff.bn254_multi_exp(&points, &scalars, 0, &result));
+    try std.testing.expectEqualSlices(u8, &(.{0} ** 64), &result);
+
+    // Points off the curve are rejected.
+    points[63] ^= 1;
+    try std.testing.expectEqual(-1, ff.bn254_multi_exp(&points, &scalars, inputs.len, &result));
+}
+
 test "pairing" {
     const cases: []const Case = &.{
         .{
@@ -284,3 +321,231 @@ test "edge cases" {
         );
     }
 }
+
+test "groth16 batch" {
+    // Three proofs with two public inputs each, for a verifying key built from
+    // known discrete logarithms.
+    const vk_hex =
+        "17c139df0efee0f766bc0204762b774362e4ded88953a39ce849a8a7fa163fa901e0559bacb160664764a357af8a9fe70baa9258e0b959273ffc5718c6d4cc7c" ++
+        "2903ba015a9abde26a5d081e84551e63be0fd4516e46ee6d593edeba46362455224bdc5d4327fcf8ed702e01de1c2f1657a253ba75e32a89c390142aaa28b308" ++
+        "03c8b7cda6b2dedb7aeeaf5fda464ad17036bea1c4e6f7adbaed1ebe0335e0d81d92fff52a265017eeccb372e37d7a7bd431800eca28dfd82e21e8054114233f" ++
+        "228b515a17f28b89920873207477f8c7fc05582debaf3184febf1cfdedc5ce8812bb1156a9f6b360fcb2614e15d8a3ff07f2c699dc69ca830b20d2df91fe9cd3" ++
+        "2b15dc62a5c9e36597914ddbbfde48806a8eabe45c8d3cccf9578ad08e058f9202a4fd764f52470e2fcfff325fb9692f55d6b8b077eefeaa04e07152b4d1fa94" ++
+        "009edaf0698a8c56f51139588acc094cee3c37d427bb6d2eab830aae529097d123ad66f3a7cca9dc75049635faebd124316244b91de5fb2764cd151572a905f7" ++
+        "2700e8a29b7bb45f3022a18a07bdc66d0254559e17cce64e3b4ad21578fcf4101ad4f87d3b4375a39988ac099b042b1e7c0c715678e4c2bea8905f607cf950f8" ++
+        "1c6a451060210f3baad93fe1631753751da9857edae0468e8e4bee7dd33cfb2c2331a64aa86c50d2d1e0237893ef7744a77228881ce73fcc2ad555a37d4ab405" ++
+        "15514de6a136158ef7b2bc22bed59866743bc401edd63ae857d44f4c71edc28d095e28f5ba5d73440c0e504b624afabfedb9387320817b62e9168b6868d8952e" ++
+        "1e28260f0ee971dec1e84cf81ff2776ad314d2cfb9ef81d4c970620c29b811f128fc8a72d4ff12654c3c39dab54eaef9638d28de738959779fcd3e7ac918b396",
+    const proofs_hex =
+        "12b6ea3252fd7f991b6c7759bc6b50f212d4d97fce265973af308a327675f69822f1cc798e3bfac4a4d7bdc55c3876b215da1ffd67d525c0cd570f963d21130f" ++
+        "1945a465467aa66395a82633cee789cde03da898a1c3340fba08c7d03479d50b17e4dad7c2e9d8df7a7e784fb9b61630cce44d19ba8c735d91291207cda6a9fe" ++
+        "14444e865587ccbe9a3304ea69eee644b6b34f886ac43d962ae78769a6e888162d29bcb28b679cbef2f8accb268238be9541db26fb30e3ce9cd340636143c044" ++
+        "16a8a8879e7c915f4953f05bf4e5d7fdc4922e138de857d772ca724dacc2d39a1105af3270b48e4dfd7b5e4c3d56102901e94a2187cc8626837c99c633bd19ac" ++
+        "003994af9546cdff40006d2c4f32dbb004d348f9a97dfeb88d6cf1671c2e3d932e0191fc912a1eb50c10abd503e81b1a53bfb2605c6689117d9a561bf85fed3c" ++
+        "13ebc61a4ee66a6dc822700de61036af8b733b7d6b3890444ee28d732d40685f1112c4fe669e320f985c0b263fd937c1690a9776f429349d27ad2614e8f3a33c" ++
+        "29bcd9fcf7a4b59eb9db77ee13ae728137e37cba6bd9a259ecf7fecc42e28b8b2aa4d6261d237ab9db032e40f9112e82b54193f4feca0ab36db6764581e00d83" ++
+        "10b7ddec96a14945812274e3d9f8698eaec2577b5db23c1704c0c3c19057440b0ad39235105a06ec21ae09a5f782f8a025454ab8f58f893dea5038c31e15ebd2" ++
+        "1a4d85485021a5d352f3ba6e26ef3c61c2df7124a4693e145e1a58a9cc5af340216af6b811515dcacb4cfbebcfd1bb31d66e358eedd2f28eaec97b2934c8208d" ++
+        "0b025316be7ee1c24b4bcb9f78b5b61b584662f48d1ab7a630748af571fca67a055f15de612f391928f0d8086f9efebfebfd7a3ca26a85a28b1550de6d8f6503" ++
+        "1be6d865f8611840cd4a34afbb2069bc287533deff1ab7b6f3c7b8fba641e4f72563723bb5a6143403b9f02355a1c16301ee4833cb3f2050e83a4bb877e878b9" ++
+        "07b90402f900888134239386c0f8109346b5dfa2a16171bfa8a41fae46ab4a1b04fdb0864dd6ec5d2f7e89a58cec674d0d2a857211acf0ed54f9437701b9fb52",
+    const inputs_hex =
+        "00000000000000000000000000000000000000000000000000000000000003e800000000000000000000000000000000000000000000000000000000000003e9" ++
+        "00000000000000000000000000000000000000000000000000000000000003f200000000000000000000000000000000000000000000000000000000000003f3" ++
+        "00000000000000000000000000000000000000000000000000000000000003fc00000000000000000000000000000000000000000000000000000000000003fd",
+
+    var vk: [vk_hex.len / 2]u8 = undefined;
+    _ = try std.fmt.hexToBytes(&vk, vk_hex);
+    var proofs: [proofs_hex.len / 2]u8 = undefined;
+    _ = try std.fmt.hexToBytes(&proofs, proofs_hex);
+    var inputs: [inputs_hex.len / 2]u8 = undefined;
+    _ = try std.fmt.hexToBytes(&inputs, inputs_hex);
+
+    var out: [32]u8 = undefined;
+
+    // The whole batch, each proof alone, and no proofs at all.
+    try std.testing.expectEqual(0, ff.bn254_groth16_verify_batch(&vk, vk.len, &proofs, &inputs, 3, &out));
+    try std.testing.expectEqual(1, out[31]);
+    for (0..3) |i| {
+        try std.testing.expectEqual(0, ff.bn254_groth16_verify_batch(&vk, vk.len, &proofs[256 * i], &inputs[64 * i], 1, &out));
+        try std.testing.expectEqual(1, out[31]);
+    }
+    try std.testing.expectEqual(0, ff.bn254_groth16_verify_batch(&vk, vk.len, &proofs, &inputs, 0, &out));
+    try std.testing.expectEqual(1, out[31]);
+
+    // A wrong public input.
+    {
+        var bad_inputs = inputs;
+        bad_inputs[64 + 31] ^= 1;
+        try std.testing.expectEqual(0, ff.bn254_groth16_verify_batch(&vk, vk.len, &proofs, &bad_inputs, 3, &out));
+        try std.testing.expectEqual(0, out[31]);
+    }
+
+    // Two proofs with their public inputs swapped.
+    {
+        var bad_inputs = inputs;
+        @memcpy(bad_inputs[0..64], inputs[64..128]);
+        @memcpy(bad_inputs[64..128], inputs[0..64]);
+        try std.testing.expectEqual(0, ff.bn254_groth16_verify_batch(&vk, vk.len, &proofs, &bad_inputs, 3, &out));
+        try std.testing.expectEqual(0, out[31]);
+    }
+
+    // A public input that is not below the group order.
+    {
+        var bad_inputs = inputs;
+        @memset(bad_inputs[0..32], 0xff);
+        try std.testing.expectEqual(-1, ff.bn254_groth16_verify_batch(&vk, vk.len, &proofs, &bad_inputs, 3, &out));
+    }
+
+    // A verifying key without IC_0, or of a length that is not a whole number of points.
+    try std.testing.expectEqual(-1, ff.bn254_groth16_verify_batch(&vk, 448, &proofs, &inputs, 3, &out));
+    try std.testing.expectEqual(-1, ff.bn254_groth16_verify_batch(&vk, vk.len - 1, &proofs, &inputs, 3, &out));
+}
+
+const bls12_381_g1_compressed = "97f1d3a73197d7942695638c4fa9ac0fc3688c4f9774b905a14e3a3f171bac586c55e83ff97a1aeffb3af00adb22c6bb";
+const bls12_381_g1_y = "08b3f481e3aaa0f1a09e30ed741d8ae4fcf5e095d5d00af600db18cb2c04b3edd03cc744a2888ae40caa232946c5e7e1";
+const bls12_381_g2_compressed = "93e02b6052719f607dacd3a088274f65596bd0d09920b61ab5da61bbdc7f5049334cf11213945d57e5ac7d055d042b7e024aa2b2f08f0a91260805272dc51051c6e47ad4fa403b02b4510b647ae3d1770bac0326a805bbefd48056c8c121bdb8";
+const bls12_381_r_minus_one = "73eda753299d7d483339d80809a1d80553bda402fffe5bfeffffffff00000000";
+
+fn bls12_381Generators(g1: *[96]u8, g2: *[192]u8) !void {
+    var g1_compressed: [48]u8 = undefined;
+    _ = try std.fmt.hexToBytes(&g1_compressed, bls12_381_g1_compressed);
+    try std.testing.expectEqual(0, ff.bls12_381_decompress_g1_syscall(&g1_compressed, g1));
+
+    var g2_compressed: [96]u8 = undefined;
+    _ = try std.fmt.hexToBytes(&g2_compressed, bls12_381_g2_compressed);
+    try std.testing.expectEqual(0, ff.bls12_381_decompress_g2_syscall(&g2_compressed, g2));
+}
+
+test "bls12_381 compression" {
+    var g1: [96]u8 = undefined;
+    var g2: [192]u8 = undefined;
+    try bls12_381Generators(&g1, &g2);
+
+    var expected_y: [48]u8 = undefined;
+    try std.testing.expectEqualSlices(
+        u8,
+        try std.fmt.hexToBytes(&expected_y, bls12_381_g1_y),
+        g1[48..],
+    );
+
+    var g1_compressed: [48]u8 = undefined;
+    try std.testing.expectEqual(0, ff.bls12_381_compress_g1_syscall(&g1, &g1_compressed));
+    var expected_g1: [48]u8 = undefined;
+    try std.testing.expectEqualSlices(
+        u8,
+        try std.fmt.hexToBytes(&expected_g1, bls12_381_g1_compressed),
+        &g1_compressed,
+    );
+
+    var g2_compressed: [96]u8 = undefined;
+    try std.testing.expectEqual(0, ff.bls12_381_compress_g2_syscall(&g2, &g2_compressed));
+    var expected_g2: [96]u8 = undefined;
+    try std.testing.expectEqualSlices(
+        u8,
+        try std.fmt.hexToBytes(&expected_g2, bls12_381_g2_compressed),
+        &g2_compressed,
+    );
+
+    // The point at infinity.
+    var inf_compressed: [48]u8 = .{0} ** 48;
+    inf_compressed[0] = 0xc0;
+    var inf: [96]u8 = undefined;
+    try std.testing.expectEqual(0, ff.bls12_381_decompress_g1_syscall(&inf_compressed, &inf));
+    var expected_inf: [96]u8 = .{0} ** 96;
+    expected_inf[0] = 0x40;
+    try std.testing.expectEqualSlices(u8, &expected_inf, &inf);
+}
+
+test "bls12_381 add and mul" {
+    var g1: [96]u8 = undefined;
+    var g2: [192]u8 = undefined;
+    try bls12_381Generators(&g1, &g2);
+
+    // G + G == 2 * G
+    {
+        var sum: [96]u8 = undefined;
+        try std.testing.expectEqual(0, ff.bls12_381_g1_add_syscall(&(g1 ++ g1), &sum));
+        var two: [32]u8 = .{0} ** 32;
+        two[31] = 2;
+        var product: [96]u8 = undefined;
+        try std.testing.expectEqual(0, ff.bls12_381_g1_mul_syscall(&(g1 ++ two), &product));
+        try std.testing.expectEqualSlices(u8, &sum, &product);
+    }
+    {
+        var sum: [192]u8 = undefined;
+        try std.testing.expectEqual(0, ff.bls12_381_g2_add_syscall(&(g2 ++ g2), &sum));
+        var two: [32]u8 = .{0} ** 32;
+        two[31] = 2;
+        var product: [192]u8 = undefined;
+        try std.testing.expectEqual(0, ff.bls12_381_g2_mul_syscall(&(g2 ++ two), &product));
+        try std.testing.expectEqualSlices(u8, &sum, &product);
+    }
+}
+
+test "bls12_381 pairing" {
+    var g1: [96]u8 = undefined;
+    var g2: [192]u8 = undefined;
+    try bls12_381Generators(&g1, &g2);
+
+    var r_minus_one: [32]u8 = undefined;
+    _ = try std.fmt.hexToBytes(&r_minus_one, bls12_381_r_minus_one);
+    var neg_g1: [96]u8 = undefined;
+    try std.testing.expectEqual(0, ff.bls12_381_g1_mul_syscall(&(g1 ++ r_minus_one), &neg_g1));
+
+    var inf_g1: [96]u8 = .{0} ** 96;
+    inf_g1[0] = 0x40;
+
+    const cases = .{
+        .{ g1 ++ g2 ++ neg_g1 ++ g2, 1 },
+        .{ g1 ++ g2, 0 },
+        .{ inf_g1 ++ g2, 1 },
+        .{ g1 ++ g2 ++ inf_g1 ++ g2 ++ neg_g1 ++ g2, 1 },
+    };
+    inline for (cases) |case| {
+        var out: [32]u8 = undefined;
+        try std.testing.expectEqual(0, ff.bls12_381_pairing_syscall(&case[0], case[0].len, &out));
+        var expected: [32]u8 = .{0} ** 32;
+        expected[31] = case[1];
+        try std.testing.expectEqualSlices(u8, &expected, &out);
+    }
+
+    var out: [32]u8 = undefined;
+    try std.testing.expectEqual(0, ff.bls12_381_pairing_syscall(&g1, 0, &out));
+    try std.testing.expectEqual(1, out[31]);
+}
+
+test "bls12_381 edge cases" {
+    var g1: [96]u8 = undefined;
+    var g2: [192]u8 = undefined;
+    try bls12_381Generators(&g1, &g2);
+
+    var out: [192]u8 = undefined;
+
+    // (0, 2) is on the curve but has order 3, so is not in G1.
+    {
+        var point: [96]u8 = .{0} ** 96;
+        point[95] = 2;
+        try std.testing.expectEqual(-1, ff.bls12_381_g1_add_syscall(&(point ++ g1), &out));
+
+        var compressed: [48]u8 = .{0} ** 48;
+        compressed[0] = 0x80;
+        try std.testing.expectEqual(-1, ff.bls12_381_decompress_g1_syscall(&compressed, &out));
+    }
+
+    // Not on the curve.
+    {
+        var point = g1;
+        point[95] ^= 1;
+        try std.testing.expectEqual(-1, ff.bls12_381_g1_add_syscall(&(point ++ g1), &out));
+    }
+
+    // All zeroes is not a valid encoding of the point at infinity.
+    try std.testing.expectEqual(
+        -1,
+        ff.bls12_381_g1_add_syscall(&(g1 ++ @as([96]u8, @splat(0))), &out),
+    );
+
+    // An uncompressed point handed to decompression.
+    try std.testing.expectEqual(-1, ff.bls12_381_decompress_g1_syscall(&g1, &out));
+}